@@ -0,0 +1,262 @@
+#include "batch_fit.h"
+
+void defaultBatchFitOptions(BatchFitOptions *options) {
+    options->fit_linear = 1;
+    options->fit_polynomial = 1;
+    options->fit_logistic = 1;
+    options->min_degree = 2;
+    options->max_degree = 3;
+    options->num_threads = 0;
+}
+
+// Satu workspace per thread: worker pool memakai indeksnya, thread pemanggil (atau semua
+// tugas jika tanpa pool) memakai slot terakhir
+typedef struct {
+    const Dataset *ds;
+    ThreadPool *pool;
+    FitWorkspace *workspaces;
+    int num_workers;
+} BatchFitShared;
+
+typedef struct {
+    const BatchFitShared *shared;
+    BatchFitEntry *entry;
+    double *coefficients; // Tempat koefisien polynomial di blok milik daftar hasil
+} BatchFitTask;
+
+static void batchFitTask(void *arg) {
+    BatchFitTask *task = (BatchFitTask *)arg;
+    const BatchFitShared *shared = task->shared;
+    BatchFitEntry *entry = task->entry;
+    double start = monotonicSeconds();
+
+    int worker = threadPoolWorkerIndex(shared->pool);
+    FitWorkspace *ws = &shared->workspaces[worker >= 0 ? worker : shared->num_workers];
+    fitWorkspaceReset(ws);
+
+    const double *x, *y;
+    int n = 0;
+    memset(&entry->result, 0, sizeof(entry->result));
+    entry->result.type = entry->type;
+    entry->result.r_squared = NAN;
+    if (datasetPairColumnsWorkspace(shared->ds, entry->x_column, entry->y_column, &x, &y, &n, ws) == 0 &&
+        n > entry->degree + 1) {
+        switch (entry->type) {
+        case REGRESSION_LINEAR:
+            entry->result = linearRegressionColumns(x, y, n);
+            break;
+        case REGRESSION_POLYNOMIAL:
+            entry->result = polynomialRegressionWorkspace(x, y, 1, n, entry->degree, ws);
+            if (entry->result.coefficients) {
+                memcpy(task->coefficients, entry->result.coefficients, (entry->degree + 1) * sizeof(double));
+            }
+            entry->result.coefficients = entry->result.coefficients ? task->coefficients : NULL;
+            break;
+        case REGRESSION_LOGISTIC:
+            entry->result = logisticRegressionWorkspace(x, y, 1, n, NULL, NULL, ws);
+            break;
+        }
+    }
+    entry->num_points = n;
+    entry->seconds = monotonicSeconds() - start;
+}
+
+// Fit linear, polynomial (rentang derajat) dan logistic untuk setiap pasangan kolom
+// numerik (x != y). Semua fit dijadwalkan di thread pool dengan work stealing; fit
+// logistic yang paling mahal dikirim lebih dulu. Koefisien polynomial disimpan dalam blok yang
+// sama dengan daftar hasil dan buffer sementara memakai workspace per thread, sehingga
+// jumlah malloc tidak bergantung pada jumlah fit. Return 0 jika berhasil.
+int runBatchFit(const Dataset *ds, const BatchFitOptions *options, BatchFitEntry **entries, int *num_entries) {
+    int min_degree = options->min_degree < 1 ? 1 : options->min_degree;
+    int max_degree = options->max_degree > MAX_POLY_DEGREE ? MAX_POLY_DEGREE : options->max_degree;
+    int degrees = options->fit_polynomial && max_degree >= min_degree ? max_degree - min_degree + 1 : 0;
+    int models_per_pair = (options->fit_linear ? 1 : 0) + degrees + (options->fit_logistic ? 1 : 0);
+
+    int numeric = 0;
+    for (int c = 0; c < ds->num_columns; c++) {
+        numeric += datasetIsNumericColumn(ds, c);
+    }
+    int total = numeric * (numeric - 1) * models_per_pair;
+    *entries = NULL;
+    *num_entries = 0;
+    if (total <= 0) {
+        return 0;
+    }
+
+    // Daftar hasil diikuti slot koefisien untuk setiap entri polynomial (dibebaskan bersama)
+    size_t list_size = (size_t)total * sizeof(BatchFitEntry);
+    BatchFitEntry *list = (BatchFitEntry *)calloc(1, list_size + (size_t)numeric * (numeric - 1) * degrees *
+                                                                     (MAX_POLY_DEGREE + 1) * sizeof(double));
+    BatchFitTask *tasks = (BatchFitTask *)malloc(total * sizeof(BatchFitTask));
+    if (!list || !tasks) {
+        free(list);
+        free(tasks);
+        return -1;
+    }
+    double *coefficient_slots = (double *)((char *)list + list_size);
+
+    // Urutan hasil: per pasangan, lalu per model
+    int count = 0;
+    for (int xc = 0; xc < ds->num_columns; xc++) {
+        for (int yc = 0; yc < ds->num_columns; yc++) {
+            if (xc == yc || !datasetIsNumericColumn(ds, xc) || !datasetIsNumericColumn(ds, yc)) {
+                continue;
+            }
+            if (options->fit_linear) {
+                list[count++] = (BatchFitEntry){xc, yc, REGRESSION_LINEAR, 1, 0, 0, {0}};
+            }
+            for (int d = 0; d < degrees; d++) {
+                list[count++] = (BatchFitEntry){xc, yc, REGRESSION_POLYNOMIAL, min_degree + d, 0, 0, {0}};
+            }
+            if (options->fit_logistic) {
+                list[count++] = (BatchFitEntry){xc, yc, REGRESSION_LOGISTIC, 0, 0, 0, {0}};
+            }
+        }
+    }
+
+    int num_threads = options->num_threads > 0 ? options->num_threads : defaultThreadCount();
+    ThreadPool *pool = num_threads > 1 ? threadPoolCreate(num_threads) : NULL;
+    BatchFitShared shared = {ds, pool, NULL, pool ? pool->num_threads : 0};
+    shared.workspaces = (FitWorkspace *)malloc((shared.num_workers + 1) * sizeof(FitWorkspace));
+    if (!shared.workspaces) {
+        threadPoolDestroy(pool);
+        free(list);
+        free(tasks);
+        return -1;
+    }
+    for (int i = 0; i <= shared.num_workers; i++) {
+        fitWorkspaceInit(&shared.workspaces[i], 0);
+    }
+
+    // Kirim tugas termahal lebih dulu: logistic, polynomial derajat tinggi, lalu linear
+    int submitted = 0, polynomial = 0;
+    for (int pass = 0; pass < 3; pass++) {
+        for (int i = 0; i < count; i++) {
+            RegressionType type = list[i].type;
+            int match = (pass == 0 && type == REGRESSION_LOGISTIC) ||
+                        (pass == 1 && type == REGRESSION_POLYNOMIAL) ||
+                        (pass == 2 && type == REGRESSION_LINEAR);
+            if (match) {
+                tasks[submitted].shared = &shared;
+                tasks[submitted].entry = &list[i];
+                tasks[submitted].coefficients =
+                    type == REGRESSION_POLYNOMIAL ? coefficient_slots + (size_t)polynomial++ * (MAX_POLY_DEGREE + 1)
+                                                  : NULL;
+                threadPoolSubmit(pool, batchFitTask, &tasks[submitted]);
+                submitted++;
+            }
+        }
+    }
+    threadPoolWait(pool);
+    threadPoolDestroy(pool);
+    for (int i = 0; i <= shared.num_workers; i++) {
+        fitWorkspaceFree(&shared.workspaces[i]);
+    }
+    free(shared.workspaces);
+    free(tasks);
+
+    *entries = list;
+    *num_entries = count;
+    return 0;
+}
+
+const char *regressionTypeName(RegressionType type) {
+    switch (type) {
+    case REGRESSION_LINEAR:
+        return "linear";
+    case REGRESSION_POLYNOMIAL:
+        return "polynomial";
+    case REGRESSION_LOGISTIC:
+        return "logistic";
+    }
+    return "unknown";
+}
+
+void writeQuotedName(FILE *out, const char *name, char escape) {
+    fputc('"', out);
+    for (const char *p = name; *p; p++) {
+        if (*p == '"' || (escape == '\\' && *p == '\\')) {
+            fputc(escape, out);
+        }
+        fputc(*p, out);
+    }
+    fputc('"', out);
+}
+
+// Tabel CSV: satu baris per pasangan dan model, koefisien polynomial dipisah ';'
+void writeBatchFitCSV(FILE *out, const Dataset *ds, const BatchFitEntry *entries, int num_entries) {
+    fprintf(out, "x,y,model,degree,n,r_squared,slope,intercept,a,b,c,mean_x,coefficients,seconds\n");
+    for (int i = 0; i < num_entries; i++) {
+        const BatchFitEntry *e = &entries[i];
+        const RegressionResult *r = &e->result;
+        writeQuotedName(out, ds->columns[e->x_column].name, '"');
+        fputc(',', out);
+        writeQuotedName(out, ds->columns[e->y_column].name, '"');
+        fprintf(out, ",%s,%d,%d,%.10g,", regressionTypeName(e->type), e->degree, e->num_points, r->r_squared);
+        if (e->type == REGRESSION_LINEAR) {
+            fprintf(out, "%.10g,%.10g,,,,,,", r->slope, r->intercept);
+        } else if (e->type == REGRESSION_LOGISTIC) {
+            fprintf(out, ",,%.10g,%.10g,%.10g,%.10g,,", r->a, r->b, r->c, r->mean_x);
+        } else {
+            fprintf(out, ",,,,,,");
+            for (int k = 0; r->coefficients && k <= e->degree; k++) {
+                fprintf(out, k ? ";%.10g" : "%.10g", r->coefficients[k]);
+            }
+            fputc(',', out);
+        }
+        fprintf(out, "%.6f\n", e->seconds);
+    }
+}
+
+static void writeJSONNumber(FILE *out, double value) {
+    if (isfinite(value)) {
+        fprintf(out, "%.10g", value);
+    } else {
+        fprintf(out, "null");
+    }
+}
+
+// Array JSON dengan satu objek per pasangan dan model
+void writeBatchFitJSON(FILE *out, const Dataset *ds, const BatchFitEntry *entries, int num_entries) {
+    fprintf(out, "[\n");
+    for (int i = 0; i < num_entries; i++) {
+        const BatchFitEntry *e = &entries[i];
+        const RegressionResult *r = &e->result;
+        fprintf(out, "  {\"x\": ");
+        writeQuotedName(out, ds->columns[e->x_column].name, '\\');
+        fprintf(out, ", \"y\": ");
+        writeQuotedName(out, ds->columns[e->y_column].name, '\\');
+        fprintf(out, ", \"model\": \"%s\", \"degree\": %d, \"n\": %d, \"r_squared\": ",
+                regressionTypeName(e->type), e->degree, e->num_points);
+        writeJSONNumber(out, r->r_squared);
+        fprintf(out, ", \"coefficients\": [");
+        if (e->type == REGRESSION_LINEAR) {
+            writeJSONNumber(out, r->intercept);
+            fprintf(out, ", ");
+            writeJSONNumber(out, r->slope);
+        } else if (e->type == REGRESSION_LOGISTIC) {
+            writeJSONNumber(out, r->a);
+            fprintf(out, ", ");
+            writeJSONNumber(out, r->b);
+            fprintf(out, ", ");
+            writeJSONNumber(out, r->c);
+            fprintf(out, ", ");
+            writeJSONNumber(out, r->mean_x);
+        } else {
+            for (int k = 0; r->coefficients && k <= e->degree; k++) {
+                if (k) {
+                    fprintf(out, ", ");
+                }
+                writeJSONNumber(out, r->coefficients[k]);
+            }
+        }
+        fprintf(out, "], \"seconds\": %.6f}%s\n", e->seconds, i + 1 < num_entries ? "," : "");
+    }
+    fprintf(out, "]\n");
+}
+
+// Koefisien polynomial ada di blok yang sama dengan daftar hasil, jadi cukup satu free
+void freeBatchFit(BatchFitEntry *entries, int num_entries) {
+    (void)num_entries;
+    free(entries);
+}
@@ -0,0 +1,37 @@
+#ifndef BATCH_FIT_H
+#define BATCH_FIT_H
+
+#include "dataset.h"
+#include "thread_pool.h"
+
+// Opsi untuk mode batch "fit semua pasangan kolom"
+typedef struct {
+    int fit_linear;
+    int fit_polynomial;
+    int fit_logistic;
+    int min_degree;  // Rentang derajat polynomial
+    int max_degree;
+    int num_threads; // <= 0 berarti semua core
+} BatchFitOptions;
+
+// Satu baris hasil: satu model untuk satu pasangan (x, y)
+typedef struct {
+    int x_column;
+    int y_column;
+    RegressionType type;
+    int degree;
+    int num_points;
+    double seconds;
+    RegressionResult result;
+} BatchFitEntry;
+
+// Deklarasi fungsi
+void defaultBatchFitOptions(BatchFitOptions *options);
+int runBatchFit(const Dataset *ds, const BatchFitOptions *options, BatchFitEntry **entries, int *num_entries);
+void writeBatchFitCSV(FILE *out, const Dataset *ds, const BatchFitEntry *entries, int num_entries);
+void writeBatchFitJSON(FILE *out, const Dataset *ds, const BatchFitEntry *entries, int num_entries);
+void freeBatchFit(BatchFitEntry *entries, int num_entries);
+const char *regressionTypeName(RegressionType type);
+void writeQuotedName(FILE *out, const char *name, char escape);
+
+#endif
@@ -0,0 +1,395 @@
+#include "dataset.h"
+#include "interp.h"
+#include "plot.h"
+#include "synthetic.h"
+
+#include <sys/resource.h>
+#include <time.h>
+#include <unistd.h>
+
+// Benchmark suite end-to-end: untuk setiap bentuk data sintetis (linear, polynomial, logistic),
+// urutan x (naik atau acak) dan jumlah baris, file CSV dibuat lalu setiap tahap diukur terpisah:
+// parse, fit, R², prediksi, interpolasi dan persiapan plot. Hasil berupa median/p99 latensi,
+// throughput dan puncak RSS per kasus, sebagai tabel dan (opsional) JSON.
+// Build: make bench_suite, atau make bench untuk menulis bench.json.
+
+#define SUITE_DEFAULT_ROWS "1000,100000,1000000"
+#define SUITE_MAX_SIZES 16
+#define SUITE_MAX_REPEATS 101
+#define SUITE_MAX_STAGES 8
+#define SUITE_REPEAT_BUDGET 1e7 // Baris total per tahap; jumlah repetisi = budget / baris
+
+typedef struct {
+    const char *stage;
+    int repeats;
+    double median;   // Detik
+    double p99;
+    double min;
+    double rows;     // Baris yang diproses per repetisi
+    double bytes;    // Byte input per repetisi (0 jika tidak relevan)
+} StageResult;
+
+typedef struct {
+    SyntheticShape shape;
+    int sorted;
+    size_t rows;
+    size_t csv_bytes;
+    long peak_rss_kb;
+    int num_stages;
+    StageResult stages[SUITE_MAX_STAGES];
+} CaseResult;
+
+static int compareDouble(const void *a, const void *b) {
+    double da = *(const double *)a, db = *(const double *)b;
+    return (da > db) - (da < db);
+}
+
+// Ringkas sampel waktu: median dan p99 nearest-rank
+static void summarizeSamples(StageResult *stage, double *samples, int count) {
+    qsort(samples, count, sizeof(double), compareDouble);
+    stage->repeats = count;
+    stage->min = samples[0];
+    stage->median = count % 2 ? samples[count / 2] : 0.5 * (samples[count / 2 - 1] + samples[count / 2]);
+    int rank = (int)ceil(0.99 * count);
+    stage->p99 = samples[(rank > 0 ? rank : 1) - 1];
+}
+
+// Jalankan setup; stmt beberapa kali, hanya stmt yang diukur
+#define SUITE_TIME(result, name, count, n, input_bytes, setup, stmt) \
+    do {                                                             \
+        double samples_[SUITE_MAX_REPEATS];                          \
+        for (int rep_ = 0; rep_ < (count); rep_++) {                 \
+            setup;                                                   \
+            double start_ = monotonicSeconds();                      \
+            stmt;                                                    \
+            samples_[rep_] = monotonicSeconds() - start_;            \
+        }                                                            \
+        StageResult *stage_ = &(result)->stages[(result)->num_stages++]; \
+        stage_->stage = (name);                                      \
+        stage_->rows = (double)(n);                                  \
+        stage_->bytes = (double)(input_bytes);                       \
+        summarizeSamples(stage_, samples_, (count));                 \
+    } while (0)
+
+// Kosongkan penanda puncak RSS (Linux >= 4.0); gagal diam-diam di sistem lain
+static void resetPeakRSS(void) {
+    FILE *f = fopen("/proc/self/clear_refs", "w");
+    if (f) {
+        fputs("5", f);
+        fclose(f);
+    }
+}
+
+// Puncak RSS dalam KB: VmHWM jika ada, jika tidak ru_maxrss (puncak sejak proses mulai)
+static long peakRSSKB(void) {
+    FILE *f = fopen("/proc/self/status", "r");
+    if (f) {
+        char line[256];
+        long kb = -1;
+        while (fgets(line, sizeof(line), f)) {
+            if (strncmp(line, "VmHWM:", 6) == 0) {
+                kb = strtol(line + 6, NULL, 10);
+                break;
+            }
+        }
+        fclose(f);
+        if (kb >= 0) {
+            return kb;
+        }
+    }
+    struct rusage usage;
+    return getrusage(RUSAGE_SELF, &usage) == 0 ? usage.ru_maxrss : -1;
+}
+
+// R² model terhadap data, dievaluasi per blok lewat model terkompilasi
+static double modelRSquared(const CompiledModel *model, const double *x, const double *y, size_t n) {
+    double buffer[PREDICT_BLOCK];
+    double sum_y = 0, ss_res = 0;
+    for (size_t i = 0; i < n; i += PREDICT_BLOCK) {
+        size_t count = n - i < PREDICT_BLOCK ? n - i : PREDICT_BLOCK;
+        compiledModelEvalBatch(model, x + i, buffer, count);
+        for (size_t j = 0; j < count; j++) {
+            double r = y[i + j] - buffer[j];
+            ss_res += r * r;
+            sum_y += y[i + j];
+        }
+    }
+    double mean_y = sum_y / (double)n, ss_tot = 0;
+    for (size_t i = 0; i < n; i++) {
+        ss_tot += (y[i] - mean_y) * (y[i] - mean_y);
+    }
+    return ss_tot > 0 ? 1.0 - ss_res / ss_tot : 0.0;
+}
+
+// Persiapan plot: layout + sampel kurva, lalu ringkasan scatter per piksel (tanpa rasterisasi)
+static double plotPrep(const PlotOptions *options, const double *x, const double *y, size_t n,
+                       const CompiledModel *model, ThreadPool *pool, double *curve) {
+    PlotLayout layout;
+    size_t samples = 0, count = 0;
+    double *points = NULL;
+    if (plotComputeLayout(&layout, options, x, y, 1, n, model, curve, curve + PLOT_MAX_CURVE_SAMPLES, &samples) != 0 ||
+        plotDownsample(&layout, 1, x, y, 1, n, pool, &points, &count) != 0) {
+        return 0;
+    }
+    free(points);
+    return (double)(samples + count);
+}
+
+static int suiteRepeats(size_t rows, int override) {
+    if (override > 0) {
+        return override < SUITE_MAX_REPEATS ? override : SUITE_MAX_REPEATS;
+    }
+    double repeats = SUITE_REPEAT_BUDGET / (double)rows;
+    return repeats < 3 ? 3 : (repeats > SUITE_MAX_REPEATS ? SUITE_MAX_REPEATS : (int)repeats);
+}
+
+// Satu kasus: tulis CSV, lalu ukur setiap tahap atas data yang sama
+static CFStatus runCase(CaseResult *result, const char *path, ThreadPool *pool, int num_threads,
+                        int repeat_override) {
+    SyntheticSpec spec;
+    defaultSyntheticSpec(&spec, result->shape, result->sorted);
+    int degree;
+    RegressionType type = syntheticRegressionType(result->shape, &degree);
+    size_t n = result->rows;
+    int repeats = suiteRepeats(n, repeat_override);
+    volatile double sink = 0;
+
+    resetPeakRSS();
+    CFStatus status = CF_OK;
+    SUITE_TIME(result, "generate", 1, n, 0, (void)0,
+               status = syntheticWriteCSV(path, &spec, n, pool, &result->csv_bytes));
+    result->stages[0].bytes = (double)result->csv_bytes;
+    if (status != CF_OK) {
+        return status;
+    }
+
+    Dataset ds = {0};
+    SUITE_TIME(result, "parse", repeats, n, result->csv_bytes, freeDataset(&ds),
+               status = loadDataset(path, &ds, num_threads, NULL));
+    if (status != CF_OK) {
+        return status;
+    }
+    const double *x = ds.values[0];
+    const double *y = ds.values[1];
+
+    // Koefisien hasil fit milik workspace, valid sampai reset berikutnya
+    FitWorkspace ws;
+    fitWorkspaceInit(&ws, 0);
+    RegressionResult fit;
+    SUITE_TIME(result, "fit", repeats, n, 0, fitWorkspaceReset(&ws),
+               fit = datasetRegressionWorkspace(&ds, 0, 1, type, degree, &ws));
+
+    CompiledModel model;
+    double *out = (double *)malloc(n * sizeof(double));
+    double *cx = (double *)malloc(2 * PLOT_MAX_CURVE_SAMPLES * sizeof(double));
+    if (!out || !cx || compileModel(&fit, &model) != 0) {
+        free(out);
+        free(cx);
+        fitWorkspaceFree(&ws);
+        freeDataset(&ds);
+        return out && cx ? CF_ERROR_ARGUMENT : CF_ERROR_MEMORY;
+    }
+
+    SUITE_TIME(result, "r_squared", repeats, n, 0, (void)0, sink += modelRSquared(&model, x, y, n));
+    SUITE_TIME(result, "predict", repeats, n, 0, (void)0, compiledModelEvalBatch(&model, x, out, n); sink += out[0]);
+
+    InterpIndex index = {0};
+    SUITE_TIME(result, "interp_build", repeats, n, 0, interpIndexFree(&index),
+               status = interpIndexBuild(&index, x, y, 1, n, EXTRAPOLATE_CLAMP) == 0 ? CF_OK : CF_ERROR_MEMORY);
+    if (status == CF_OK) {
+        SUITE_TIME(result, "interp_query", repeats, n, 0, (void)0,
+                   interpIndexLinearBatch(&index, x, out, n); sink += out[n - 1]);
+    }
+    interpIndexFree(&index);
+
+    PlotOptions options;
+    defaultPlotOptions(&options);
+    SUITE_TIME(result, "plot_prep", repeats, n, 0, (void)0, sink += plotPrep(&options, x, y, n, &model, pool, cx));
+
+    result->peak_rss_kb = peakRSSKB();
+    free(out);
+    free(cx);
+    fitWorkspaceFree(&ws);
+    freeDataset(&ds);
+    (void)sink;
+    return status;
+}
+
+static void printCaseTable(FILE *out, const CaseResult *result) {
+    fprintf(out, "\n%s, x %s, %zu baris (%.1f MB CSV, puncak RSS %.1f MB)\n", syntheticShapeName(result->shape),
+            result->sorted ? "naik" : "acak", result->rows, result->csv_bytes / 1e6, result->peak_rss_kb / 1024.0);
+    fprintf(out, "  %-13s %6s %12s %12s %14s %10s\n", "tahap", "rep", "median ms", "p99 ms", "baris/s", "MB/s");
+    for (int i = 0; i < result->num_stages; i++) {
+        const StageResult *s = &result->stages[i];
+        fprintf(out, "  %-13s %6d %12.3f %12.3f %14.0f", s->stage, s->repeats, s->median * 1e3, s->p99 * 1e3,
+                s->rows / s->median);
+        if (s->bytes > 0) {
+            fprintf(out, " %10.1f", s->bytes / s->median / 1e6);
+        }
+        fprintf(out, "\n");
+    }
+}
+
+static void writeSuiteJSON(FILE *out, const CaseResult *results, int num_results, int num_threads) {
+    fprintf(out, "{\n  \"suite\": \"curve_fitting\",\n  \"version\": 1,\n  \"timestamp\": %lld,\n",
+            (long long)time(NULL));
+    fprintf(out, "  \"threads\": %d,\n  \"moments_kernel\": \"%s\",\n  \"cases\": [", num_threads,
+            momentsKernelName(MOMENTS_KERNEL_AUTO));
+    for (int c = 0; c < num_results; c++) {
+        const CaseResult *r = &results[c];
+        fprintf(out, "%s\n    {\"dataset\": \"%s\", \"x_order\": \"%s\", \"rows\": %zu, \"csv_bytes\": %zu, "
+                "\"peak_rss_kb\": %ld,\n     \"stages\": [", c ? "," : "", syntheticShapeName(r->shape),
+                r->sorted ? "sorted" : "unsorted", r->rows, r->csv_bytes, r->peak_rss_kb);
+        for (int i = 0; i < r->num_stages; i++) {
+            const StageResult *s = &r->stages[i];
+            fprintf(out, "%s\n       {\"stage\": \"%s\", \"repeats\": %d, \"median_ms\": %.6f, \"p99_ms\": %.6f, "
+                    "\"min_ms\": %.6f, \"rows_per_sec\": %.1f", i ? "," : "", s->stage, s->repeats,
+                    s->median * 1e3, s->p99 * 1e3, s->min * 1e3, s->rows / s->median);
+            if (s->bytes > 0) {
+                fprintf(out, ", \"mb_per_sec\": %.3f", s->bytes / s->median / 1e6);
+            }
+            fprintf(out, "}");
+        }
+        fprintf(out, "\n     ]}");
+    }
+    fprintf(out, "\n  ]\n}\n");
+}
+
+// Daftar jumlah baris dipisah koma; menerima 1e9 atau sufiks K/M/B
+static int parseRowList(const char *text, size_t *rows, int max_rows) {
+    int count = 0;
+    const char *p = text;
+    while (*p && count < max_rows) {
+        char *end;
+        double value = strtod(p, &end);
+        if (end == p) {
+            return -1;
+        }
+        if (*end == 'K' || *end == 'k') {
+            value *= 1e3;
+            end++;
+        } else if (*end == 'M' || *end == 'm') {
+            value *= 1e6;
+            end++;
+        } else if (*end == 'B' || *end == 'b' || *end == 'G' || *end == 'g') {
+            value *= 1e9;
+            end++;
+        }
+        if (value < 2 || (*end && *end != ',')) {
+            return -1;
+        }
+        rows[count++] = (size_t)value;
+        p = *end ? end + 1 : end;
+    }
+    return *p ? -1 : count;
+}
+
+int main(int argc, char *argv[]) {
+    const char *rows_arg = SUITE_DEFAULT_ROWS;
+    const char *json_path = NULL;
+    const char *directory = getenv("TMPDIR");
+    int num_threads = 0;
+    int repeat_override = 0;
+    int keep = 0;
+    int shapes = 7; // Bit per SyntheticShape
+    int orders = 3; // Bit 0: naik, bit 1: acak
+    int usage_error = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--rows") == 0 && i + 1 < argc) {
+            rows_arg = argv[++i];
+        } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (strcmp(argv[i], "--dir") == 0 && i + 1 < argc) {
+            directory = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            num_threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--repeats") == 0 && i + 1 < argc) {
+            repeat_override = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--dataset") == 0 && i + 1 < argc) {
+            const char *name = argv[++i];
+            shapes = strcmp(name, "linear") == 0 ? 1 : strcmp(name, "poly") == 0 ? 2
+                   : strcmp(name, "logistic") == 0 ? 4 : strcmp(name, "all") == 0 ? 7 : 0;
+            usage_error |= shapes == 0;
+        } else if (strcmp(argv[i], "--order") == 0 && i + 1 < argc) {
+            const char *name = argv[++i];
+            orders = strcmp(name, "sorted") == 0 ? 1 : strcmp(name, "unsorted") == 0 ? 2
+                   : strcmp(name, "all") == 0 ? 3 : 0;
+            usage_error |= orders == 0;
+        } else if (strcmp(argv[i], "--keep") == 0) {
+            keep = 1;
+        } else {
+            usage_error = 1;
+        }
+    }
+    size_t sizes[SUITE_MAX_SIZES];
+    int num_sizes = parseRowList(rows_arg, sizes, SUITE_MAX_SIZES);
+    if (usage_error || num_sizes <= 0) {
+        printf("Penggunaan: %s [--rows 1000,1e6,1B] [--dataset linear|poly|logistic|all]\n"
+               "           %*s [--order sorted|unsorted|all] [--threads N] [--repeats N]\n"
+               "           %*s [--dir DIR] [--keep] [--json FILE|-]\n",
+               argv[0], (int)strlen(argv[0]), "", (int)strlen(argv[0]), "");
+        return 1;
+    }
+    // --threads mengatur parse, pembuatan CSV dan ringkasan plot; solver memakai pool bersama
+    ThreadPool *pool = num_threads > 0 ? threadPoolCreate(num_threads) : threadPoolShared();
+    int threads = pool ? pool->num_threads : 1;
+    if (!directory || !*directory) {
+        directory = "/tmp";
+    }
+    // Tabel ke stderr jika JSON ditulis ke stdout
+    FILE *table = json_path && strcmp(json_path, "-") == 0 ? stderr : stdout;
+    fprintf(table, "Benchmark suite: %d thread, kernel momen %s\n", threads, momentsKernelName(MOMENTS_KERNEL_AUTO));
+
+    CaseResult *results = (CaseResult *)calloc((size_t)num_sizes * 6, sizeof(CaseResult));
+    if (!results) {
+        return 1;
+    }
+    int num_results = 0;
+    int failed = 0;
+    for (int s = 0; s < num_sizes && !failed; s++) {
+        for (int shape = SYNTHETIC_LINEAR; shape <= SYNTHETIC_LOGISTIC && !failed; shape++) {
+            for (int sorted = 1; sorted >= 0 && !failed; sorted--) {
+                if (!(shapes & (1 << shape)) || !(orders & (sorted ? 1 : 2))) {
+                    continue;
+                }
+                CaseResult *result = &results[num_results];
+                result->shape = (SyntheticShape)shape;
+                result->sorted = sorted;
+                result->rows = sizes[s];
+                char path[1024];
+                snprintf(path, sizeof(path), "%s/cf_bench_%s_%s_%zu.csv", directory,
+                         syntheticShapeName(result->shape), sorted ? "sorted" : "unsorted", sizes[s]);
+                CFStatus status = runCase(result, path, pool, num_threads, repeat_override);
+                if (!keep) {
+                    unlink(path);
+                }
+                if (status != CF_OK) {
+                    fprintf(stderr, "Error: %s: %s\n", path, cfStatusMessage(status));
+                    failed = 1;
+                    break;
+                }
+                printCaseTable(table, result);
+                num_results++;
+            }
+        }
+    }
+
+    if (json_path) {
+        FILE *out = strcmp(json_path, "-") == 0 ? stdout : fopen(json_path, "w");
+        if (!out) {
+            fprintf(stderr, "Error: tidak dapat menulis %s\n", json_path);
+            failed = 1;
+        } else {
+            writeSuiteJSON(out, results, num_results, threads);
+            if (out != stdout) {
+                fclose(out);
+                fprintf(table, "\nHasil JSON ditulis ke %s\n", json_path);
+            }
+        }
+    }
+    free(results);
+    if (num_threads > 0) {
+        threadPoolDestroy(pool);
+    }
+    return failed;
+}
@@ -0,0 +1,660 @@
+#include "curve_fitting.h"
+#include "least_squares.h"
+#include "model_select.h"
+#include "rolling.h"
+
+#include <stdint.h>
+#include <unistd.h>
+
+// Micro-benchmark untuk jalur-jalur fitting.
+// Build: make benchmark
+
+static uint64_t bench_rng_state = 0x9E3779B97F4A7C15ULL;
+
+// splitmix64: deterministik, cukup acak untuk data sintetis
+static uint64_t benchRandom(void) {
+    uint64_t z = (bench_rng_state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static double benchUniform(void) {
+    return (double)(benchRandom() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Implementasi linearRegression sebelum kernel momen (dua lintasan, pow), sebagai pembanding
+static RegressionResult referenceLinearRegression(DataPoint *data, int num_points) {
+    RegressionResult result;
+    result.type = REGRESSION_LINEAR;
+    result.coefficients = NULL;
+    double sum_x = 0, sum_y = 0, sum_xy = 0, sum_x2 = 0;
+    for (int i = 0; i < num_points; i++) {
+        sum_x += data[i].x;
+        sum_y += data[i].y;
+        sum_xy += data[i].x * data[i].y;
+        sum_x2 += data[i].x * data[i].x;
+    }
+    double mean_x = sum_x / num_points;
+    double mean_y = sum_y / num_points;
+    result.slope = (num_points * sum_xy - sum_x * sum_y) / (num_points * sum_x2 - sum_x * sum_x);
+    result.intercept = mean_y - result.slope * mean_x;
+    double ss_tot = 0, ss_res = 0;
+    for (int i = 0; i < num_points; i++) {
+        double y_pred = result.slope * data[i].x + result.intercept;
+        ss_tot += pow(data[i].y - mean_y, 2);
+        ss_res += pow(data[i].y - y_pred, 2);
+    }
+    result.r_squared = 1 - (ss_res / ss_tot);
+    return result;
+}
+
+// Implementasi polynomialRegression sebelum poly_fit.h (pow di loop rangkap tiga,
+// Gauss-Jordan tanpa pivot pada double**), sebagai pembanding
+static RegressionResult referencePolynomialRegression(DataPoint *data, int num_points, int degree) {
+    RegressionResult result;
+    result.type = REGRESSION_POLYNOMIAL;
+    result.degree = degree;
+    result.coefficients = (double *)malloc((degree + 1) * sizeof(double));
+    double **matrix = (double **)malloc((degree + 1) * sizeof(double *));
+    for (int i = 0; i <= degree; i++) {
+        matrix[i] = (double *)calloc(degree + 2, sizeof(double));
+    }
+    for (int i = 0; i <= degree; i++) {
+        for (int j = 0; j <= degree; j++) {
+            for (int k = 0; k < num_points; k++) {
+                matrix[i][j] += pow(data[k].x, i + j);
+            }
+        }
+        for (int k = 0; k < num_points; k++) {
+            matrix[i][degree + 1] += data[k].y * pow(data[k].x, i);
+        }
+    }
+    for (int i = 0; i <= degree; i++) {
+        double pivot = matrix[i][i];
+        for (int j = i; j <= degree + 1; j++) {
+            matrix[i][j] /= pivot;
+        }
+        for (int k = 0; k <= degree; k++) {
+            if (k != i) {
+                double factor = matrix[k][i];
+                for (int j = i; j <= degree + 1; j++) {
+                    matrix[k][j] -= factor * matrix[i][j];
+                }
+            }
+        }
+    }
+    for (int i = 0; i <= degree; i++) {
+        result.coefficients[i] = matrix[i][degree + 1];
+        free(matrix[i]);
+    }
+    free(matrix);
+    double mean_y = 0;
+    for (int i = 0; i < num_points; i++) {
+        mean_y += data[i].y;
+    }
+    mean_y /= num_points;
+    double ss_tot = 0, ss_res = 0;
+    for (int i = 0; i < num_points; i++) {
+        double y_pred = 0;
+        for (int j = 0; j <= degree; j++) {
+            y_pred += result.coefficients[j] * pow(data[i].x, j);
+        }
+        ss_tot += pow(data[i].y - mean_y, 2);
+        ss_res += pow(data[i].y - y_pred, 2);
+    }
+    result.r_squared = 1 - (ss_res / ss_tot);
+    return result;
+}
+
+// Implementasi logisticRegression sebelum Levenberg-Marquardt (gradient descent langkah
+// tetap, 1000 iterasi), sebagai pembanding. Mengembalikan R-squared.
+static double referenceLogisticRegression(const DataPoint *data, size_t n, int *iterations) {
+    double max_y = 0, mean_x = 0, var_x = 0;
+    for (size_t i = 0; i < n; i++) {
+        max_y = data[i].y > max_y ? data[i].y : max_y;
+        mean_x += data[i].x;
+    }
+    mean_x /= n;
+    for (size_t i = 0; i < n; i++) {
+        var_x += (data[i].x - mean_x) * (data[i].x - mean_x);
+    }
+    double std_x = sqrt(var_x / n);
+    double a = 1.0, b = 0.1, c = max_y * 1.1, prev_cost = DBL_MAX;
+    int iter;
+    for (iter = 0; iter < 1000; iter++) {
+        double grad_a = 0, grad_b = 0, grad_c = 0, cost = 0;
+        for (size_t i = 0; i < n; i++) {
+            double x = (data[i].x - mean_x) / std_x;
+            double error = c / (1 + a * exp(-b * x)) - data[i].y;
+            double exp_term = exp(-b * x);
+            double denominator = 1 + a * exp_term;
+            double denominator_squared = denominator * denominator;
+            grad_a += error * (c * exp_term / denominator_squared);
+            grad_b += error * (c * a * x * exp_term / denominator_squared);
+            grad_c += error / denominator;
+            cost += error * error;
+        }
+        cost /= n;
+        a -= 0.01 * grad_a / n;
+        b -= 0.01 * grad_b / n;
+        c -= 0.01 * grad_c / n;
+        a = a <= 0 ? 0.01 : a;
+        c = c <= 0 ? 0.01 : c;
+        if (fabs(prev_cost - cost) < 1e-6) {
+            break;
+        }
+        prev_cost = cost;
+    }
+    *iterations = iter;
+
+    double mean_y = 0, ss_tot = 0, ss_res = 0;
+    for (size_t i = 0; i < n; i++) {
+        mean_y += data[i].y;
+    }
+    mean_y /= n;
+    for (size_t i = 0; i < n; i++) {
+        double y_pred = c / (1 + a * exp(-(b / std_x) * (data[i].x - mean_x)));
+        ss_tot += (data[i].y - mean_y) * (data[i].y - mean_y);
+        ss_res += (data[i].y - y_pred) * (data[i].y - y_pred);
+    }
+    return 1 - ss_res / ss_tot;
+}
+
+// Jalankan fungsi beberapa kali dan ambil waktu terbaik
+#define BENCH_REPEAT 5
+#define BENCH_BEST(seconds, stmt)                      \
+    do {                                               \
+        seconds = 1e30;                                \
+        for (int rep_ = 0; rep_ < BENCH_REPEAT; rep_++) { \
+            double start_ = monotonicSeconds();        \
+            stmt;                                      \
+            double elapsed_ = monotonicSeconds() - start_; \
+            if (elapsed_ < seconds)                    \
+                seconds = elapsed_;                    \
+        }                                              \
+    } while (0)
+
+// Loader CSV: fgets/strtok lama (dua kali baca file) vs mmap satu lintasan, dalam MB/s dan baris/s
+static void benchCSVLoad(size_t n) {
+    char path[] = "/tmp/curvefit_bench_XXXXXX";
+    int fd = mkstemp(path);
+    FILE *out = fd >= 0 ? fdopen(fd, "w") : NULL;
+    if (!out) {
+        return;
+    }
+    fprintf(out, "waktu,suhu,kelembapan\n");
+    for (size_t i = 0; i < n; i++) {
+        fprintf(out, "%.9g,%.9g,%.4f\n", 0.01 * i, 20.0 + 5.0 * benchUniform(), benchUniform());
+    }
+    long bytes = ftell(out);
+    fclose(out);
+
+    printf("\n== readCSVData: %zu baris, %.1f MB ==\n", n, bytes / (1024.0 * 1024.0));
+    printf("%-22s %12s %14s\n", "loader", "MB/s", "baris/s");
+    int rows_stdio = 0, rows_mmap = 0;
+    double seconds;
+    DataPoint *data;
+    BENCH_BEST(seconds, data = readCSVDataStdio(path, 0, 1, &rows_stdio); free(data));
+    printf("%-22s %12.1f %14.3g\n", "fgets/strtok (lama)", bytes / (1024.0 * 1024.0) / seconds,
+           rows_stdio / seconds);
+    BENCH_BEST(seconds, data = readCSVData(path, 0, 1, &rows_mmap); free(data));
+    printf("%-22s %12.1f %14.3g\n", "mmap satu lintasan", bytes / (1024.0 * 1024.0) / seconds, rows_mmap / seconds);
+    if (rows_stdio != rows_mmap) {
+        printf("Peringatan: jumlah baris berbeda (%d vs %d)\n", rows_stdio, rows_mmap);
+    }
+    unlink(path);
+}
+
+static void benchLinearMoments(size_t n) {
+    DataPoint *data = (DataPoint *)malloc(n * sizeof(DataPoint));
+    double *xs = (double *)malloc(n * sizeof(double));
+    double *ys = (double *)malloc(n * sizeof(double));
+    if (!data || !xs || !ys) {
+        printf("Error: memori tidak cukup untuk %zu titik\n", n);
+        free(data);
+        free(xs);
+        free(ys);
+        return;
+    }
+    // y = 3x + 1000 + noise, x jauh dari nol untuk menguji cancellation
+    for (size_t i = 0; i < n; i++) {
+        double x = 1e6 + 1000.0 * benchUniform();
+        xs[i] = data[i].x = x;
+        ys[i] = data[i].y = 3.0 * x + 1000.0 + (benchUniform() - 0.5);
+    }
+
+    printf("\n== linearRegression: %zu titik ==\n", n);
+    printf("%-22s %12s %14s %16s\n", "implementasi", "ns/titik", "slope", "r_squared");
+
+    double seconds;
+    RegressionResult r;
+    BENCH_BEST(seconds, r = referenceLinearRegression(data, (int)n));
+    printf("%-22s %12.3f %14.10f %16.12f\n", "reference (pow)", seconds * 1e9 / n, r.slope, r.r_squared);
+
+    MomentsKernel kernels[] = {MOMENTS_KERNEL_SCALAR, MOMENTS_KERNEL_AVX2, MOMENTS_KERNEL_AVX512};
+    MomentsKernel best = selectMomentsKernel();
+    for (int k = 0; k < 3; k++) {
+        if (kernels[k] > best) {
+            continue;
+        }
+        char label[32];
+        Moments m;
+        BENCH_BEST(seconds, m = computeMomentsInterleavedWith(kernels[k], &data[0].x, n));
+        linearFromMoments(&m, &r);
+        snprintf(label, sizeof(label), "%s AoS", momentsKernelName(kernels[k]));
+        printf("%-22s %12.3f %14.10f %16.12f\n", label, seconds * 1e9 / n, r.slope, r.r_squared);
+
+        BENCH_BEST(seconds, m = computeMomentsColumnsWith(kernels[k], xs, ys, n));
+        linearFromMoments(&m, &r);
+        snprintf(label, sizeof(label), "%s SoA", momentsKernelName(kernels[k]));
+        printf("%-22s %12.3f %14.10f %16.12f\n", label, seconds * 1e9 / n, r.slope, r.r_squared);
+    }
+
+    free(data);
+    free(xs);
+    free(ys);
+}
+
+// R-squared dihitung ulang langsung dari data, untuk memeriksa koefisien yang dihasilkan
+static double benchPolynomialR2(const DataPoint *data, size_t n, const double *coefficients, int degree) {
+    double mean_y = 0, ss_tot = 0, ss_res = 0;
+    for (size_t i = 0; i < n; i++) {
+        mean_y += data[i].y;
+    }
+    mean_y /= n;
+    for (size_t i = 0; i < n; i++) {
+        double y_pred = coefficients[degree];
+        for (int j = degree - 1; j >= 0; j--) {
+            y_pred = y_pred * data[i].x + coefficients[j];
+        }
+        ss_tot += (data[i].y - mean_y) * (data[i].y - mean_y);
+        ss_res += (data[i].y - y_pred) * (data[i].y - y_pred);
+    }
+    return 1 - ss_res / ss_tot;
+}
+
+static void benchPolynomial(size_t max_n) {
+    static const int degrees[] = {2, 5, 8, 10};
+    printf("\n== polynomialRegression: y = 10 sin(x/10) + noise, x di [0, 100] ==\n");
+    printf("%10s %6s %-12s %12s %18s\n", "N", "derajat", "solver", "ns/titik", "R² (dicek ulang)");
+
+    for (size_t n = 1000; n <= max_n; n *= 10) {
+        DataPoint *data = (DataPoint *)malloc(n * sizeof(DataPoint));
+        if (!data) {
+            return;
+        }
+        for (size_t i = 0; i < n; i++) {
+            data[i].x = 100.0 * benchUniform();
+            data[i].y = 10.0 * sin(data[i].x / 10.0) + (benchUniform() - 0.5);
+        }
+
+        for (int d = 0; d < 4; d++) {
+            int degree = degrees[d];
+            double coefficients[MAX_POLY_DEGREE + 1];
+            double r2, seconds;
+
+            RegressionResult r;
+            BENCH_BEST(seconds, r = referencePolynomialRegression(data, (int)n, degree); freeRegressionResult(&r));
+            r = referencePolynomialRegression(data, (int)n, degree);
+            printf("%10zu %6d %-12s %12.3f %18.12f\n", n, degree, "reference", seconds * 1e9 / n,
+                   benchPolynomialR2(data, n, r.coefficients, degree));
+            freeRegressionResult(&r);
+
+            BENCH_BEST(seconds, polyFit(&data[0].x, &data[0].y, 2, n, degree, POLY_SOLVER_CHOLESKY, coefficients, &r2));
+            printf("%10zu %6d %-12s %12.3f %18.12f\n", n, degree, "cholesky", seconds * 1e9 / n,
+                   benchPolynomialR2(data, n, coefficients, degree));
+
+            BENCH_BEST(seconds, polyFit(&data[0].x, &data[0].y, 2, n, degree, POLY_SOLVER_QR, coefficients, &r2));
+            printf("%10zu %6d %-12s %12.3f %18.12f\n", n, degree, "householder", seconds * 1e9 / n,
+                   benchPolynomialR2(data, n, coefficients, degree));
+        }
+        free(data);
+    }
+}
+
+static void benchLogistic(size_t n) {
+    DataPoint *data = (DataPoint *)malloc(n * sizeof(DataPoint));
+    if (!data) {
+        return;
+    }
+    // Kurva pertumbuhan y = 500 / (1 + 20 e^(-0.12 (x - 50))) + noise
+    for (size_t i = 0; i < n; i++) {
+        data[i].x = 100.0 * benchUniform();
+        data[i].y = 500.0 / (1.0 + 20.0 * exp(-0.12 * (data[i].x - 50.0))) + 10.0 * (benchUniform() - 0.5);
+    }
+
+    printf("\n== logisticRegression: %zu titik ==\n", n);
+    printf("%-22s %10s %12s %16s\n", "implementasi", "iterasi", "ms", "r_squared");
+
+    int iterations;
+    double r2;
+    double start = monotonicSeconds();
+    r2 = referenceLogisticRegression(data, n, &iterations);
+    printf("%-22s %10d %12.3f %16.12f\n", "gradient descent", iterations, (monotonicSeconds() - start) * 1e3, r2);
+
+    LMReport report;
+    double seconds;
+    RegressionResult r;
+    BENCH_BEST(seconds, r = logisticRegressionWithReport(&data[0].x, &data[0].y, 2, (int)n, NULL, &report));
+    printf("%-22s %10d %12.3f %16.12f\n", "levenberg-marquardt", report.iterations, seconds * 1e3, r.r_squared);
+    free(data);
+}
+
+static void benchExp(void) {
+    enum { N = 4096 };
+    static double in[N], out[N];
+    for (size_t i = 0; i < N; i++) {
+        in[i] = 40.0 * benchUniform() - 20.0;
+    }
+    printf("\n== exp: ns per nilai ==\n");
+    double seconds, sink = 0;
+    BENCH_BEST(seconds, for (int r = 0; r < 200; r++) for (size_t i = 0; i < N; i++) out[i] = exp(in[i]); sink += out[0]);
+    printf("%-22s %12.3f\n", "libm exp", seconds * 1e9 / (200.0 * N));
+    BENCH_BEST(seconds, for (int r = 0; r < 200; r++) { memcpy(out, in, sizeof(in)); vectorExpWith(MOMENTS_KERNEL_SCALAR, out, N); }; sink += out[0]);
+    printf("%-22s %12.3f\n", "vectorExp scalar", seconds * 1e9 / (200.0 * N));
+    BENCH_BEST(seconds, for (int r = 0; r < 200; r++) { memcpy(out, in, sizeof(in)); vectorExpWith(MOMENTS_KERNEL_AVX2, out, N); }; sink += out[0]);
+    printf("%-22s %12.3f\n", "vectorExp avx2", seconds * 1e9 / (200.0 * N));
+    if (sink == 0) {
+        printf("\n");
+    }
+}
+
+// Skalabilitas regresi logistic terhadap jumlah thread. Hasil harus identik untuk semua
+// jumlah thread karena chunk dan urutan penggabungan tetap.
+static void benchLogisticScaling(size_t n) {
+    DataPoint *data = (DataPoint *)malloc(n * sizeof(DataPoint));
+    if (!data) {
+        return;
+    }
+    for (size_t i = 0; i < n; i++) {
+        data[i].x = 100.0 * benchUniform();
+        data[i].y = 500.0 / (1.0 + 20.0 * exp(-0.12 * (data[i].x - 50.0))) + 10.0 * (benchUniform() - 0.5);
+    }
+
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    printf("\n== logisticRegression paralel: %zu titik, %ld core ==\n", n, cores);
+    printf("%8s %12s %10s %22s\n", "thread", "ms", "speedup", "r_squared");
+
+    double base = 0;
+    for (int threads = 1; threads <= (cores > 1 ? cores : 1); threads *= 2) {
+        ThreadPool *pool = threadPoolCreate(threads);
+        LMReport report;
+        RegressionResult r;
+        double seconds;
+        BENCH_BEST(seconds, r = logisticRegressionWithReport(&data[0].x, &data[0].y, 2, (int)n, pool, &report));
+        base = threads == 1 ? seconds : base;
+        printf("%8d %12.3f %10.2f %22.17f\n", threads, seconds * 1e3, base / seconds, r.r_squared);
+        threadPoolDestroy(pool);
+        if (threads < cores && threads * 2 > cores) {
+            threads = (int)cores / 2; // Baris terakhir selalu memakai semua core
+        }
+    }
+    free(data);
+}
+
+// Banyak fit kecil berturut-turut (seperti jendela bergulir atau semua pasangan kolom): koefisien
+// dan buffer dari heap per panggilan dibandingkan dengan FitWorkspace yang di-reset setiap fit
+static void benchWorkspace(void) {
+    enum { WINDOW = 256, SHIFTS = 16, FITS = 5000 };
+    DataPoint *data = (DataPoint *)malloc((WINDOW + SHIFTS) * sizeof(DataPoint));
+    if (!data) {
+        return;
+    }
+    // Jendela digeser 0..SHIFTS-1 titik; setiap jendela memuat hampir seluruh kurva logistic
+    for (size_t i = 0; i < WINDOW + SHIFTS; i++) {
+        data[i].x = (double)i;
+        data[i].y = 50.0 / (1.0 + exp(-0.05 * (data[i].x - (WINDOW + SHIFTS) / 2))) + (benchUniform() - 0.5);
+    }
+
+    printf("\n== %d fit berturut-turut, jendela %d titik ==\n", FITS, WINDOW);
+    printf("%-12s %-10s %12s %16s\n", "model", "memori", "ns/fit", "malloc workspace");
+    for (int logistic = 0; logistic <= 1; logistic++) {
+        const char *name = logistic ? "logistic" : "polynomial3";
+        double seconds, checksum = 0;
+        BENCH_BEST(seconds, for (int f = 0; f < FITS; f++) {
+            DataPoint *window = data + f % SHIFTS;
+            RegressionResult r = logistic ? logisticRegression(window, WINDOW) : polynomialRegression(window, WINDOW, 3);
+            checksum += r.r_squared;
+            freeRegressionResult(&r);
+        });
+        printf("%-12s %-10s %12.1f %16s\n", name, "heap", seconds * 1e9 / FITS, "-");
+
+        FitWorkspace ws;
+        fitWorkspaceInit(&ws, 0);
+        BENCH_BEST(seconds, for (int f = 0; f < FITS; f++) {
+            const DataPoint *window = data + f % SHIFTS;
+            fitWorkspaceReset(&ws);
+            RegressionResult r =
+                logistic ? logisticRegressionWorkspace(&window->x, &window->y, 2, WINDOW, NULL, NULL, &ws)
+                         : polynomialRegressionWorkspace(&window->x, &window->y, 2, WINDOW, 3, &ws);
+            checksum -= r.r_squared;
+        });
+        printf("%-12s %-10s %12.1f %16zu\n", name, "workspace", seconds * 1e9 / FITS, ws.heap_allocations);
+        fitWorkspaceFree(&ws);
+        if (fabs(checksum) > 1e-6) {
+            printf("Peringatan: hasil heap dan workspace berbeda\n");
+        }
+    }
+    free(data);
+}
+
+// Biaya instrumentasi per fit kecil (32 titik): metrics mati (hanya cek flag) dan aktif (jam + atomic)
+static void benchMetrics(void) {
+    enum { POINTS = 32, FITS = 200000 };
+    DataPoint data[POINTS];
+    for (int i = 0; i < POINTS; i++) {
+        data[i].x = i;
+        data[i].y = 3.0 * i + benchUniform();
+    }
+    printf("\n== Overhead metrics, %d fit linear %d titik ==\n", FITS, POINTS);
+    for (int enabled = 0; enabled <= 1; enabled++) {
+        metricsEnable(enabled);
+        double seconds, checksum = 0;
+        BENCH_BEST(seconds, for (int f = 0; f < FITS; f++) {
+            checksum += linearRegression(data, POINTS).slope;
+        });
+        printf("metrics %-6s %8.1f ns/fit (checksum %.3f)\n", enabled ? "aktif" : "mati", seconds * 1e9 / FITS,
+               checksum);
+    }
+    metricsEnable(0);
+    metricsReset();
+}
+
+// Least squares berganda: XᵀX per baris (outer product, satu thread) dibandingkan Gram per tile
+// kolom-mayor, serial dan dengan thread pool; plus polynomial derajat 3 sebagai kasus khusus
+static void benchLeastSquares(size_t n) {
+    enum { FEATURES = 8 };
+    double *columns = (double *)malloc((FEATURES + 1) * n * sizeof(double));
+    if (!columns) {
+        return;
+    }
+    const double *x[FEATURES];
+    double *y = columns + FEATURES * n;
+    for (int j = 0; j < FEATURES; j++) {
+        x[j] = columns + j * n;
+    }
+    for (size_t i = 0; i < n; i++) {
+        y[i] = benchUniform();
+        for (int j = 0; j < FEATURES; j++) {
+            columns[j * n + i] = benchUniform() * (j + 1);
+            y[i] += (j - 3.5) * columns[j * n + i];
+        }
+    }
+
+    printf("\n== Least squares %d kolom, N = %zu ==\n", FEATURES, n);
+    double seconds;
+    double gram[(FEATURES + 2) * (FEATURES + 2)];
+    BENCH_BEST(seconds, {
+        memset(gram, 0, sizeof(gram));
+        for (size_t i = 0; i < n; i++) {
+            double row[FEATURES + 2] = {1.0};
+            for (int j = 0; j < FEATURES; j++) {
+                row[j + 1] = x[j][i];
+            }
+            row[FEATURES + 1] = y[i];
+            for (int a = 0; a < FEATURES + 2; a++) {
+                for (int b = a; b < FEATURES + 2; b++) {
+                    gram[a * (FEATURES + 2) + b] += row[a] * row[b];
+                }
+            }
+        }
+    });
+    printf("%-28s %8.2f ns/titik\n", "outer product per baris", seconds * 1e9 / n);
+    LeastSquaresResult r;
+    BENCH_BEST(seconds, leastSquaresFit(x, NULL, FEATURES, 1, y, NULL, n, POLY_SOLVER_AUTO, NULL, &r));
+    printf("%-28s %8.2f ns/titik (R² %.6f)\n", "tile kolom-mayor, 1 thread", seconds * 1e9 / n, r.r_squared);
+    BENCH_BEST(seconds, leastSquaresFit(x, NULL, FEATURES, 1, y, NULL, n, POLY_SOLVER_AUTO,
+                                        threadPoolShared(), &r));
+    printf("%-28s %8.2f ns/titik (%d thread)\n", "tile kolom-mayor, pool", seconds * 1e9 / n,
+           threadPoolShared() ? threadPoolShared()->num_threads : 1);
+
+    int degree = 3;
+    double coefficients[4], r2;
+    BENCH_BEST(seconds, polyFit(x[0], y, 1, n, degree, POLY_SOLVER_AUTO, coefficients, &r2));
+    printf("%-28s %8.2f ns/titik\n", "polyFit derajat 3 (Hankel)", seconds * 1e9 / n);
+    BENCH_BEST(seconds, leastSquaresFit(x, &degree, 1, 1, y, NULL, n, POLY_SOLVER_AUTO, NULL, &r));
+    printf("%-28s %8.2f ns/titik (selisih R² %.2e)\n", "leastSquaresFit derajat 3", seconds * 1e9 / n,
+           fabs(r.r_squared - r2));
+    free(columns);
+}
+
+// Jendela bergulir: fit ulang setiap jendela (O(N·W)) dibandingkan update jumlah pangkat O(1) per langkah
+static void benchRolling(size_t n) {
+    enum { WINDOW = 1000, NAIVE_STEPS = 2000 };
+    if (n < 2 * WINDOW) {
+        return;
+    }
+    double *x = (double *)malloc(n * sizeof(double));
+    double *y = (double *)malloc(n * sizeof(double));
+    double *coefficients = (double *)malloc(n * (MAX_POLY_DEGREE + 1) * sizeof(double));
+    double *r_squared = (double *)malloc(n * sizeof(double));
+    if (!x || !y || !coefficients || !r_squared) {
+        free(x);
+        free(y);
+        free(coefficients);
+        free(r_squared);
+        return;
+    }
+    for (size_t i = 0; i < n; i++) {
+        x[i] = (double)i;
+        y[i] = 10.0 * sin(i * 1e-3) + (benchUniform() - 0.5);
+    }
+
+    size_t steps = n - WINDOW + 1;
+    printf("\n== rolling regression: %zu titik, jendela %d ==\n", n, WINDOW);
+    printf("%8s %-12s %12s\n", "derajat", "metode", "ns/langkah");
+    for (int degree = 1; degree <= 3; degree++) {
+        double seconds, r2;
+        BENCH_BEST(seconds, for (size_t s = 0; s < NAIVE_STEPS; s++) {
+            polyFit(x + s, y + s, 1, WINDOW, degree, POLY_SOLVER_CHOLESKY, coefficients, &r2);
+        });
+        printf("%8d %-12s %12.1f\n", degree, "fit ulang", seconds * 1e9 / NAIVE_STEPS);
+        BENCH_BEST(seconds, rollingRegression(x, y, 1, n, WINDOW, degree, NULL, coefficients, r_squared));
+        printf("%8d %-12s %12.1f\n", degree, "rolling", seconds * 1e9 / steps);
+        ThreadPool *pool = threadPoolShared();
+        BENCH_BEST(seconds, rollingRegression(x, y, 1, n, WINDOW, degree, pool, coefficients, r_squared));
+        printf("%8d %-12s %12.1f  (%d thread)\n", degree, "rolling", seconds * 1e9 / steps,
+               pool ? pool->num_threads : 1);
+    }
+    free(x);
+    free(y);
+    free(coefficients);
+    free(r_squared);
+}
+
+// Validasi silang polynomial derajat 1..MAX_POLY_DEGREE: fit ulang per fold dan derajat (salin data latih,
+// polyFit, evaluasi fold uji) dibandingkan jumlah pangkat per fold yang dihitung sekali (autoFit)
+static void benchAutoFit(size_t n) {
+    enum { FOLDS = 5 };
+    double *x = (double *)malloc(n * sizeof(double));
+    double *y = (double *)malloc(n * sizeof(double));
+    double *train_x = (double *)malloc(n * sizeof(double));
+    double *train_y = (double *)malloc(n * sizeof(double));
+    if (!x || !y || !train_x || !train_y) {
+        free(x);
+        free(y);
+        free(train_x);
+        free(train_y);
+        return;
+    }
+    for (size_t i = 0; i < n; i++) {
+        x[i] = benchUniform() * 10.0;
+        y[i] = 0.5 * x[i] * x[i] - 2.0 * x[i] + (benchUniform() - 0.5);
+    }
+
+    printf("\n== autofit %d-fold, polynomial derajat 1..%d, N = %zu ==\n", FOLDS, MAX_POLY_DEGREE, n);
+    double seconds, naive_rmse[MAX_POLY_DEGREE + 1];
+    double coefficients[MAX_POLY_DEGREE + 1], r2;
+    BENCH_BEST(seconds, for (int degree = 1; degree <= MAX_POLY_DEGREE; degree++) {
+        double sse = 0;
+        for (int f = 0; f < FOLDS; f++) {
+            size_t m = 0;
+            for (size_t i = 0; i < n; i++) {
+                if ((int)(i % FOLDS) != f) {
+                    train_x[m] = x[i];
+                    train_y[m++] = y[i];
+                }
+            }
+            polyFit(train_x, train_y, 1, m, degree, POLY_SOLVER_AUTO, coefficients, &r2);
+            for (size_t i = f; i < n; i += FOLDS) {
+                double value = 0;
+                for (int k = degree; k >= 0; k--) {
+                    value = value * x[i] + coefficients[k];
+                }
+                sse += (y[i] - value) * (y[i] - value);
+            }
+        }
+        naive_rmse[degree] = sqrt(sse / n);
+    });
+    printf("%-28s %8.2f ns/titik (RMSE derajat 2: %.6f)\n", "fit ulang per fold/derajat", seconds * 1e9 / n,
+           naive_rmse[2]);
+
+    AutoFitOptions options;
+    AutoFitResult result;
+    defaultAutoFitOptions(&options);
+    options.folds = FOLDS;
+    options.include_logistic = 0;
+    BENCH_BEST(seconds, {
+        autoFit(x, y, 1, n, &options, NULL, &result);
+        freeAutoFitResult(&result);
+    });
+    printf("%-28s %8.2f ns/titik (RMSE derajat 2: %.6f)\n", "jumlah pangkat per fold", seconds * 1e9 / n,
+           result.candidates[1].cv_rmse);
+    ThreadPool *pool = threadPoolShared();
+    BENCH_BEST(seconds, {
+        autoFit(x, y, 1, n, &options, pool, &result);
+        freeAutoFitResult(&result);
+    });
+    printf("%-28s %8.2f ns/titik (%d thread)\n", "jumlah pangkat per fold, pool", seconds * 1e9 / n,
+           pool ? pool->num_threads : 1);
+    free(x);
+    free(y);
+    free(train_x);
+    free(train_y);
+}
+
+int main(int argc, char *argv[]) {
+    size_t n = 10000000;
+    if (argc > 1) {
+        n = (size_t)strtoull(argv[1], NULL, 10);
+    }
+    if (n < 2) {
+        printf("Penggunaan: %s [jumlah_titik]\n", argv[0]);
+        return 1;
+    }
+
+    printf("Kernel momen terpilih: %s\n", momentsKernelName(MOMENTS_KERNEL_AUTO));
+    benchCSVLoad(n < 1000000 ? n : 1000000);
+    benchLinearMoments(n);
+    benchPolynomial(n < 1000000 ? n : 1000000);
+    benchLogistic(n < 1000000 ? n : 1000000);
+    benchExp();
+    benchLogisticScaling(n);
+    benchWorkspace();
+    benchMetrics();
+    benchLeastSquares(n < 1000000 ? n : 1000000);
+    benchRolling(n < 1000000 ? n : 1000000);
+    benchAutoFit(n < 1000000 ? n : 1000000);
+    return 0;
+}
@@ -0,0 +1,286 @@
+#include "csv_fast.h"
+
+// Pangkat 10 yang bisa direpresentasikan tepat sebagai double
+static const double csv_pow10_exact[23] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+// Petakan seluruh file ke memori. Return 0 jika berhasil, -1 jika gagal.
+// File kosong menghasilkan data == NULL dan size == 0.
+int mapFile(const char *filename, MappedFile *mf) {
+    mf->data = NULL;
+    mf->size = 0;
+    mf->fd = open(filename, O_RDONLY);
+    if (mf->fd < 0) {
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(mf->fd, &st) != 0) {
+        close(mf->fd);
+        mf->fd = -1;
+        return -1;
+    }
+
+    mf->size = (size_t)st.st_size;
+    if (mf->size == 0) {
+        return 0;
+    }
+
+    void *addr = mmap(NULL, mf->size, PROT_READ, MAP_PRIVATE, mf->fd, 0);
+    if (addr == MAP_FAILED) {
+        close(mf->fd);
+        mf->fd = -1;
+        mf->size = 0;
+        return -1;
+    }
+    madvise(addr, mf->size, MADV_SEQUENTIAL);
+    mf->data = (const char *)addr;
+    return 0;
+}
+
+void unmapFile(MappedFile *mf) {
+    if (mf->data) {
+        munmap((void *)mf->data, mf->size);
+    }
+    if (mf->fd >= 0) {
+        close(mf->fd);
+    }
+    mf->data = NULL;
+    mf->size = 0;
+    mf->fd = -1;
+}
+
+static int csvMatchWord(const char *p, const char *end, const char *word) {
+    while (*word) {
+        if (p >= end || (*p | 0x20) != *word) {
+            return 0;
+        }
+        p++;
+        word++;
+    }
+    return p == end;
+}
+
+// Parser float tanpa locale untuk satu field CSV [begin, end).
+// Mengabaikan spasi dan tanda kutip di sekitar angka. Return 1 jika seluruh
+// field adalah angka yang valid, 0 jika tidak (field kosong atau teks).
+int parseDoubleField(const char *begin, const char *end, double *out) {
+    while (begin < end && (*begin == ' ' || *begin == '\t' || *begin == '"')) {
+        begin++;
+    }
+    while (end > begin && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r' || end[-1] == '"')) {
+        end--;
+    }
+    if (begin == end) {
+        return 0;
+    }
+
+    const char *p = begin;
+    int negative = 0;
+    if (*p == '-' || *p == '+') {
+        negative = (*p == '-');
+        p++;
+    }
+
+    if (p < end && !(*p >= '0' && *p <= '9') && *p != '.') {
+        if (csvMatchWord(p, end, "inf") || csvMatchWord(p, end, "infinity")) {
+            *out = negative ? -INFINITY : INFINITY;
+            return 1;
+        }
+        if (csvMatchWord(p, end, "nan")) {
+            *out = NAN;
+            return 1;
+        }
+        return 0;
+    }
+
+    // Mantissa disimpan sebagai integer 64-bit (maks 19 digit signifikan)
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    int any_digit = 0;
+
+    while (p < end && *p >= '0' && *p <= '9') {
+        any_digit = 1;
+        if (digits < 19) {
+            mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+            if (mantissa) {
+                digits++;
+            }
+        } else {
+            exponent++;
+        }
+        p++;
+    }
+    if (p < end && *p == '.') {
+        p++;
+        while (p < end && *p >= '0' && *p <= '9') {
+            any_digit = 1;
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+                if (mantissa) {
+                    digits++;
+                }
+                exponent--;
+            }
+            p++;
+        }
+    }
+    if (!any_digit) {
+        return 0;
+    }
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        int exp_negative = 0;
+        if (p < end && (*p == '-' || *p == '+')) {
+            exp_negative = (*p == '-');
+            p++;
+        }
+        if (p == end || !(*p >= '0' && *p <= '9')) {
+            return 0;
+        }
+        int exp_value = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (exp_value < 100000) {
+                exp_value = exp_value * 10 + (*p - '0');
+            }
+            p++;
+        }
+        exponent += exp_negative ? -exp_value : exp_value;
+    }
+    if (p != end) {
+        return 0;
+    }
+
+    double value;
+    if (mantissa == 0) {
+        value = 0.0;
+    } else if (mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+        // Jalur cepat: mantissa dan 10^e sama-sama eksak, hasil dibulatkan sekali
+        value = (double)mantissa;
+        value = exponent < 0 ? value / csv_pow10_exact[-exponent] : value * csv_pow10_exact[exponent];
+    } else if (exponent >= -22 && exponent <= 22) {
+        // Mantissa 17-19 digit (misalnya output %.17g): masih eksak di long double, tanpa powl
+        long double wide = (long double)mantissa;
+        wide = exponent < 0 ? wide / csv_pow10_exact[-exponent] : wide * csv_pow10_exact[exponent];
+        value = (double)wide;
+    } else {
+        value = (double)((long double)mantissa * powl(10.0L, (long double)exponent));
+    }
+
+    *out = negative ? -value : value;
+    return 1;
+}
+
+// Tulis value dengan `digits` angka penting (1..17) dalam format seperti printf("%.*g"),
+// tanpa locale dan tanpa printf, ke out (minimal 32 byte, tanpa terminator '\0').
+// Pembulatan dilakukan sekali dalam long double (tie ke genap), sehingga digit terakhir hanya
+// bisa berbeda dari printf pada kasus yang sangat jarang. Return jumlah karakter yang ditulis.
+int formatDouble(double value, int digits, char *out) {
+    char *p = out;
+    if (isnan(value)) {
+        memcpy(p, "nan", 3);
+        return 3;
+    }
+    if (signbit(value)) {
+        *p++ = '-';
+        value = -value;
+    }
+    if (isinf(value)) {
+        memcpy(p, "inf", 3);
+        return (int)(p - out) + 3;
+    }
+    if (value == 0.0) {
+        *p++ = '0';
+        return (int)(p - out);
+    }
+    digits = digits < 1 ? 1 : (digits > 17 ? 17 : digits);
+
+    // mantissa = round(value * 10^(digits - 1 - exp10)), tepat `digits` digit
+    uint64_t limit = 1;
+    for (int i = 0; i < digits; i++) {
+        limit *= 10;
+    }
+    int exp10 = (int)floor(log10(value));
+    uint64_t mantissa = 0;
+    for (int attempt = 0; attempt < 2; attempt++) {
+        int k = digits - 1 - exp10;
+        long double scaled;
+        if (k >= -22 && k <= 22) {
+            scaled = k >= 0 ? (long double)value * csv_pow10_exact[k] : (long double)value / csv_pow10_exact[-k];
+        } else {
+            scaled = (long double)value * powl(10.0L, (long double)k);
+        }
+        mantissa = (uint64_t)rintl(scaled); // tie ke genap seperti printf
+        if (mantissa >= limit) {
+            // Pembulatan naik ke digit baru (misalnya 9.99 -> 10.0) atau log10 terlalu kecil
+            if (mantissa == limit) {
+                mantissa = limit / 10;
+                exp10++;
+                break;
+            }
+            exp10++;
+        } else if (mantissa < limit / 10) {
+            exp10--;
+        } else {
+            break;
+        }
+    }
+
+    // Digit tanpa nol di belakang
+    char buffer[20];
+    for (int i = digits - 1; i >= 0; i--) {
+        buffer[i] = (char)('0' + mantissa % 10);
+        mantissa /= 10;
+    }
+    int count = digits;
+    while (count > 1 && buffer[count - 1] == '0') {
+        count--;
+    }
+
+    if (exp10 < -4 || exp10 >= digits) {
+        // Notasi eksponen: d.ddde+XX
+        *p++ = buffer[0];
+        if (count > 1) {
+            *p++ = '.';
+            memcpy(p, buffer + 1, count - 1);
+            p += count - 1;
+        }
+        *p++ = 'e';
+        *p++ = exp10 < 0 ? '-' : '+';
+        int e = exp10 < 0 ? -exp10 : exp10;
+        if (e >= 100) {
+            *p++ = (char)('0' + e / 100);
+        }
+        *p++ = (char)('0' + (e / 10) % 10);
+        *p++ = (char)('0' + e % 10);
+    } else if (exp10 >= 0) {
+        // Bagian bulat exp10 + 1 digit, sisanya di belakang koma
+        for (int i = 0; i <= exp10; i++) {
+            *p++ = i < count ? buffer[i] : '0';
+        }
+        if (count > exp10 + 1) {
+            *p++ = '.';
+            memcpy(p, buffer + exp10 + 1, count - exp10 - 1);
+            p += count - exp10 - 1;
+        }
+    } else {
+        // 0.000ddd
+        *p++ = '0';
+        *p++ = '.';
+        for (int i = 0; i < -exp10 - 1; i++) {
+            *p++ = '0';
+        }
+        memcpy(p, buffer, count);
+        p += count;
+    }
+    return (int)(p - out);
+}
+
+double monotonicSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
@@ -0,0 +1,28 @@
+#ifndef CSV_FAST_H
+#define CSV_FAST_H
+
+#include <fcntl.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+// File yang dipetakan ke memori (read-only)
+typedef struct {
+    const char *data;
+    size_t size;
+    int fd;
+} MappedFile;
+
+// Deklarasi fungsi
+int mapFile(const char *filename, MappedFile *mf);
+void unmapFile(MappedFile *mf);
+int parseDoubleField(const char *begin, const char *end, double *out);
+int formatDouble(double value, int digits, char *out);
+double monotonicSeconds(void);
+
+#endif
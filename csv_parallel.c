@@ -0,0 +1,42 @@
+#include "csv_parallel.h"
+
+// Jumlah core yang online, minimal 1
+int defaultThreadCount(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+// Bagi [begin, end) menjadi maksimal `parts` rentang yang batasnya selalu tepat setelah
+// newline, sehingga tidak ada baris yang terpotong. bounds harus muat parts + 1 pointer.
+// Return jumlah rentang sebenarnya (rentang kosong digabung).
+int partitionCSVBody(const char *begin, const char *end, int parts, const char **bounds) {
+    size_t total = (size_t)(end - begin);
+    if (parts < 1) {
+        parts = 1;
+    }
+    if ((size_t)parts > total / PARALLEL_MIN_CHUNK + 1) {
+        parts = (int)(total / PARALLEL_MIN_CHUNK + 1);
+    }
+
+    int count = 0;
+    bounds[0] = begin;
+    for (int i = 1; i < parts; i++) {
+        const char *cut = begin + total / parts * i;
+        if (cut <= bounds[count]) {
+            continue;
+        }
+        const char *newline = (const char *)memchr(cut, '\n', (size_t)(end - cut));
+        if (!newline) {
+            break;
+        }
+        cut = newline + 1;
+        if (cut >= end) {
+            break;
+        }
+        if (cut > bounds[count]) {
+            bounds[++count] = cut;
+        }
+    }
+    bounds[++count] = end;
+    return count;
+}
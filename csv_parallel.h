@@ -0,0 +1,15 @@
+#ifndef CSV_PARALLEL_H
+#define CSV_PARALLEL_H
+
+#include <unistd.h>
+
+#include "curve_fitting.h"
+
+// Ukuran minimum potongan per thread, supaya file kecil tidak dipecah berlebihan
+#define PARALLEL_MIN_CHUNK (1 << 20)
+
+// Deklarasi fungsi
+int defaultThreadCount(void);
+int partitionCSVBody(const char *begin, const char *end, int parts, const char **bounds);
+
+#endif
@@ -0,0 +1,516 @@
+#include "curve_fitting.h"
+
+// Function untuk membaca header CSV
+ColumnInfo *readCSVHeader(const char *filename, int *num_columns) {
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        return NULL;
+    }
+
+    char line[1024];
+    if (!fgets(line, sizeof(line), file)) {
+        fclose(file);
+        return NULL;
+    }
+
+    // Hitung jumlah kolom
+    *num_columns = 0;
+    char *token = strtok(line, ",");
+    while (token) {
+        (*num_columns)++;
+        token = strtok(NULL, ",");
+    }
+
+    // Alokasi memori untuk informasi kolom
+    ColumnInfo *columns = (ColumnInfo *)malloc(*num_columns * sizeof(ColumnInfo));
+    if (!columns) {
+        fclose(file);
+        return NULL;
+    }
+
+    // Baca nama kolom
+    rewind(file);
+    fgets(line, sizeof(line), file);
+    token = strtok(line, ",");
+    int i = 0;
+    while (token && i < *num_columns) {
+        // Hapus whitespace dan newline
+        char *end = token + strlen(token) - 1;
+        while (end > token && (*end == '\n' || *end == '\r' || *end == ' ')) {
+            *end = '\0';
+            end--;
+        }
+        while (*token == ' ')
+            token++;
+
+        strncpy(columns[i].name, token, MAX_COLUMN_NAME - 1);
+        columns[i].name[MAX_COLUMN_NAME - 1] = '\0';
+        columns[i].index = i;
+
+        token = strtok(NULL, ",");
+        i++;
+    }
+
+    fclose(file);
+    return columns;
+}
+
+// Ambil nilai kolom x dan y dari satu baris [line, line_end) tanpa newline.
+// Return 1 jika keduanya ada dan numerik, 0 jika tidak.
+int parseCSVLineXY(const char *line, const char *line_end, int x_column, int y_column, double *x, double *y) {
+    int last_column = x_column > y_column ? x_column : y_column;
+    int found = 0;
+    const char *field = line;
+    for (int col = 0; col <= last_column; col++) {
+        const char *comma = (const char *)memchr(field, ',', (size_t)(line_end - field));
+        const char *field_end = comma ? comma : line_end;
+        if (col == x_column && parseDoubleField(field, field_end, x)) {
+            found |= 1;
+        }
+        if (col == y_column && parseDoubleField(field, field_end, y)) {
+            found |= 2;
+        }
+        if (!comma) {
+            break;
+        }
+        field = comma + 1;
+    }
+    return found == 3;
+}
+
+// Parse baris-baris CSV di [begin, end) ke array DataPoint yang tumbuh secara geometris.
+// Baris kosong dilewati, baris yang kolom x/y-nya tidak ada atau tidak numerik dihitung
+// di *skipped. Tidak ada batas panjang baris. Return 0 jika berhasil, -1 jika gagal alokasi.
+int parseCSVRange(const char *begin, const char *end, int x_column, int y_column,
+                  DataPoint **data, size_t *count, size_t *capacity, size_t *skipped) {
+    const char *p = begin;
+
+    while (p < end) {
+        const char *newline = (const char *)memchr(p, '\n', (size_t)(end - p));
+        const char *line_end = newline ? newline : end;
+        const char *next = newline ? newline + 1 : end;
+        if (line_end > p && line_end[-1] == '\r') {
+            line_end--;
+        }
+        if (line_end == p) {
+            p = next;
+            continue;
+        }
+
+        double x_val, y_val;
+        if (!parseCSVLineXY(p, line_end, x_column, y_column, &x_val, &y_val)) {
+            (*skipped)++;
+        } else {
+            if (*count == *capacity) {
+                size_t new_capacity = *capacity ? *capacity * 2 : 1024;
+                DataPoint *grown = (DataPoint *)realloc(*data, new_capacity * sizeof(DataPoint));
+                if (!grown) {
+                    return -1;
+                }
+                *data = grown;
+                *capacity = new_capacity;
+            }
+            (*data)[*count].x = x_val;
+            (*data)[*count].y = y_val;
+            (*count)++;
+        }
+        p = next;
+    }
+    return 0;
+}
+
+// Perkirakan jumlah baris dari sampel awal file agar realloc jarang terjadi
+static size_t estimateCSVRows(const char *begin, const char *end) {
+    size_t total = (size_t)(end - begin);
+    size_t sample = total < (1 << 16) ? total : (1 << 16);
+    size_t lines = 0;
+    for (const char *p = begin; (p = (const char *)memchr(p, '\n', (size_t)(begin + sample - p))); p++) {
+        lines++;
+    }
+    if (lines == 0) {
+        return 1024;
+    }
+    return (size_t)((double)total / ((double)sample / lines) * 1.05) + 16;
+}
+
+// Function untuk membaca data CSV dengan memory-mapping dalam satu kali lintasan,
+// sekaligus mengisi statistik throughput jika stats tidak NULL
+DataPoint *readCSVDataWithStats(const char *filename, int x_column, int y_column, int *num_points,
+                                CSVLoadStats *stats) {
+    double start = monotonicSeconds();
+    MappedFile mf;
+    if (mapFile(filename, &mf) != 0) {
+        return NULL;
+    }
+
+    // Lewati header
+    const char *begin = mf.data;
+    const char *end = mf.data + mf.size;
+    const char *header_end = mf.size ? (const char *)memchr(begin, '\n', mf.size) : NULL;
+    const char *body = header_end ? header_end + 1 : end;
+
+    size_t capacity = estimateCSVRows(body, end);
+    size_t count = 0, skipped = 0;
+    DataPoint *data = (DataPoint *)malloc(capacity * sizeof(DataPoint));
+    if (!data || parseCSVRange(body, end, x_column, y_column, &data, &count, &capacity, &skipped) != 0) {
+        free(data);
+        unmapFile(&mf);
+        return NULL;
+    }
+    size_t bytes_read = mf.size;
+    unmapFile(&mf);
+
+    // Kembalikan kelebihan kapasitas
+    if (count > 0 && count < capacity) {
+        DataPoint *shrunk = (DataPoint *)realloc(data, count * sizeof(DataPoint));
+        if (shrunk) {
+            data = shrunk;
+        }
+    }
+
+    *num_points = (int)count;
+    metricsSpanEnd(METRIC_SPAN_CSV_LOAD, start);
+    metricsAdd(METRIC_ROWS_PARSED, count);
+    metricsAdd(METRIC_BYTES_READ, bytes_read);
+    metricsAdd(METRIC_ROWS_SKIPPED, skipped);
+    if (stats) {
+        stats->bytes_read = bytes_read;
+        stats->rows = count;
+        stats->rows_skipped = skipped;
+        stats->seconds = monotonicSeconds() - start;
+        stats->mb_per_sec = stats->seconds > 0 ? (double)stats->bytes_read / (1024.0 * 1024.0) / stats->seconds : 0;
+        stats->rows_per_sec = stats->seconds > 0 ? (double)count / stats->seconds : 0;
+    }
+    return data;
+}
+
+// Function untuk membaca data CSV
+DataPoint *readCSVData(const char *filename, int x_column, int y_column, int *num_points) {
+    return readCSVDataWithStats(filename, x_column, y_column, num_points, NULL);
+}
+
+// Loader lama berbasis fgets/strtok (dua kali baca file), disimpan untuk perbandingan
+DataPoint *readCSVDataStdio(const char *filename, int x_column, int y_column, int *num_points) {
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        return NULL;
+    }
+
+    // Hitung jumlah baris
+    char line[1024];
+    *num_points = 0;
+    while (fgets(line, sizeof(line), file)) {
+        (*num_points)++;
+    }
+    (*num_points)--;
+
+    // Alokasi memori
+    DataPoint *data = (DataPoint *)malloc(*num_points * sizeof(DataPoint));
+    if (!data) {
+        fclose(file);
+        return NULL;
+    }
+
+    // Reset pointer file ke awal
+    rewind(file);
+
+    // Lewati header
+    fgets(line, sizeof(line), file);
+
+    // Baca data
+    int i = 0;
+    while (fgets(line, sizeof(line), file) && i < *num_points) {
+        char *token = strtok(line, ",");
+        int col = 0;
+        double x_val = 0, y_val = 0;
+
+        while (token) {
+            if (col == x_column) {
+                x_val = atof(token);
+            }
+            if (col == y_column) {
+                y_val = atof(token);
+            }
+            token = strtok(NULL, ",");
+            col++;
+        }
+
+        data[i].x = x_val;
+        data[i].y = y_val;
+        i++;
+    }
+
+    fclose(file);
+    return data;
+}
+
+// Slope, intercept dan R-squared regresi linear langsung dari momen, tanpa lintasan
+// kedua. Untuk least squares linear, R² = Sxy² / (Sxx * Syy) (momen terpusat).
+void linearFromMoments(const Moments *m, RegressionResult *result) {
+    double n = m->n;
+    double mean_dx = m->sum_x / n;
+    double mean_dy = m->sum_y / n;
+    double sxx = m->sum_xx - m->sum_x * mean_dx;
+    double sxy = m->sum_xy - m->sum_x * mean_dy;
+    double syy = m->sum_yy - m->sum_y * mean_dy;
+
+    result->type = REGRESSION_LINEAR;
+    result->coefficients = NULL;
+    result->mean_x = 0;
+    result->slope = sxy / sxx;
+    result->intercept = (m->shift_y + mean_dy) - result->slope * (m->shift_x + mean_dx);
+    result->r_squared = (sxy * sxy) / (sxx * syy);
+}
+
+
+RegressionResult linearRegression(DataPoint *data, int num_points) {
+    RegressionResult result;
+    result.type = REGRESSION_LINEAR;
+    result.coefficients = NULL; // Inisialisasi ke NULL untuk membedakan dari regresi polynomial
+
+    // Semua jumlah (termasuk untuk R-squared) dihitung dalam satu lintasan SIMD
+    double span = metricsSpanBegin();
+    Moments m = computeMomentsInterleaved(&data[0].x, (size_t)num_points);
+    linearFromMoments(&m, &result);
+    metricsSpanEnd(METRIC_SPAN_FIT_LINEAR, span);
+    metricsAdd(METRIC_FITS, 1);
+
+    return result;
+}
+
+RegressionResult polynomialRegression(DataPoint *data, int num_points, int degree) {
+    return polynomialRegressionWorkspace(&data[0].x, &data[0].y, 2, num_points, degree, NULL);
+}
+
+// Regresi polynomial dengan koefisien dari ws (valid sampai fitWorkspaceReset), atau dari heap
+// jika ws NULL. Tanpa alokasi lain: matriks momen dan solver memakai stack.
+RegressionResult polynomialRegressionWorkspace(const double *x, const double *y, size_t stride, int num_points,
+                                               int degree, FitWorkspace *ws) {
+    RegressionResult result;
+    result.type = REGRESSION_POLYNOMIAL;
+    result.degree = degree;
+    result.mean_x = 0;
+    size_t size = (size_t)(degree + 1) * sizeof(double);
+    result.coefficients = (double *)(ws ? fitWorkspaceAlloc(ws, size) : malloc(size));
+    if (!result.coefficients) {
+        result.r_squared = NAN;
+        return result;
+    }
+
+    // Satu lintasan jumlah pangkat pada x yang diskalakan, diselesaikan dengan Cholesky
+    // (otomatis pindah ke Householder QR jika matriks momen tidak stabil)
+    double span = metricsSpanBegin();
+    if (polyFit(x, y, stride, (size_t)num_points, degree, POLY_SOLVER_AUTO, result.coefficients,
+                &result.r_squared) != 0) {
+        for (int i = 0; i <= degree; i++) {
+            result.coefficients[i] = NAN;
+        }
+        result.r_squared = NAN;
+    }
+    metricsSpanEnd(METRIC_SPAN_FIT_POLYNOMIAL, span);
+    metricsAdd(METRIC_FITS, 1);
+
+    return result;
+}
+
+// Bangun hasil regresi linear (degree diabaikan) atau polynomial langsung dari statistik
+// cukup, tanpa data mentah. Dipakai oleh mode streaming dan inkremental.
+RegressionResult regressionFromAccumulator(const PolyAccumulator *acc, RegressionType type, int degree) {
+    RegressionResult result;
+    memset(&result, 0, sizeof(result));
+    result.type = type;
+    result.degree = type == REGRESSION_LINEAR ? 1 : degree;
+
+    double coefficients[MAX_POLY_DEGREE + 1];
+    int solved = polyAccumulatorSolve(acc, result.degree, coefficients, &result.r_squared) == 0;
+    if (!solved) {
+        result.r_squared = NAN;
+    }
+
+    if (type == REGRESSION_LINEAR) {
+        result.slope = solved ? coefficients[1] : NAN;
+        result.intercept = solved ? coefficients[0] : NAN;
+    } else {
+        result.coefficients = (double *)malloc((result.degree + 1) * sizeof(double));
+        for (int i = 0; result.coefficients && i <= result.degree; i++) {
+            result.coefficients[i] = solved ? coefficients[i] : NAN;
+        }
+    }
+    return result;
+}
+
+// Interpolasi linear satu query dalam satu lintasan: cari titik terdekat di kiri dan kanan x,
+// sehingga data tidak perlu urut. Di luar rentang dipakai nilai y titik ujung terdekat.
+// Untuk banyak query pada data yang sama, pakai InterpIndex (interp.h) yang O(log N) per query.
+double interpolate(DataPoint *data, int num_points, double x) {
+    int left = -1, right = -1;
+    for (int i = 0; i < num_points; i++) {
+        double xi = data[i].x;
+        if (xi <= x && (left < 0 || xi > data[left].x)) {
+            left = i;
+        }
+        if (xi >= x && (right < 0 || xi < data[right].x)) {
+            right = i;
+        }
+    }
+    if (left < 0 && right < 0) {
+        return NAN;
+    }
+    if (left < 0 || right < 0 || data[left].x == data[right].x) {
+        return data[left < 0 ? right : left].y;
+    }
+
+    // Interpolasi linear
+    double x0 = data[left].x;
+    double x1 = data[right].x;
+    double y0 = data[left].y;
+    double y1 = data[right].y;
+
+    return y0 + (y1 - y0) * (x - x0) / (x1 - x0);
+}
+
+void freeData(DataPoint *data) {
+    free(data);
+}
+
+void freeRegressionResult(RegressionResult *result) {
+    if (result->coefficients != NULL) {
+        free(result->coefficients);
+        result->coefficients = NULL;
+    }
+}
+
+// Model logistic pada x yang dinormalisasi t = (x - mean_x) / std_x, dengan a = e^u supaya
+// a selalu positif: y = c / (1 + e^(u - b t)). Satu exp per titik untuk nilai dan Jacobian.
+typedef struct {
+    double mean_x;
+    double inv_std;
+} LogisticModelCtx;
+
+static void logisticModelEval(const double *params, const double *x, size_t stride, size_t n,
+                              double *values, double *jacobian, const void *ctx) {
+    const LogisticModelCtx *m = (const LogisticModelCtx *)ctx;
+    double u = params[0], b = params[1], c = params[2];
+    double t[LM_BLOCK], e[LM_BLOCK]; // n <= LM_BLOCK
+    for (size_t i = 0; i < n; i++) {
+        t[i] = (x[i * stride] - m->mean_x) * m->inv_std;
+        e[i] = u - b * t[i];
+    }
+    vectorExp(e, n); // Eksponen dijepit ke [-708, 709], tidak overflow
+    for (size_t i = 0; i < n; i++) {
+        double inv = 1.0 / (1.0 + e[i]);
+        double f = c * inv;
+        values[i] = f;
+        jacobian[i * 3 + 0] = -f * e[i] * inv;       // ∂f/∂u
+        jacobian[i * 3 + 1] = f * e[i] * inv * t[i]; // ∂f/∂b
+        jacobian[i * 3 + 2] = inv;                   // ∂f/∂c
+    }
+}
+
+// Function untuk regresi logistic
+// Referensi: https://math.libretexts.org/Workbench/1250_Draft_3/06%3A_Exponential_and_Logarithmic_Functions/6.09%3A_Exponential_and_Logarithmic_Regressions
+// Tebakan awal dari linearisasi ln(c/y - 1) = u - b t, lalu diperhalus dengan Levenberg-Marquardt.
+// Laporan solver (iterasi, evaluasi, waktu) ditulis ke report jika tidak NULL. stride 2 untuk DataPoint,
+// pool NULL berarti pool bersama (threadPoolShared). Buffer solver diambil dari ws jika tidak NULL.
+RegressionResult logisticRegressionWorkspace(const double *xs, const double *ys, size_t stride, int num_points,
+                                             ThreadPool *pool, LMReport *report, FitWorkspace *ws) {
+    RegressionResult result;
+    memset(&result, 0, sizeof(result));
+    result.type = REGRESSION_LOGISTIC;
+    // Tiga parameter butuh minimal tiga titik; ys tidak boleh dibaca jika data kosong
+    if (num_points < 3) {
+        result.a = result.b = result.c = result.mean_x = NAN;
+        result.r_squared = NAN;
+        return result;
+    }
+    double span = metricsSpanBegin();
+
+    // Mencari nilai maksimum y untuk estimasi kapasitas, sekaligus mean x dan y
+    double max_y = ys[0];
+    double sum_x = 0, sum_y = 0;
+    for (int i = 0; i < num_points; i++) {
+        if (ys[i * stride] > max_y) {
+            max_y = ys[i * stride];
+        }
+        sum_x += xs[i * stride];
+        sum_y += ys[i * stride];
+    }
+    double mean_x = sum_x / num_points;
+    double mean_y = sum_y / num_points;
+
+    // Normalisasi x untuk stabilitas numerik (dilakukan di dalam model, tanpa salinan data)
+    double sum_squared_x = 0, ss_tot = 0;
+    for (int i = 0; i < num_points; i++) {
+        sum_squared_x += (xs[i * stride] - mean_x) * (xs[i * stride] - mean_x);
+        ss_tot += (ys[i * stride] - mean_y) * (ys[i * stride] - mean_y);
+    }
+    double std_x = sqrt(sum_squared_x / num_points);
+    LogisticModelCtx model_ctx = {mean_x, std_x > 0 ? 1.0 / std_x : 1.0};
+
+    // Tebakan awal: c sedikit di atas y maksimum, u dan b dari regresi linear ln(c/y - 1) terhadap t
+    double c = max_y > 0 ? max_y * 1.1 : 1.0;
+    double st = 0, sz = 0, stt = 0, stz = 0, count = 0;
+    for (int i = 0; i < num_points; i++) {
+        double y = ys[i * stride];
+        if (y > 0 && y < c) {
+            double t = (xs[i * stride] - mean_x) * model_ctx.inv_std;
+            double z = log(c / y - 1.0);
+            st += t;
+            sz += z;
+            stt += t * t;
+            stz += t * z;
+            count++;
+        }
+    }
+    double params[3] = {0.0, 1.0, c};
+    double denom = count * stt - st * st;
+    if (count >= 2 && denom > 0) {
+        double slope = (count * stz - st * sz) / denom;
+        params[0] = (sz - slope * st) / count;
+        params[1] = -slope;
+    }
+
+    NonlinearModel model = {3, logisticModelEval, &model_ctx};
+    LMOptions options;
+    defaultLMOptions(&options);
+    options.max_iterations = MAX_ITERATIONS;
+    // Lintasan data dibagi ke pool hanya jika datanya cukup besar untuk beberapa chunk
+    options.pool = num_points >= 2 * LM_CHUNK ? (pool ? pool : threadPoolShared()) : NULL;
+    options.workspace = ws;
+    LMReport local_report;
+    if (!report) {
+        report = &local_report;
+    }
+    levenbergMarquardt(&model, xs, ys, stride, (size_t)num_points, params, &options, report);
+
+    result.a = exp(params[0]);
+    result.mean_x = mean_x;
+    result.b = params[1] * model_ctx.inv_std; // Sesuaikan b untuk normalisasi
+    result.c = params[2];
+
+    // R-squared langsung dari cost akhir LM, tanpa lintasan data tambahan
+    result.r_squared = 1 - (report->final_cost / ss_tot);
+
+    metricsSpanEnd(METRIC_SPAN_FIT_LOGISTIC, span);
+    if (metrics_enabled) {
+        metricsAdd(METRIC_FITS, 1);
+        metricsAdd(METRIC_LM_ITERATIONS, (uint64_t)report->iterations);
+        metricsAdd(METRIC_LM_EVALUATIONS, (uint64_t)report->evaluations);
+        metricsAdd(METRIC_LM_NOT_CONVERGED, report->status == LM_MAX_ITERATIONS || report->status == LM_FAILED);
+    }
+    return result;
+}
+
+RegressionResult logisticRegression(DataPoint *data, int num_points) {
+    return logisticRegressionWorkspace(&data[0].x, &data[0].y, 2, num_points, NULL, NULL, NULL);
+}
+
+RegressionResult logisticRegressionWithReport(const double *x, const double *y, size_t stride, int num_points,
+                                              ThreadPool *pool, LMReport *report) {
+    return logisticRegressionWorkspace(x, y, stride, num_points, pool, report, NULL);
+}
+
+// Versi untuk data kolumnar (dipakai mode batch)
+RegressionResult logisticRegressionColumns(const double *x, const double *y, int num_points) {
+    return logisticRegressionWorkspace(x, y, 1, num_points, NULL, NULL, NULL);
+}
@@ -0,0 +1,403 @@
+#include "dataset.h"
+
+// Parse baris header [begin, end) tanpa batas panjang maupun jumlah kolom
+ColumnInfo *parseCSVHeaderLine(const char *begin, const char *end, int *num_columns) {
+    if (end > begin && end[-1] == '\r') {
+        end--;
+    }
+
+    int count = 1;
+    for (const char *p = begin; (p = (const char *)memchr(p, ',', (size_t)(end - p))); p++) {
+        count++;
+    }
+
+    ColumnInfo *columns = (ColumnInfo *)malloc(count * sizeof(ColumnInfo));
+    if (!columns) {
+        return NULL;
+    }
+
+    const char *field = begin;
+    for (int i = 0; i < count; i++) {
+        const char *comma = (const char *)memchr(field, ',', (size_t)(end - field));
+        const char *field_end = comma ? comma : end;
+        const char *name = field;
+
+        // Hapus whitespace dan tanda kutip
+        while (name < field_end && (*name == ' ' || *name == '\t' || *name == '"')) {
+            name++;
+        }
+        const char *name_end = field_end;
+        while (name_end > name && (name_end[-1] == ' ' || name_end[-1] == '\t' || name_end[-1] == '"')) {
+            name_end--;
+        }
+
+        size_t len = (size_t)(name_end - name);
+        if (len > MAX_COLUMN_NAME - 1) {
+            len = MAX_COLUMN_NAME - 1;
+        }
+        memcpy(columns[i].name, name, len);
+        columns[i].name[len] = '\0';
+        columns[i].index = i;
+        field = comma ? comma + 1 : end;
+    }
+
+    *num_columns = count;
+    return columns;
+}
+
+typedef struct {
+    const char *begin;
+    const char *end;
+    int num_columns;
+    double **values;
+    size_t *numeric_count;
+    size_t count;
+    size_t capacity;
+    int status;
+} ColumnChunkJob;
+
+static int growColumnChunk(ColumnChunkJob *job) {
+    size_t new_capacity = job->capacity ? job->capacity * 2 : 1024;
+    for (int c = 0; c < job->num_columns; c++) {
+        double *grown = (double *)realloc(job->values[c], new_capacity * sizeof(double));
+        if (!grown) {
+            return -1;
+        }
+        job->values[c] = grown;
+    }
+    job->capacity = new_capacity;
+    return 0;
+}
+
+// Parse semua kolom dari baris-baris di [begin, end) ke array per kolom
+static void *parseColumnChunkThread(void *arg) {
+    ColumnChunkJob *job = (ColumnChunkJob *)arg;
+    const char *p = job->begin;
+    const char *end = job->end;
+    int num_columns = job->num_columns;
+
+    job->values = (double **)calloc(num_columns, sizeof(double *));
+    job->numeric_count = (size_t *)calloc(num_columns, sizeof(size_t));
+    if (!job->values || !job->numeric_count) {
+        job->status = -1;
+        return NULL;
+    }
+
+    while (p < end) {
+        const char *newline = (const char *)memchr(p, '\n', (size_t)(end - p));
+        const char *line_end = newline ? newline : end;
+        const char *next = newline ? newline + 1 : end;
+        if (line_end > p && line_end[-1] == '\r') {
+            line_end--;
+        }
+        if (line_end == p) {
+            p = next;
+            continue;
+        }
+
+        if (job->count == job->capacity && growColumnChunk(job) != 0) {
+            job->status = -1;
+            return NULL;
+        }
+
+        size_t row = job->count++;
+        const char *field = p;
+        for (int c = 0; c < num_columns; c++) {
+            double value = NAN;
+            if (field) {
+                const char *comma = (const char *)memchr(field, ',', (size_t)(line_end - field));
+                const char *field_end = comma ? comma : line_end;
+                if (parseDoubleField(field, field_end, &value)) {
+                    job->numeric_count[c]++;
+                } else {
+                    value = NAN;
+                }
+                field = comma ? comma + 1 : NULL;
+            }
+            job->values[c][row] = value;
+        }
+        p = next;
+    }
+    job->status = 0;
+    return NULL;
+}
+
+// Function untuk membaca seluruh kolom CSV dalam satu lintasan ke dataset kolumnar.
+// Potongan file sejajar newline (partitionCSVBody) di-parse paralel lalu disambung sesuai urutan baris,
+// jadi pasangan kolom yang dihasilkan identik dengan readCSVData. Return CF_OK jika berhasil.
+CFStatus loadDataset(const char *filename, Dataset *ds, int num_threads, CSVLoadStats *stats) {
+    double start = monotonicSeconds();
+    memset(ds, 0, sizeof(*ds));
+    if (num_threads <= 0) {
+        num_threads = defaultThreadCount();
+    }
+
+    MappedFile mf;
+    if (mapFile(filename, &mf) != 0) {
+        return CF_ERROR_IO;
+    }
+    if (mf.size == 0) {
+        unmapFile(&mf);
+        return CF_ERROR_FORMAT;
+    }
+
+    const char *end = mf.data + mf.size;
+    const char *header_end = (const char *)memchr(mf.data, '\n', mf.size);
+    const char *body = header_end ? header_end + 1 : end;
+    ds->columns = parseCSVHeaderLine(mf.data, header_end ? header_end : end, &ds->num_columns);
+    if (!ds->columns) {
+        unmapFile(&mf);
+        return CF_ERROR_FORMAT;
+    }
+
+    const char **bounds = (const char **)malloc((num_threads + 1) * sizeof(const char *));
+    ColumnChunkJob *jobs = (ColumnChunkJob *)calloc(num_threads, sizeof(ColumnChunkJob));
+    pthread_t *threads = (pthread_t *)malloc(num_threads * sizeof(pthread_t));
+    int status = (bounds && jobs && threads) ? 0 : -1;
+
+    int num_chunks = 0;
+    if (status == 0) {
+        num_chunks = partitionCSVBody(body, end, num_threads, bounds);
+        for (int i = 0; i < num_chunks; i++) {
+            jobs[i].begin = bounds[i];
+            jobs[i].end = bounds[i + 1];
+            jobs[i].num_columns = ds->num_columns;
+        }
+
+        int spawned = 0;
+        for (int i = 1; i < num_chunks; i++) {
+            if (pthread_create(&threads[i], NULL, parseColumnChunkThread, &jobs[i]) != 0) {
+                break;
+            }
+            spawned = i;
+        }
+        parseColumnChunkThread(&jobs[0]);
+        for (int i = 1; i <= spawned; i++) {
+            pthread_join(threads[i], NULL);
+        }
+        for (int i = spawned + 1; i < num_chunks; i++) {
+            parseColumnChunkThread(&jobs[i]);
+        }
+        for (int i = 0; i < num_chunks; i++) {
+            status |= jobs[i].status;
+            ds->num_rows += jobs[i].count;
+        }
+    }
+
+    // Sambung potongan per kolom sesuai urutan baris
+    if (status == 0) {
+        ds->values = (double **)calloc(ds->num_columns, sizeof(double *));
+        ds->numeric_count = (size_t *)calloc(ds->num_columns, sizeof(size_t));
+        status = (ds->values && ds->numeric_count) ? 0 : -1;
+    }
+    for (int c = 0; status == 0 && c < ds->num_columns; c++) {
+        if (num_chunks == 1) {
+            ds->values[c] = jobs[0].values[c];
+            jobs[0].values[c] = NULL;
+            ds->numeric_count[c] = jobs[0].numeric_count[c];
+            continue;
+        }
+        ds->values[c] = (double *)malloc((ds->num_rows ? ds->num_rows : 1) * sizeof(double));
+        if (!ds->values[c]) {
+            status = -1;
+            break;
+        }
+        size_t offset = 0;
+        for (int i = 0; i < num_chunks; i++) {
+            if (jobs[i].count) {
+                memcpy(ds->values[c] + offset, jobs[i].values[c], jobs[i].count * sizeof(double));
+            }
+            offset += jobs[i].count;
+            ds->numeric_count[c] += jobs[i].numeric_count[c];
+        }
+    }
+
+    for (int i = 0; jobs && i < num_chunks; i++) {
+        for (int c = 0; jobs[i].values && c < ds->num_columns; c++) {
+            free(jobs[i].values[c]);
+        }
+        free(jobs[i].values);
+        free(jobs[i].numeric_count);
+    }
+    free(bounds);
+    free(jobs);
+    free(threads);
+    size_t bytes_read = mf.size;
+    unmapFile(&mf);
+
+    if (status != 0) {
+        freeDataset(ds);
+        return CF_ERROR_MEMORY;
+    }
+
+    metricsSpanEnd(METRIC_SPAN_CSV_LOAD, start);
+    if (metrics_enabled) {
+        metricsAdd(METRIC_ROWS_PARSED, ds->num_rows);
+        metricsAdd(METRIC_BYTES_READ, bytes_read);
+        for (int c = 0; c < ds->num_columns; c++) {
+            metricsAdd(METRIC_FIELDS_NON_NUMERIC, ds->num_rows - ds->numeric_count[c]);
+        }
+    }
+    if (stats) {
+        stats->bytes_read = bytes_read;
+        stats->rows = ds->num_rows;
+        stats->rows_skipped = 0;
+        stats->seconds = monotonicSeconds() - start;
+        stats->mb_per_sec = stats->seconds > 0 ? (double)bytes_read / (1024.0 * 1024.0) / stats->seconds : 0;
+        stats->rows_per_sec = stats->seconds > 0 ? (double)ds->num_rows / stats->seconds : 0;
+    }
+    return CF_OK;
+}
+
+void freeDataset(Dataset *ds) {
+    for (int c = 0; ds->values && c < ds->num_columns; c++) {
+        free(ds->values[c]);
+    }
+    free(ds->values);
+    free(ds->numeric_count);
+    free(ds->columns);
+    memset(ds, 0, sizeof(*ds));
+}
+
+// Cari indeks kolom berdasarkan nama, -1 jika tidak ada
+int datasetFindColumn(const Dataset *ds, const char *name) {
+    for (int c = 0; c < ds->num_columns; c++) {
+        if (strcmp(ds->columns[c].name, name) == 0) {
+            return c;
+        }
+    }
+    return -1;
+}
+
+// Kolom dianggap numerik jika minimal satu nilainya berupa angka
+int datasetIsNumericColumn(const Dataset *ds, int column) {
+    return column >= 0 && column < ds->num_columns && ds->numeric_count[column] > 0;
+}
+
+// Ambil pasangan kolom (x, y) tanpa menyalin jika kedua kolom penuh angka. Jika ada NaN, baris
+// yang lengkap disalin ke buffer dari ws, atau dari heap (*scratch, di-free pemanggil) jika ws NULL.
+static int pairColumns(const Dataset *ds, int x_column, int y_column, const double **x, const double **y,
+                       int *num_points, double **scratch, FitWorkspace *ws) {
+    *scratch = NULL;
+    const double *xs = ds->values[x_column];
+    const double *ys = ds->values[y_column];
+    if (ds->numeric_count[x_column] == ds->num_rows && ds->numeric_count[y_column] == ds->num_rows) {
+        int all_finite = 1;
+        for (size_t i = 0; i < ds->num_rows; i++) {
+            all_finite &= (xs[i] == xs[i]) & (ys[i] == ys[i]);
+        }
+        if (all_finite) {
+            *x = xs;
+            *y = ys;
+            *num_points = (int)ds->num_rows;
+            return 0;
+        }
+    }
+
+    size_t size = (2 * ds->num_rows + 1) * sizeof(double);
+    double *buffer = (double *)(ws ? fitWorkspaceAlloc(ws, size) : malloc(size));
+    if (!buffer) {
+        return -1;
+    }
+    size_t n = 0;
+    for (size_t i = 0; i < ds->num_rows; i++) {
+        if (xs[i] == xs[i] && ys[i] == ys[i]) {
+            buffer[n++] = xs[i];
+        }
+    }
+    double *y_out = buffer + n;
+    for (size_t i = 0, k = 0; i < ds->num_rows; i++) {
+        if (xs[i] == xs[i] && ys[i] == ys[i]) {
+            y_out[k++] = ys[i];
+        }
+    }
+    *scratch = ws ? NULL : buffer;
+    *x = buffer;
+    *y = y_out;
+    *num_points = (int)n;
+    return 0;
+}
+
+int datasetPairColumns(const Dataset *ds, int x_column, int y_column,
+                       const double **x, const double **y, int *num_points, double **scratch) {
+    return pairColumns(ds, x_column, y_column, x, y, num_points, scratch, NULL);
+}
+
+// Seperti datasetPairColumns, tetapi buffer baris yang difilter diambil dari ws (valid sampai reset)
+int datasetPairColumnsWorkspace(const Dataset *ds, int x_column, int y_column,
+                                const double **x, const double **y, int *num_points, FitWorkspace *ws) {
+    double *scratch;
+    return pairColumns(ds, x_column, y_column, x, y, num_points, &scratch, ws);
+}
+
+// Salin pasangan kolom ke array DataPoint (untuk plot dan fungsi berbasis DataPoint)
+DataPoint *datasetToPoints(const Dataset *ds, int x_column, int y_column, int *num_points) {
+    const double *x, *y;
+    double *scratch;
+    int n;
+    if (datasetPairColumns(ds, x_column, y_column, &x, &y, &n, &scratch) != 0) {
+        return NULL;
+    }
+    DataPoint *data = (DataPoint *)malloc((n ? n : 1) * sizeof(DataPoint));
+    if (data) {
+        for (int i = 0; i < n; i++) {
+            data[i].x = x[i];
+            data[i].y = y[i];
+        }
+        *num_points = n;
+    }
+    free(scratch);
+    return data;
+}
+
+// Regresi linear langsung pada dua array kolom
+RegressionResult linearRegressionColumns(const double *x, const double *y, int num_points) {
+    RegressionResult result;
+    double span = metricsSpanBegin();
+    Moments m = computeMomentsColumns(x, y, (size_t)num_points);
+    linearFromMoments(&m, &result);
+    metricsSpanEnd(METRIC_SPAN_FIT_LINEAR, span);
+    metricsAdd(METRIC_FITS, 1);
+    return result;
+}
+
+// Regresi polynomial pada dua array kolom
+RegressionResult polynomialRegressionColumns(const double *x, const double *y, int num_points, int degree) {
+    return polynomialRegressionWorkspace(x, y, 1, num_points, degree, NULL);
+}
+
+// Regresi pada pasangan kolom mana pun tanpa membaca ulang file
+RegressionResult datasetRegression(const Dataset *ds, int x_column, int y_column,
+                                   RegressionType type, int degree) {
+    return datasetRegressionWorkspace(ds, x_column, y_column, type, degree, NULL);
+}
+
+// Dengan ws, buffer sementara dan koefisien polynomial diambil dari workspace sehingga fit
+// berulang tidak memanggil malloc; hasilnya valid sampai fitWorkspaceReset.
+RegressionResult datasetRegressionWorkspace(const Dataset *ds, int x_column, int y_column,
+                                            RegressionType type, int degree, FitWorkspace *ws) {
+    RegressionResult result;
+    memset(&result, 0, sizeof(result));
+    result.type = type;
+    result.r_squared = NAN;
+
+    const double *x, *y;
+    double *scratch;
+    int n;
+    if (pairColumns(ds, x_column, y_column, &x, &y, &n, &scratch, ws) != 0) {
+        return result;
+    }
+    if (n == 0) {
+        free(scratch);
+        return result;
+    }
+    if (type == REGRESSION_LINEAR) {
+        result = linearRegressionColumns(x, y, n);
+    } else if (type == REGRESSION_LOGISTIC) {
+        result = logisticRegressionWorkspace(x, y, 1, n, NULL, NULL, ws);
+    } else {
+        result = polynomialRegressionWorkspace(x, y, 1, n, degree, ws);
+    }
+    free(scratch);
+    return result;
+}
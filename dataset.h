@@ -0,0 +1,35 @@
+#ifndef DATASET_H
+#define DATASET_H
+
+#include "csv_parallel.h"
+#include "curve_fitting.h"
+
+// Dataset kolumnar (SoA): header dibaca sekali, setiap kolom disimpan sebagai array
+// double yang kontigu. Field yang kosong atau bukan angka disimpan sebagai NaN.
+typedef struct {
+    int num_columns;
+    size_t num_rows;
+    ColumnInfo *columns;    // Nama kolom dari header
+    double **values;        // values[kolom][baris]
+    size_t *numeric_count;  // Jumlah nilai numerik per kolom
+} Dataset;
+
+// Deklarasi fungsi
+ColumnInfo *parseCSVHeaderLine(const char *begin, const char *end, int *num_columns);
+CFStatus loadDataset(const char *filename, Dataset *ds, int num_threads, CSVLoadStats *stats);
+void freeDataset(Dataset *ds);
+int datasetFindColumn(const Dataset *ds, const char *name);
+int datasetIsNumericColumn(const Dataset *ds, int column);
+int datasetPairColumns(const Dataset *ds, int x_column, int y_column,
+                       const double **x, const double **y, int *num_points, double **scratch);
+int datasetPairColumnsWorkspace(const Dataset *ds, int x_column, int y_column,
+                                const double **x, const double **y, int *num_points, FitWorkspace *ws);
+DataPoint *datasetToPoints(const Dataset *ds, int x_column, int y_column, int *num_points);
+RegressionResult linearRegressionColumns(const double *x, const double *y, int num_points);
+RegressionResult polynomialRegressionColumns(const double *x, const double *y, int num_points, int degree);
+RegressionResult datasetRegression(const Dataset *ds, int x_column, int y_column,
+                                   RegressionType type, int degree);
+RegressionResult datasetRegressionWorkspace(const Dataset *ds, int x_column, int y_column,
+                                            RegressionType type, int degree, FitWorkspace *ws);
+
+#endif
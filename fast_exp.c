@@ -0,0 +1,110 @@
+#include "fast_exp.h"
+
+// Koefisien Taylor 1/k! untuk k = 0..12
+static const double fast_exp_coefficients[13] = {
+    1.0, 1.0, 5.00000000000000000000e-01, 1.66666666666666666667e-01, 4.16666666666666666667e-02,
+    8.33333333333333333333e-03, 1.38888888888888888889e-03, 1.98412698412698412698e-04,
+    2.48015873015873015873e-05, 2.75573192239858906526e-06, 2.75573192239858906526e-07,
+    2.50521083854417187751e-08, 2.08767569878680989792e-09};
+
+double fastExp(double x) {
+    x = x < FAST_EXP_MIN ? FAST_EXP_MIN : (x > FAST_EXP_MAX ? FAST_EXP_MAX : x);
+    // Pembulatan ke integer terdekat lewat k + 1.5·2^52 (mode pembulatan default)
+    double shifted = x * FAST_EXP_LOG2E + FAST_EXP_ROUND_MAGIC;
+    double k = shifted - FAST_EXP_ROUND_MAGIC;
+    double r = x - k * FAST_EXP_LN2_HI;
+    r = r - k * FAST_EXP_LN2_LO;
+
+    // Skema Estrin: rantai dependensi 4 level, bukan 12 seperti Horner
+    const double *c = fast_exp_coefficients;
+    double r2 = r * r, r4 = r2 * r2, r8 = r4 * r4;
+    double s0 = (c[0] + c[1] * r) + (c[2] + c[3] * r) * r2;
+    double s1 = (c[4] + c[5] * r) + (c[6] + c[7] * r) * r2;
+    double s2 = (c[8] + c[9] * r) + (c[10] + c[11] * r) * r2;
+    double p = (s0 + s1 * r4) + (s2 + c[12] * r4) * r8;
+
+    // Bit rendah `shifted` berisi k; geser ke eksponen untuk mendapatkan 2^k
+    uint64_t bits;
+    memcpy(&bits, &shifted, sizeof(bits));
+    bits = (bits + 1023) << 52;
+    double scale;
+    memcpy(&scale, &bits, sizeof(scale));
+    return p * scale;
+}
+
+static void vectorExpScalar(double *values, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        values[i] = fastExp(values[i]);
+    }
+}
+
+#if MOMENTS_HAVE_X86
+__attribute__((target("avx2,fma"))) static void vectorExpAVX2(double *values, size_t n) {
+    const __m256d min_x = _mm256_set1_pd(FAST_EXP_MIN);
+    const __m256d max_x = _mm256_set1_pd(FAST_EXP_MAX);
+    const __m256d log2e = _mm256_set1_pd(FAST_EXP_LOG2E);
+    const __m256d ln2_hi = _mm256_set1_pd(FAST_EXP_LN2_HI);
+    const __m256d ln2_lo = _mm256_set1_pd(FAST_EXP_LN2_LO);
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d round_magic = _mm256_set1_pd(FAST_EXP_ROUND_MAGIC);
+    const __m256i bias = _mm256_set1_epi64x(1023);
+    __m256d c[13];
+    for (int j = 0; j < 13; j++) {
+        c[j] = _mm256_set1_pd(fast_exp_coefficients[j]);
+    }
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d x = _mm256_loadu_pd(values + i);
+        x = _mm256_min_pd(max_x, _mm256_max_pd(min_x, x)); // NaN di operand kedua diteruskan
+        __m256d k = _mm256_round_pd(_mm256_mul_pd(x, log2e), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        __m256d r = _mm256_fnmadd_pd(k, ln2_hi, x);
+        r = _mm256_fnmadd_pd(k, ln2_lo, r);
+
+        __m256d r2 = _mm256_mul_pd(r, r);
+        __m256d r4 = _mm256_mul_pd(r2, r2);
+        __m256d r8 = _mm256_mul_pd(r4, r4);
+        __m256d q0 = _mm256_fmadd_pd(r, one, one);
+        __m256d q1 = _mm256_fmadd_pd(r, c[3], c[2]);
+        __m256d q2 = _mm256_fmadd_pd(r, c[5], c[4]);
+        __m256d q3 = _mm256_fmadd_pd(r, c[7], c[6]);
+        __m256d q4 = _mm256_fmadd_pd(r, c[9], c[8]);
+        __m256d q5 = _mm256_fmadd_pd(r, c[11], c[10]);
+        __m256d s0 = _mm256_fmadd_pd(q1, r2, q0);
+        __m256d s1 = _mm256_fmadd_pd(q3, r2, q2);
+        __m256d s2 = _mm256_fmadd_pd(q5, r2, q4);
+        __m256d s3 = _mm256_fmadd_pd(c[12], r4, s2);
+        __m256d p = _mm256_fmadd_pd(s3, r8, _mm256_fmadd_pd(s1, r4, s0));
+
+        __m256i bits = _mm256_castpd_si256(_mm256_add_pd(k, round_magic));
+        __m256i scale = _mm256_slli_epi64(_mm256_add_epi64(bits, bias), 52);
+        _mm256_storeu_pd(values + i, _mm256_mul_pd(p, _mm256_castsi256_pd(scale)));
+    }
+    vectorExpScalar(values + i, n - i);
+}
+#endif
+
+// Kernel AVX-512 memakai jalur AVX2 (exp bukan bottleneck memori, lebar 4 sudah cukup)
+void vectorExpWith(MomentsKernel kernel, double *values, size_t n) {
+    // Deteksi CPU sekali; atomic karena bisa dipanggil dari banyak thread sekaligus
+    static MomentsKernel detected = MOMENTS_KERNEL_AUTO;
+    if (kernel == MOMENTS_KERNEL_AUTO) {
+        kernel = __atomic_load_n(&detected, __ATOMIC_RELAXED);
+        if (kernel == MOMENTS_KERNEL_AUTO) {
+            kernel = selectMomentsKernel();
+            __atomic_store_n(&detected, kernel, __ATOMIC_RELAXED);
+        }
+    }
+#if MOMENTS_HAVE_X86
+    if (kernel != MOMENTS_KERNEL_SCALAR && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        vectorExpAVX2(values, n);
+        return;
+    }
+#endif
+    vectorExpScalar(values, n);
+}
+
+// values[i] = exp(values[i]) untuk seluruh array (in-place)
+void vectorExp(double *values, size_t n) {
+    vectorExpWith(MOMENTS_KERNEL_AUTO, values, n);
+}
@@ -0,0 +1,27 @@
+#ifndef FAST_EXP_H
+#define FAST_EXP_H
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "moments.h"
+
+// exp untuk array double, dipakai di loop model nonlinear. x = k ln2 + r dengan |r| <= ln2/2
+// (reduksi Cody-Waite dua bagian), exp(r) dengan polinomial Taylor derajat 12 (skema Estrin), lalu dikali 2^k
+// lewat bit eksponen. Error relatif < 4 ulp pada [-708, 709]; input di luar itu dijepit
+// (hasil minimal ~3e-308, maksimal ~8e307). Input NaN menghasilkan NaN.
+
+#define FAST_EXP_MIN -708.0
+#define FAST_EXP_MAX 709.0
+#define FAST_EXP_LOG2E 1.4426950408889634
+#define FAST_EXP_LN2_HI 6.93147180369123816490e-01
+#define FAST_EXP_LN2_LO 1.90821492927058770002e-10
+#define FAST_EXP_ROUND_MAGIC 6755399441055744.0 // 1.5·2^52
+
+// Deklarasi fungsi
+double fastExp(double x);
+void vectorExp(double *values, size_t n);
+void vectorExpWith(MomentsKernel kernel, double *values, size_t n);
+
+#endif
@@ -0,0 +1,269 @@
+#include "gnuplot.h"
+
+#include <signal.h>
+
+// Selama menulis ke pipe, SIGPIPE diblokir hanya di thread pemanggil: jika gnuplot berhenti di tengah
+// jalan, tulis gagal dengan EPIPE dan sinyal yang tertunda dibuang, tanpa mengubah disposisi SIGPIPE proses
+typedef struct {
+    sigset_t old_mask;
+    int was_pending; // SIGPIPE sudah tertunda sebelum diblokir, jadi bukan milik kita
+} GnuplotSigpipeGuard;
+
+static void gnuplotBlockSigpipe(GnuplotSigpipeGuard *guard) {
+    sigset_t set, pending;
+    sigemptyset(&set);
+    sigaddset(&set, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &set, &guard->old_mask);
+    guard->was_pending = sigpending(&pending) == 0 && sigismember(&pending, SIGPIPE) == 1;
+}
+
+static void gnuplotRestoreSigpipe(const GnuplotSigpipeGuard *guard) {
+    if (!guard->was_pending) {
+        sigset_t set;
+        sigemptyset(&set);
+        sigaddset(&set, SIGPIPE);
+        const struct timespec zero = {0, 0};
+        sigtimedwait(&set, NULL, &zero); // Signal standar tidak diantrekan, paling banyak satu
+    }
+    pthread_sigmask(SIG_SETMASK, &guard->old_mask, NULL);
+}
+
+// Jalankan gnuplot sekali. Return CF_ERROR_EXTERNAL jika gnuplot tidak tersedia.
+CFStatus gnuplotSessionOpen(GnuplotSession *session) {
+    memset(session, 0, sizeof(*session));
+    double span = metricsSpanBegin();
+    // Cek dulu supaya tidak menulis ke pipe milik shell yang gagal menjalankan gnuplot
+    if (system("command -v gnuplot > /dev/null 2>&1") != 0) {
+        metricsSpanEnd(METRIC_SPAN_GNUPLOT_SPAWN, span);
+        return CF_ERROR_EXTERNAL;
+    }
+    session->pipe = popen("gnuplot", "w");
+    metricsSpanEnd(METRIC_SPAN_GNUPLOT_SPAWN, span);
+    return session->pipe ? CF_OK : CF_ERROR_EXTERNAL;
+}
+
+// String gnuplot dalam kutip tunggal: kutip tunggal ditulis ganda
+static void gnuplotQuoted(FILE *out, const char *text) {
+    fputc('\'', out);
+    for (const char *p = text; *p; p++) {
+        if (*p == '\'') {
+            fputc('\'', out);
+        }
+        if (*p != '\n') {
+            fputc(*p, out);
+        }
+    }
+    fputc('\'', out);
+}
+
+// Blok heredoc "x y" per baris; titik NaN dilewati. Angka diformat ke buffer lalu ditulis per blok.
+static int gnuplotWriteBlock(GnuplotSession *session, const char *name, const double *x, const double *y,
+                             size_t stride, size_t n) {
+    const size_t block = 4096;
+    if (!session->buffer) {
+        session->capacity = block * 2 * PREDICT_MAX_FIELD;
+        session->buffer = (char *)malloc(session->capacity);
+        if (!session->buffer) {
+            return -1;
+        }
+    }
+    fprintf(session->pipe, "%s << EOD\n", name);
+    for (size_t start = 0; start < n; start += block) {
+        size_t end = start + block < n ? start + block : n;
+        char *p = session->buffer;
+        for (size_t i = start; i < end; i++) {
+            double xv = x[i * stride], yv = y[i * stride];
+            if (!isfinite(xv) || !isfinite(yv)) {
+                continue;
+            }
+            p += formatDouble(xv, 10, p);
+            *p++ = ' ';
+            p += formatDouble(yv, 10, p);
+            *p++ = '\n';
+        }
+        size_t length = (size_t)(p - session->buffer);
+        if (fwrite(session->buffer, 1, length, session->pipe) != length) {
+            return -1;
+        }
+    }
+    fputs("EOD\n", session->pipe);
+    return 0;
+}
+
+// Tulis perintah satu plot ke pipe sesi lalu flush
+static CFStatus gnuplotSendPlot(GnuplotSession *session, const char *path, const double *x, const double *y,
+                                size_t stride, size_t n, const RegressionResult *result, const PlotOptions *options) {
+    PlotOptions defaults;
+    if (!options) {
+        defaultPlotOptions(&defaults);
+        options = &defaults;
+    }
+    FILE *out = session->pipe;
+
+    // Layout renderer bawaan dipakai sebagai grid piksel untuk ringkasan data dan sampel kurva
+    CompiledModel model;
+    int has_model = result && compileModel(result, &model) == 0;
+    double *curve = (double *)malloc(2 * PLOT_MAX_CURVE_SAMPLES * sizeof(double));
+    if (!curve) {
+        return CF_ERROR_MEMORY;
+    }
+    double *cx = curve, *cy = curve + PLOT_MAX_CURVE_SAMPLES;
+    PlotLayout layout;
+    size_t num_samples = 0;
+    int has_layout = options->width > PLOT_MARGIN_LEFT + PLOT_MARGIN_RIGHT &&
+                     options->height > PLOT_MARGIN_TOP + PLOT_MARGIN_BOTTOM &&
+                     plotComputeLayout(&layout, options, x, y, stride, n, has_model ? &model : NULL, cx, cy,
+                                       &num_samples) == 0;
+    has_model = has_model && has_layout;
+    double *lod = NULL;
+    size_t lod_count;
+    if (has_layout && n >= PLOT_LOD_MIN_POINTS &&
+        plotDownsample(&layout, PLOT_POINT_RADIUS, x, y, stride, n, threadPoolShared(), &lod, &lod_count) == 0) {
+        x = lod;
+        y = lod + 1;
+        stride = 2;
+        n = lod_count;
+    }
+    int status = gnuplotWriteBlock(session, "$DATA", x, y, stride, n);
+    if (status == 0 && has_model) {
+        status = gnuplotWriteBlock(session, "$MODEL", cx, cy, 1, num_samples);
+    }
+    free(lod);
+    free(curve);
+    if (status != 0) {
+        return CF_ERROR_EXTERNAL;
+    }
+    char model_label[160];
+    if (has_model) {
+        plotModelLabel(result, model_label, sizeof(model_label));
+    }
+
+    if (plotFormatFromPath(path) == PLOT_FORMAT_SVG) {
+        fprintf(out, "set terminal svg size %d,%d enhanced font 'Arial,12'\n", options->width, options->height);
+    } else {
+        fprintf(out, "set terminal png size %d,%d enhanced font 'Arial,12'\n", options->width, options->height);
+    }
+    fputs("set output ", out);
+    gnuplotQuoted(out, path);
+    fputs("\nset title ", out);
+    gnuplotQuoted(out, options->title);
+    fputs("\nset xlabel ", out);
+    gnuplotQuoted(out, options->x_label);
+    fputs("\nset ylabel ", out);
+    gnuplotQuoted(out, options->y_label);
+    fputs("\nset grid\nset key left top\nunset label\n", out);
+    if (has_model) {
+        // Label dipasang sebelum plot, jadi cukup render sekali
+        fprintf(out, "set label 1 'R² = %.4f' at graph 0.02, 0.85 font 'Arial,10'\n", result->r_squared);
+    }
+    fputs("plot $DATA using 1:2 title 'Data Points' with points pointtype 7 pointsize 1.5", out);
+    if (has_model) {
+        fputs(", $MODEL using 1:2 title ", out);
+        gnuplotQuoted(out, model_label);
+        fputs(" with lines linewidth 2", out);
+    }
+    // "set output" menutup file output sehingga langsung lengkap di disk
+    fputs("\nset output\nundefine $DATA $MODEL\n", out);
+    session->plots++;
+    return fflush(out) == 0 && !ferror(out) ? CF_OK : CF_ERROR_EXTERNAL;
+}
+
+// Kirim satu plot ke path (format dari ekstensi: .svg atau PNG). result boleh NULL untuk
+// scatter saja. Return CF_OK jika perintah terkirim, CF_ERROR_EXTERNAL jika pipe gagal. Error dari
+// gnuplot sendiri tampil di stderr-nya.
+CFStatus gnuplotSessionPlot(GnuplotSession *session, const char *path, const double *x, const double *y,
+                            size_t stride, size_t n, const RegressionResult *result, const PlotOptions *options) {
+    double span = metricsSpanBegin();
+    GnuplotSigpipeGuard guard;
+    gnuplotBlockSigpipe(&guard);
+    CFStatus status = gnuplotSendPlot(session, path, x, y, stride, n, result, options);
+    gnuplotRestoreSigpipe(&guard);
+    metricsSpanEnd(METRIC_SPAN_GNUPLOT_PLOT, span);
+    metricsAdd(METRIC_PLOTS, status == CF_OK);
+    return status;
+}
+
+// Tutup pipe dan tunggu gnuplot selesai merender. Return CF_OK jika gnuplot keluar normal.
+CFStatus gnuplotSessionClose(GnuplotSession *session) {
+    CFStatus status = CF_OK;
+    if (session->pipe) {
+        double span = metricsSpanBegin();
+        GnuplotSigpipeGuard guard;
+        gnuplotBlockSigpipe(&guard);
+        fputs("exit\n", session->pipe);
+        status = pclose(session->pipe) == 0 ? CF_OK : CF_ERROR_EXTERNAL;
+        gnuplotRestoreSigpipe(&guard);
+        metricsSpanEnd(METRIC_SPAN_GNUPLOT_WAIT, span);
+    }
+    free(session->buffer);
+    memset(session, 0, sizeof(*session));
+    return status;
+}
+
+// Satu plot lewat GNUPlot (satu sesi untuk satu plot). Return CF_OK jika berhasil.
+CFStatus gnuplotPlot(const char *path, const double *x, const double *y, size_t stride, size_t n,
+                     const RegressionResult *result, const PlotOptions *options) {
+    GnuplotSession session;
+    CFStatus status = gnuplotSessionOpen(&session);
+    if (status != CF_OK) {
+        return status;
+    }
+    status = gnuplotSessionPlot(&session, path, x, y, stride, n, result, options);
+    CFStatus close_status = gnuplotSessionClose(&session);
+    return status != CF_OK ? status : close_status;
+}
+
+typedef struct {
+    const Dataset *ds;
+    const BatchFitEntry *entries;
+    int num_entries;
+    int num_groups;
+    const char *directory;
+    CFStatus status; // Status grup terakhir yang gagal
+} GnuplotBatchJob;
+
+// Satu grup hasil batch berurutan, satu proses gnuplot per grup
+static void gnuplotBatchWork(void *arg, size_t group) {
+    GnuplotBatchJob *job = (GnuplotBatchJob *)arg;
+    int begin = (int)((long)job->num_entries * group / job->num_groups);
+    int end = (int)((long)job->num_entries * (group + 1) / job->num_groups);
+    GnuplotSession session;
+    CFStatus status = gnuplotSessionOpen(&session);
+    if (status != CF_OK) {
+        __atomic_store_n(&job->status, status, __ATOMIC_RELAXED);
+        return;
+    }
+    for (int i = begin; i < end && status == CF_OK; i++) {
+        const BatchFitEntry *entry = &job->entries[i];
+        const Dataset *ds = job->ds;
+        char path[1024], title[160];
+        PlotOptions options;
+        plotBatchEntryOptions(ds, entry, job->directory, path, sizeof(path), title, &options);
+        const RegressionResult *result = isnan(entry->result.r_squared) ? NULL : &entry->result;
+        status = gnuplotSessionPlot(&session, path, ds->values[entry->x_column], ds->values[entry->y_column], 1,
+                                    ds->num_rows, result, &options);
+    }
+    CFStatus close_status = gnuplotSessionClose(&session);
+    status = status != CF_OK ? status : close_status;
+    if (status != CF_OK) {
+        __atomic_store_n(&job->status, status, __ATOMIC_RELAXED);
+    }
+}
+
+// Seperti plotBatchFit, tetapi lewat GNUPlot: hasil dibagi ke num_threads grup dan setiap grup
+// memakai satu proses gnuplot yang hidup selama grup itu. Nama file sama dengan plotBatchFit.
+CFStatus gnuplotBatchFit(const Dataset *ds, const BatchFitEntry *entries, int num_entries, const char *directory,
+                         int num_threads) {
+    if (num_threads <= 0) {
+        num_threads = defaultThreadCount();
+    }
+    int num_groups = num_threads < num_entries ? num_threads : num_entries;
+    if (num_groups <= 0) {
+        return CF_OK;
+    }
+    ThreadPool *pool = num_groups > 1 ? threadPoolCreate(num_groups) : NULL;
+    GnuplotBatchJob job = {ds, entries, num_entries, num_groups, directory, CF_OK};
+    threadPoolParallelFor(pool, (size_t)num_groups, gnuplotBatchWork, &job);
+    threadPoolDestroy(pool);
+    return job.status;
+}
@@ -0,0 +1,28 @@
+#ifndef GNUPLOT_H
+#define GNUPLOT_H
+
+#include "plot.h"
+
+// Backend GNUPlot opsional. Satu proses gnuplot dipakai untuk banyak plot: data dikirim
+// inline lewat pipe sebagai blok heredoc ($DATA/$MODEL, gnuplot >= 5.0), setiap plot
+// dirender sekali ke path output miliknya sendiri, tanpa file sementara dan tanpa replot.
+// Data besar diringkas (plotDownsample) dan kurva disampel adaptif seperti renderer bawaan.
+
+typedef struct {
+    FILE *pipe;
+    int plots; // Jumlah plot yang sudah dikirim
+    char *buffer; // Buffer format angka untuk blok data
+    size_t capacity;
+} GnuplotSession;
+
+// Deklarasi fungsi
+CFStatus gnuplotSessionOpen(GnuplotSession *session);
+CFStatus gnuplotSessionPlot(GnuplotSession *session, const char *path, const double *x, const double *y,
+                            size_t stride, size_t n, const RegressionResult *result, const PlotOptions *options);
+CFStatus gnuplotSessionClose(GnuplotSession *session);
+CFStatus gnuplotPlot(const char *path, const double *x, const double *y, size_t stride, size_t n,
+                     const RegressionResult *result, const PlotOptions *options);
+CFStatus gnuplotBatchFit(const Dataset *ds, const BatchFitEntry *entries, int num_entries, const char *directory,
+                         int num_threads);
+
+#endif
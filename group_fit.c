@@ -0,0 +1,515 @@
+#include "group_fit.h"
+
+// Satu grup di satu potongan file. Di tabel global hanya key, jumlah titik, rentang x dan
+// y_shift akumulator yang dipakai.
+typedef struct {
+    const char *key; // Menunjuk ke file yang dipetakan, tanpa salinan
+    size_t key_length;
+    uint64_t hash;
+    size_t group;    // Indeks grup global, diisi saat tabel potongan digabung
+    size_t count;
+    double min_x;
+    double max_x;
+    PolyAccumulator acc; // Basis lokal: shift = x pertama grup di potongan ini
+    DataPoint batch[GROUP_BATCH];
+    int batch_count;
+    DataPoint *points;   // Hanya logistic: semua titik grup di potongan ini, urut baris
+    size_t capacity;
+} GroupSlot;
+
+// Tabel hash open addressing (linear probing) berisi indeks ke slots; slots urut kemunculan pertama
+typedef struct {
+    GroupSlot *slots;
+    size_t num_slots;
+    size_t slot_capacity;
+    int *table; // -1 = kosong
+    size_t table_capacity;
+} GroupTable;
+
+typedef struct {
+    const char *begin;
+    const char *end;
+    GroupTable table;
+    size_t rows;
+    size_t skipped;
+    int status;
+} GroupChunk;
+
+typedef struct {
+    GroupChunk *chunks;
+    size_t num_chunks;
+    int key_column;
+    int x_column;
+    int y_column;
+    RegressionType type;
+    int degree;
+    GroupTable global;
+    int *chunk_slot; // chunk_slot[chunk * num_groups + group], -1 jika grup tidak ada di potongan itu
+    GroupFitEntry *entries;
+    int status;
+} GroupJob;
+
+// FNV-1a 64-bit
+static inline uint64_t groupHash(const char *key, size_t length) {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)key[i];
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+static int groupTableInit(GroupTable *t) {
+    memset(t, 0, sizeof(*t));
+    t->table = (int *)malloc(GROUP_TABLE_MIN_CAPACITY * sizeof(int));
+    if (!t->table) {
+        return -1;
+    }
+    memset(t->table, 0xFF, GROUP_TABLE_MIN_CAPACITY * sizeof(int));
+    t->table_capacity = GROUP_TABLE_MIN_CAPACITY;
+    return 0;
+}
+
+static void groupTableFree(GroupTable *t) {
+    for (size_t i = 0; i < t->num_slots; i++) {
+        free(t->slots[i].points);
+    }
+    free(t->slots);
+    free(t->table);
+    memset(t, 0, sizeof(*t));
+}
+
+// Gandakan tabel dan sisipkan ulang semua slot memakai hash yang tersimpan
+static int groupTableGrow(GroupTable *t) {
+    size_t capacity = t->table_capacity * 2;
+    int *table = (int *)malloc(capacity * sizeof(int));
+    if (!table) {
+        return -1;
+    }
+    memset(table, 0xFF, capacity * sizeof(int));
+    for (size_t s = 0; s < t->num_slots; s++) {
+        size_t i = t->slots[s].hash & (capacity - 1);
+        while (table[i] >= 0) {
+            i = (i + 1) & (capacity - 1);
+        }
+        table[i] = (int)s;
+    }
+    free(t->table);
+    t->table = table;
+    t->table_capacity = capacity;
+    return 0;
+}
+
+// Cari slot untuk key, buat slot kosong (count 0) jika belum ada. Return NULL jika alokasi gagal.
+static GroupSlot *groupTableFind(GroupTable *t, const char *key, size_t length, uint64_t hash) {
+    if (2 * (t->num_slots + 1) > t->table_capacity && groupTableGrow(t) != 0) {
+        return NULL;
+    }
+    size_t mask = t->table_capacity - 1;
+    size_t i = hash & mask;
+    for (; t->table[i] >= 0; i = (i + 1) & mask) {
+        GroupSlot *slot = &t->slots[t->table[i]];
+        if (slot->hash == hash && slot->key_length == length && memcmp(slot->key, key, length) == 0) {
+            return slot;
+        }
+    }
+
+    if (t->num_slots == t->slot_capacity) {
+        size_t capacity = t->slot_capacity ? 2 * t->slot_capacity : 16;
+        GroupSlot *grown = (GroupSlot *)realloc(t->slots, capacity * sizeof(GroupSlot));
+        if (!grown) {
+            return NULL;
+        }
+        t->slots = grown;
+        t->slot_capacity = capacity;
+    }
+    GroupSlot *slot = &t->slots[t->num_slots];
+    memset(slot, 0, offsetof(GroupSlot, batch));
+    slot->key = key;
+    slot->key_length = length;
+    slot->hash = hash;
+    slot->batch_count = 0;
+    slot->points = NULL;
+    slot->capacity = 0;
+    t->table[i] = (int)t->num_slots++;
+    return slot;
+}
+
+static void groupSlotFlush(GroupSlot *slot) {
+    polyAccumulatorAdd(&slot->acc, &slot->batch[0].x, &slot->batch[0].y, 2, (size_t)slot->batch_count);
+    slot->batch_count = 0;
+}
+
+// Tambah satu titik. Akumulator memakai basis lokal (x pertama, skala |x|) yang nanti dipindahkan
+// ke basis rentang x grup dengan polyAccumulatorRebase. Return -1 jika alokasi gagal.
+static int groupSlotAdd(GroupSlot *slot, const GroupJob *job, double x, double y) {
+    if (slot->count == 0) {
+        slot->min_x = slot->max_x = x;
+        polyAccumulatorInit(&slot->acc, job->type == REGRESSION_POLYNOMIAL ? job->degree : 1, x,
+                            fabs(x) > 1 ? fabs(x) : 1.0, y);
+    }
+    slot->min_x = x < slot->min_x ? x : slot->min_x;
+    slot->max_x = x > slot->max_x ? x : slot->max_x;
+    slot->count++;
+
+    if (job->type == REGRESSION_LOGISTIC) {
+        if (slot->count > slot->capacity) {
+            size_t capacity = slot->capacity ? 2 * slot->capacity : 64;
+            DataPoint *grown = (DataPoint *)realloc(slot->points, capacity * sizeof(DataPoint));
+            if (!grown) {
+                return -1;
+            }
+            slot->points = grown;
+            slot->capacity = capacity;
+        }
+        slot->points[slot->count - 1].x = x;
+        slot->points[slot->count - 1].y = y;
+        return 0;
+    }
+    slot->batch[slot->batch_count].x = x;
+    slot->batch[slot->batch_count].y = y;
+    if (++slot->batch_count == GROUP_BATCH) {
+        groupSlotFlush(slot);
+    }
+    return 0;
+}
+
+// Ambil field kunci (apa adanya) dan x, y numerik dari satu baris
+static int groupParseLine(const char *line, const char *line_end, const GroupJob *job, const char **key,
+                          size_t *key_length, double *x, double *y) {
+    int last_column = job->key_column > job->x_column ? job->key_column : job->x_column;
+    last_column = job->y_column > last_column ? job->y_column : last_column;
+    int found = 0;
+    const char *field = line;
+    for (int col = 0; col <= last_column; col++) {
+        const char *comma = (const char *)memchr(field, ',', (size_t)(line_end - field));
+        const char *field_end = comma ? comma : line_end;
+        if (col == job->key_column) {
+            *key = field;
+            *key_length = (size_t)(field_end - field);
+            found |= 1;
+        }
+        if (col == job->x_column && parseDoubleField(field, field_end, x)) {
+            found |= 2;
+        }
+        if (col == job->y_column && parseDoubleField(field, field_end, y)) {
+            found |= 4;
+        }
+        if (!comma) {
+            break;
+        }
+        field = comma + 1;
+    }
+    return found == 7;
+}
+
+static void groupParseChunk(void *arg, size_t index) {
+    GroupJob *job = (GroupJob *)arg;
+    GroupChunk *chunk = &job->chunks[index];
+    if (groupTableInit(&chunk->table) != 0) {
+        chunk->status = -1;
+        return;
+    }
+
+    const char *p = chunk->begin;
+    while (p < chunk->end) {
+        const char *newline = (const char *)memchr(p, '\n', (size_t)(chunk->end - p));
+        const char *line_end = newline ? newline : chunk->end;
+        const char *next = newline ? newline + 1 : chunk->end;
+        if (line_end > p && line_end[-1] == '\r') {
+            line_end--;
+        }
+        if (line_end == p) {
+            p = next;
+            continue;
+        }
+
+        const char *key = NULL;
+        size_t key_length = 0;
+        double x, y;
+        if (!groupParseLine(p, line_end, job, &key, &key_length, &x, &y)) {
+            chunk->skipped++;
+        } else {
+            GroupSlot *slot = groupTableFind(&chunk->table, key, key_length, groupHash(key, key_length));
+            if (!slot || groupSlotAdd(slot, job, x, y) != 0) {
+                chunk->status = -1;
+                return;
+            }
+            chunk->rows++;
+        }
+        p = next;
+    }
+    for (size_t s = 0; s < chunk->table.num_slots; s++) {
+        if (chunk->table.slots[s].batch_count) {
+            groupSlotFlush(&chunk->table.slots[s]);
+        }
+    }
+}
+
+static void groupFitWork(void *arg, size_t g) {
+    GroupJob *job = (GroupJob *)arg;
+    const GroupSlot *info = &job->global.slots[g];
+    GroupFitEntry *e = &job->entries[g];
+    size_t num_groups = job->global.num_slots;
+    e->num_points = info->count;
+    e->min_x = info->min_x;
+    e->max_x = info->max_x;
+    e->key = (char *)malloc(info->key_length + 1);
+    if (e->key) {
+        memcpy(e->key, info->key, info->key_length);
+        e->key[info->key_length] = '\0';
+    }
+
+    if (job->type == REGRESSION_LOGISTIC && info->count < 3) {
+        // Terlalu sedikit titik untuk 3 parameter
+        e->result.type = REGRESSION_LOGISTIC;
+        e->result.a = e->result.b = e->result.c = e->result.r_squared = NAN;
+        return;
+    }
+    if (job->type == REGRESSION_LOGISTIC) {
+        // Titik disambung sesuai urutan potongan, jadi sama dengan urutan baris di file
+        DataPoint *points = (DataPoint *)malloc(info->count * sizeof(DataPoint));
+        if (!points || !e->key) {
+            __atomic_store_n(&job->status, CF_ERROR_MEMORY, __ATOMIC_RELAXED);
+            free(points);
+            return;
+        }
+        size_t offset = 0;
+        for (size_t c = 0; c < job->num_chunks; c++) {
+            int s = job->chunk_slot[c * num_groups + g];
+            if (s >= 0) {
+                const GroupSlot *slot = &job->chunks[c].table.slots[s];
+                memcpy(points + offset, slot->points, slot->count * sizeof(DataPoint));
+                offset += slot->count;
+            }
+        }
+        e->result = logisticRegressionWorkspace(&points[0].x, &points[0].y, 2, (int)info->count, NULL, NULL, NULL);
+        e->result.degree = 0;
+        free(points);
+        return;
+    }
+
+    // Statistik per potongan dipindahkan ke basis rentang x grup ([-1, 1]) lalu digabung
+    int degree = job->type == REGRESSION_POLYNOMIAL ? job->degree : 1;
+    double shift = 0.5 * (info->min_x + info->max_x);
+    double scale = 0.5 * (info->max_x - info->min_x);
+    PolyAccumulator acc;
+    polyAccumulatorInit(&acc, degree, shift, scale > 0 ? scale : 1.0, info->acc.y_shift);
+    for (size_t c = 0; c < job->num_chunks; c++) {
+        int s = job->chunk_slot[c * num_groups + g];
+        if (s >= 0) {
+            PolyAccumulator part = job->chunks[c].table.slots[s].acc;
+            polyAccumulatorRebase(&part, acc.shift, acc.scale, acc.y_shift);
+            polyAccumulatorMerge(&acc, &part);
+        }
+    }
+    e->result = regressionFromAccumulator(&acc, job->type, degree);
+    if (!e->key || (job->type == REGRESSION_POLYNOMIAL && !e->result.coefficients)) {
+        __atomic_store_n(&job->status, CF_ERROR_MEMORY, __ATOMIC_RELAXED);
+    }
+}
+
+// Regresi per grup untuk file CSV format panjang (kolom kunci + x + y) dalam satu lintasan parse:
+// file dipetakan ke memori dan dibagi per newline; setiap potongan di-parse paralel ke tabel hash
+// lokal berisi statistik cukup per grup (linear/polynomial) atau titik per grup (logistic). Tabel
+// potongan digabung sesuai urutan, lalu semua grup di-fit paralel. Hasil urut menurut kemunculan
+// pertama kunci di file. Baris tanpa x/y numerik dilewati.
+CFStatus groupFitFile(const char *filename, int key_column, int x_column, int y_column, RegressionType type,
+                      int degree, ThreadPool *pool, GroupFitEntry **entries, size_t *num_groups,
+                      CSVLoadStats *stats) {
+    *entries = NULL;
+    *num_groups = 0;
+    if (key_column < 0 || x_column < 0 || y_column < 0 ||
+        (type == REGRESSION_POLYNOMIAL && (degree < 1 || degree > MAX_POLY_DEGREE))) {
+        return CF_ERROR_ARGUMENT;
+    }
+    double start = monotonicSeconds();
+    double span = metricsSpanBegin();
+    MappedFile mf;
+    if (mapFile(filename, &mf) != 0) {
+        return CF_ERROR_IO;
+    }
+
+    // Lewati header
+    const char *end = mf.data + mf.size;
+    const char *header_end = mf.size ? (const char *)memchr(mf.data, '\n', mf.size) : NULL;
+    const char *body = header_end ? header_end + 1 : end;
+
+    GroupJob job;
+    memset(&job, 0, sizeof(job));
+    job.key_column = key_column;
+    job.x_column = x_column;
+    job.y_column = y_column;
+    job.type = type;
+    job.degree = degree;
+    const char **bounds = (const char **)malloc((GROUP_MAX_CHUNKS + 1) * sizeof(const char *));
+    job.chunks = (GroupChunk *)calloc(GROUP_MAX_CHUNKS, sizeof(GroupChunk));
+    CFStatus status = bounds && job.chunks && groupTableInit(&job.global) == 0 ? CF_OK : CF_ERROR_MEMORY;
+    if (status == CF_OK) {
+        job.num_chunks = (size_t)partitionCSVBody(body, end, GROUP_MAX_CHUNKS, bounds);
+        for (size_t c = 0; c < job.num_chunks; c++) {
+            job.chunks[c].begin = bounds[c];
+            job.chunks[c].end = bounds[c + 1];
+        }
+        threadPoolParallelFor(pool, job.num_chunks, groupParseChunk, &job);
+    }
+
+    // Gabungkan tabel potongan sesuai urutan file
+    size_t rows = 0, skipped = 0;
+    for (size_t c = 0; c < job.num_chunks && status == CF_OK; c++) {
+        GroupTable *t = &job.chunks[c].table;
+        status = job.chunks[c].status == 0 ? CF_OK : CF_ERROR_MEMORY;
+        rows += job.chunks[c].rows;
+        skipped += job.chunks[c].skipped;
+        for (size_t s = 0; s < t->num_slots && status == CF_OK; s++) {
+            GroupSlot *slot = &t->slots[s];
+            GroupSlot *global = groupTableFind(&job.global, slot->key, slot->key_length, slot->hash);
+            if (!global) {
+                status = CF_ERROR_MEMORY;
+                break;
+            }
+            if (global->count == 0) {
+                global->min_x = slot->min_x;
+                global->max_x = slot->max_x;
+                global->acc.y_shift = slot->acc.y_shift;
+            }
+            global->min_x = slot->min_x < global->min_x ? slot->min_x : global->min_x;
+            global->max_x = slot->max_x > global->max_x ? slot->max_x : global->max_x;
+            global->count += slot->count;
+            slot->group = (size_t)(global - job.global.slots);
+        }
+    }
+    size_t groups = job.global.num_slots;
+    if (status == CF_OK && groups == 0) {
+        status = CF_ERROR_NO_DATA;
+    }
+
+    if (status == CF_OK) {
+        job.chunk_slot = (int *)malloc(job.num_chunks * groups * sizeof(int));
+        job.entries = (GroupFitEntry *)calloc(groups, sizeof(GroupFitEntry));
+        status = job.chunk_slot && job.entries ? CF_OK : CF_ERROR_MEMORY;
+    }
+    if (status == CF_OK) {
+        memset(job.chunk_slot, 0xFF, job.num_chunks * groups * sizeof(int));
+        for (size_t c = 0; c < job.num_chunks; c++) {
+            for (size_t s = 0; s < job.chunks[c].table.num_slots; s++) {
+                job.chunk_slot[c * groups + job.chunks[c].table.slots[s].group] = (int)s;
+            }
+        }
+        job.status = CF_OK;
+        threadPoolParallelFor(pool, groups, groupFitWork, &job);
+        status = (CFStatus)job.status;
+        if (type != REGRESSION_LOGISTIC) {
+            metricsAdd(METRIC_FITS, groups);
+        }
+    }
+
+    for (size_t c = 0; c < job.num_chunks; c++) {
+        groupTableFree(&job.chunks[c].table);
+    }
+    groupTableFree(&job.global);
+    free(job.chunks);
+    free(job.chunk_slot);
+    free(bounds);
+    size_t bytes_read = mf.size;
+    unmapFile(&mf);
+    if (status != CF_OK) {
+        freeGroupFit(job.entries, job.entries ? groups : 0);
+        return status;
+    }
+
+    *entries = job.entries;
+    *num_groups = groups;
+    metricsSpanEnd(METRIC_SPAN_GROUP_FIT, span);
+    metricsAdd(METRIC_ROWS_PARSED, rows);
+    metricsAdd(METRIC_BYTES_READ, bytes_read);
+    metricsAdd(METRIC_ROWS_SKIPPED, skipped);
+    if (stats) {
+        stats->bytes_read = bytes_read;
+        stats->rows = rows;
+        stats->rows_skipped = skipped;
+        stats->seconds = monotonicSeconds() - start;
+        stats->mb_per_sec = stats->seconds > 0 ? (double)bytes_read / (1024.0 * 1024.0) / stats->seconds : 0;
+        stats->rows_per_sec = stats->seconds > 0 ? (double)rows / stats->seconds : 0;
+    }
+    return CF_OK;
+}
+
+// Tabel CSV: satu baris per grup, kolom model sama dengan mode batch
+void writeGroupFitCSV(FILE *out, const char *key_name, const GroupFitEntry *entries, size_t num_groups) {
+    writeQuotedName(out, key_name, '"');
+    fprintf(out, ",model,degree,n,min_x,max_x,r_squared,slope,intercept,a,b,c,mean_x,coefficients\n");
+    for (size_t i = 0; i < num_groups; i++) {
+        const GroupFitEntry *e = &entries[i];
+        const RegressionResult *r = &e->result;
+        writeQuotedName(out, e->key, '"');
+        fprintf(out, ",%s,%d,%zu,%.10g,%.10g,%.10g,", regressionTypeName(r->type), r->degree, e->num_points, e->min_x,
+                e->max_x, r->r_squared);
+        if (r->type == REGRESSION_LINEAR) {
+            fprintf(out, "%.10g,%.10g,,,,,\n", r->slope, r->intercept);
+        } else if (r->type == REGRESSION_LOGISTIC) {
+            fprintf(out, ",,%.10g,%.10g,%.10g,%.10g,\n", r->a, r->b, r->c, r->mean_x);
+        } else {
+            fprintf(out, ",,,,,,");
+            for (int k = 0; r->coefficients && k <= r->degree; k++) {
+                fprintf(out, k ? ";%.10g" : "%.10g", r->coefficients[k]);
+            }
+            fputc('\n', out);
+        }
+    }
+}
+
+static void groupWriteNumber(FILE *out, double value) {
+    if (isfinite(value)) {
+        fprintf(out, "%.17g", value);
+    } else {
+        fprintf(out, "null");
+    }
+}
+
+// Array JSON dengan satu objek per grup
+void writeGroupFitJSON(FILE *out, const char *key_name, const GroupFitEntry *entries, size_t num_groups) {
+    fprintf(out, "[\n");
+    for (size_t i = 0; i < num_groups; i++) {
+        const GroupFitEntry *e = &entries[i];
+        const RegressionResult *r = &e->result;
+        fprintf(out, "  {");
+        writeQuotedName(out, key_name, '\\');
+        fprintf(out, ": ");
+        writeQuotedName(out, e->key, '\\');
+        fprintf(out, ", \"model\": \"%s\", \"degree\": %d, \"n\": %zu, \"r_squared\": ", regressionTypeName(r->type),
+                r->degree, e->num_points);
+        groupWriteNumber(out, r->r_squared);
+        fprintf(out, ", \"coefficients\": [");
+        if (r->type == REGRESSION_LINEAR) {
+            groupWriteNumber(out, r->intercept);
+            fprintf(out, ", ");
+            groupWriteNumber(out, r->slope);
+        } else if (r->type == REGRESSION_LOGISTIC) {
+            groupWriteNumber(out, r->a);
+            fprintf(out, ", ");
+            groupWriteNumber(out, r->b);
+            fprintf(out, ", ");
+            groupWriteNumber(out, r->c);
+            fprintf(out, ", ");
+            groupWriteNumber(out, r->mean_x);
+        } else {
+            for (int k = 0; r->coefficients && k <= r->degree; k++) {
+                if (k) {
+                    fprintf(out, ", ");
+                }
+                groupWriteNumber(out, r->coefficients[k]);
+            }
+        }
+        fprintf(out, "]}%s\n", i + 1 < num_groups ? "," : "");
+    }
+    fprintf(out, "]\n");
+}
+
+void freeGroupFit(GroupFitEntry *entries, size_t num_groups) {
+    for (size_t i = 0; entries && i < num_groups; i++) {
+        free(entries[i].key);
+        freeRegressionResult(&entries[i].result);
+    }
+    free(entries);
+}
@@ -0,0 +1,31 @@
+#ifndef GROUP_FIT_H
+#define GROUP_FIT_H
+
+#include "batch_fit.h"
+
+// Kapasitas awal tabel hash per potongan file (pangkat 2; tumbuh 2x saat terisi separuh)
+#define GROUP_TABLE_MIN_CAPACITY 64
+// Titik per grup yang ditampung dulu sebelum dilipat ke akumulator dengan polyAccumulatorAdd
+#define GROUP_BATCH 8
+// Jumlah potongan file (masing-masing dengan tabel hash sendiri) hanya bergantung pada ukuran file,
+// bukan jumlah thread, sehingga hasil identik untuk berapa pun jumlah thread
+#define GROUP_MAX_CHUNKS 16
+
+// Hasil satu grup (satu nilai kolom kunci), urut menurut kemunculan pertama di file
+typedef struct {
+    char *key;
+    size_t num_points;
+    double min_x;
+    double max_x;
+    RegressionResult result;
+} GroupFitEntry;
+
+// Deklarasi fungsi
+CFStatus groupFitFile(const char *filename, int key_column, int x_column, int y_column, RegressionType type,
+                      int degree, ThreadPool *pool, GroupFitEntry **entries, size_t *num_groups,
+                      CSVLoadStats *stats);
+void writeGroupFitCSV(FILE *out, const char *key_name, const GroupFitEntry *entries, size_t num_groups);
+void writeGroupFitJSON(FILE *out, const char *key_name, const GroupFitEntry *entries, size_t num_groups);
+void freeGroupFit(GroupFitEntry *entries, size_t num_groups);
+
+#endif
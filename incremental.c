@@ -0,0 +1,120 @@
+#include "incremental.h"
+
+void incrementalFitInit(IncrementalFit *fit, int x_column, int y_column, RegressionType type, int degree,
+                        uint64_t window_rows) {
+    memset(fit, 0, sizeof(*fit));
+    fit->x_column = x_column;
+    fit->y_column = y_column;
+    fit->type = type;
+    fit->degree = type == REGRESSION_LINEAR ? 1 : degree;
+    fit->window_rows = window_rows;
+}
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;
+} IncrementalHeader;
+
+// Return CF_ERROR_IO jika file tidak bisa dibuka, CF_ERROR_FORMAT jika bukan state yang valid
+CFStatus incrementalFitLoad(const char *path, IncrementalFit *fit) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return CF_ERROR_IO;
+    }
+    IncrementalHeader header;
+    int ok = fread(&header, sizeof(header), 1, file) == 1 && header.magic == INCREMENTAL_MAGIC &&
+             header.version == INCREMENTAL_VERSION && header.size == sizeof(IncrementalFit) &&
+             fread(fit, sizeof(*fit), 1, file) == 1;
+    fclose(file);
+    return ok ? CF_OK : CF_ERROR_FORMAT;
+}
+
+// Tulis ke file sementara lalu rename, supaya state lama tetap utuh jika proses terhenti
+CFStatus incrementalFitSave(const char *path, const IncrementalFit *fit) {
+    char tmp_path[1024];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+    FILE *file = fopen(tmp_path, "wb");
+    if (!file) {
+        return CF_ERROR_IO;
+    }
+    IncrementalHeader header = {INCREMENTAL_MAGIC, INCREMENTAL_VERSION, sizeof(IncrementalFit)};
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(fit, sizeof(*fit), 1, file) == 1;
+    ok = fclose(file) == 0 && ok;
+    if (!ok || rename(tmp_path, path) != 0) {
+        remove(tmp_path);
+        return CF_ERROR_IO;
+    }
+    return CF_OK;
+}
+
+static void incrementalRemoveBatch(void *ctx, const DataPoint *points, size_t count) {
+    polyAccumulatorRemove((PolyAccumulator *)ctx, &points[0].x, &points[0].y, 2, count);
+}
+
+// Baca baris data mulai dari byte `start` (maksimal max_rows, 0 = sampai akhir baris lengkap)
+static int incrementalScan(FILE *file, const IncrementalFit *fit, uint64_t start, uint64_t max_rows,
+                           StreamBatchFn fn, void *ctx, CSVLoadStats *stats, uint64_t *consumed) {
+    if (fseeko(file, (off_t)start, SEEK_SET) != 0) {
+        return -1;
+    }
+    StreamOptions options;
+    defaultStreamOptions(&options, fit->x_column, fit->y_column);
+    options.skip_header = start == 0;
+    options.complete_lines_only = 1;
+    options.max_rows = (size_t)max_rows;
+    return streamCSVPoints(file, &options, fn, ctx, stats, consumed);
+}
+
+// Tambahkan baris baru sejak update terakhir. Waktu sebanding dengan jumlah baris baru
+// (ditambah baris yang keluar dari jendela). Baris terakhir yang belum diakhiri newline
+// dibiarkan untuk update berikutnya. Jika file lebih pendek dari offset (dirotasi atau
+// ditulis ulang), state di-reset dan file di-fit dari awal. stats berisi baris baru saja.
+CFStatus incrementalFitUpdate(IncrementalFit *fit, const char *csv_path, CSVLoadStats *stats) {
+    FILE *file = fopen(csv_path, "rb");
+    if (!file) {
+        return CF_ERROR_IO;
+    }
+    struct stat st;
+    if (fstat(fileno(file), &st) == 0 && (uint64_t)st.st_size < fit->offset) {
+        incrementalFitInit(fit, fit->x_column, fit->y_column, fit->type, fit->degree, fit->window_rows);
+    }
+
+    uint64_t consumed;
+    StreamAccumulateCtx add_ctx = {&fit->acc, fit->degree};
+    int status = incrementalScan(file, fit, fit->offset, 0, streamAccumulateBatch, &add_ctx, stats, &consumed);
+    if (status == 0) {
+        fit->offset += consumed;
+    }
+
+    // Keluarkan baris tertua yang sudah di luar jendela
+    if (status == 0 && fit->window_rows && fit->acc.n > (double)fit->window_rows) {
+        uint64_t excess = (uint64_t)fit->acc.n - fit->window_rows;
+        status = incrementalScan(file, fit, fit->window_offset, excess, incrementalRemoveBatch, &fit->acc,
+                                 NULL, &consumed);
+        if (status == 0) {
+            fit->window_offset += consumed;
+            fit->removed_since_rebuild += excess;
+        }
+
+        if (status == 0 && fit->removed_since_rebuild >= INCREMENTAL_REBUILD_FACTOR * fit->window_rows) {
+            memset(&fit->acc, 0, sizeof(fit->acc));
+            status = incrementalScan(file, fit, fit->window_offset, fit->window_rows, streamAccumulateBatch,
+                                     &add_ctx, NULL, &consumed);
+            fit->removed_since_rebuild = 0;
+        }
+    }
+    fclose(file);
+    return status == 0 ? CF_OK : CF_ERROR_IO;
+}
+
+RegressionResult incrementalFitResult(const IncrementalFit *fit) {
+    if (fit->acc.n == 0) {
+        RegressionResult result;
+        memset(&result, 0, sizeof(result));
+        result.type = fit->type;
+        result.r_squared = NAN;
+        return result;
+    }
+    return regressionFromAccumulator(&fit->acc, fit->type, fit->degree);
+}
@@ -0,0 +1,40 @@
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include <stdint.h>
+#include <sys/stat.h>
+
+#include "streaming.h"
+
+// Penanda dan versi file state
+#define INCREMENTAL_MAGIC 0x54534643u // "CFST"
+#define INCREMENTAL_VERSION 1
+
+// Jendela geser dibangun ulang dari file setelah sekian kali ukuran jendela dikeluarkan,
+// supaya error pembulatan dari pengurangan tidak menumpuk dan skala x mengikuti data
+#define INCREMENTAL_REBUILD_FACTOR 16
+
+// State fit untuk file CSV append-only: statistik cukup dan posisi byte setelah baris
+// terakhir yang sudah dikonsumsi. Disimpan ke file sehingga run berikutnya hanya
+// membaca baris yang baru ditambahkan.
+typedef struct {
+    int x_column;
+    int y_column;
+    RegressionType type;           // REGRESSION_LINEAR atau REGRESSION_POLYNOMIAL
+    int degree;                    // 1 untuk linear
+    uint64_t window_rows;          // Jumlah baris terakhir yang dipakai (0 = seluruh riwayat)
+    uint64_t offset;               // Byte setelah baris terakhir yang dikonsumsi
+    uint64_t window_offset;        // Byte awal baris tertua di dalam jendela
+    uint64_t removed_since_rebuild;
+    PolyAccumulator acc;
+} IncrementalFit;
+
+// Deklarasi fungsi
+void incrementalFitInit(IncrementalFit *fit, int x_column, int y_column, RegressionType type, int degree,
+                        uint64_t window_rows);
+CFStatus incrementalFitLoad(const char *path, IncrementalFit *fit);
+CFStatus incrementalFitSave(const char *path, const IncrementalFit *fit);
+CFStatus incrementalFitUpdate(IncrementalFit *fit, const char *csv_path, CSVLoadStats *stats);
+RegressionResult incrementalFitResult(const IncrementalFit *fit);
+
+#endif
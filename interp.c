@@ -0,0 +1,133 @@
+#include "interp.h"
+
+static int interpComparePoints(const void *a, const void *b) {
+    double xa = ((const DataPoint *)a)->x;
+    double xb = ((const DataPoint *)b)->x;
+    return (xa > xb) - (xa < xb);
+}
+
+// Bangun indeks dari n titik (stride 1 untuk kolom, 2 untuk array DataPoint). Titik dengan
+// x atau y NaN dilewati. Return 0 jika berhasil, -1 jika tidak ada titik valid atau memori habis.
+int interpIndexBuild(InterpIndex *index, const double *x, const double *y, size_t stride, size_t n,
+                     ExtrapolationMode extrapolation) {
+    memset(index, 0, sizeof(*index));
+    index->extrapolation = extrapolation;
+
+    DataPoint *sorted = (DataPoint *)malloc((n ? n : 1) * sizeof(DataPoint));
+    if (!sorted) {
+        return -1;
+    }
+    size_t count = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (!isnan(x[i * stride]) && !isnan(y[i * stride])) {
+            sorted[count].x = x[i * stride];
+            sorted[count].y = y[i * stride];
+            count++;
+        }
+    }
+    if (count == 0) {
+        free(sorted);
+        return -1;
+    }
+    qsort(sorted, count, sizeof(DataPoint), interpComparePoints);
+
+    index->x = (double *)malloc(count * sizeof(double));
+    index->y = (double *)malloc(count * sizeof(double));
+    if (!index->x || !index->y) {
+        free(sorted);
+        interpIndexFree(index);
+        return -1;
+    }
+
+    // Gabungkan x duplikat (sudah bersebelahan setelah diurutkan)
+    size_t unique = 0;
+    for (size_t i = 0; i < count;) {
+        size_t j = i;
+        double sum_y = 0;
+        while (j < count && sorted[j].x == sorted[i].x) {
+            sum_y += sorted[j].y;
+            j++;
+        }
+        index->x[unique] = sorted[i].x;
+        index->y[unique] = sum_y / (double)(j - i);
+        unique++;
+        i = j;
+    }
+    index->n = unique;
+    free(sorted);
+    return 0;
+}
+
+void interpIndexFree(InterpIndex *index) {
+    free(index->x);
+    free(index->y);
+    index->x = NULL;
+    index->y = NULL;
+    index->n = 0;
+}
+
+// Indeks segmen i (0..n-2) dengan x[i] <= x < x[i+1], dijepit ke segmen pertama/terakhir
+// untuk x di luar rentang. Pencarian biner O(log N) tanpa cabang yang sulit ditebak.
+size_t interpIndexSegment(const InterpIndex *index, double x) {
+    if (index->n < 2) {
+        return 0;
+    }
+    const double *xs = index->x;
+    size_t lo = 0;
+    size_t len = index->n - 1;
+    while (len > 1) {
+        size_t half = len / 2;
+        lo = xs[lo + half] <= x ? lo + half : lo;
+        len -= half;
+    }
+    return lo;
+}
+
+// Nilai pada segmen `segment` (sudah dipilih), termasuk aturan ekstrapolasi
+static inline double interpLinearAt(const InterpIndex *index, size_t segment, double x) {
+    size_t last = index->n - 1;
+    if (index->n == 1 || !(x >= index->x[0] && x <= index->x[last])) {
+        if (isnan(x) || index->extrapolation == EXTRAPOLATE_NAN) {
+            return NAN;
+        }
+        if (index->n == 1 || index->extrapolation == EXTRAPOLATE_CLAMP) {
+            return x < index->x[0] ? index->y[0] : index->y[last];
+        }
+    }
+    double x0 = index->x[segment], x1 = index->x[segment + 1];
+    double y0 = index->y[segment], y1 = index->y[segment + 1];
+    return y0 + (y1 - y0) * (x - x0) / (x1 - x0);
+}
+
+// Interpolasi linear untuk satu query, O(log N)
+double interpIndexLinear(const InterpIndex *index, double x) {
+    return interpLinearAt(index, interpIndexSegment(index, x), x);
+}
+
+// Interpolasi linear untuk banyak query. Jika query sudah urut naik, segmen dicari dengan
+// sapuan maju seperti merge (O(N + Q)); jika tidak, setiap query memakai pencarian biner.
+void interpIndexLinearBatch(const InterpIndex *index, const double *queries, double *out, size_t num_queries) {
+    if (index->n < 2 || !interpQueriesSorted(queries, num_queries)) {
+        for (size_t i = 0; i < num_queries; i++) {
+            out[i] = interpIndexLinear(index, queries[i]);
+        }
+        return;
+    }
+
+    size_t segment = 0;
+    for (size_t i = 0; i < num_queries; i++) {
+        segment = interpSweepSegment(index, segment, queries[i]);
+        out[i] = interpLinearAt(index, segment, queries[i]);
+    }
+}
+
+// "clamp", "linear" atau "nan"; nama lain dianggap clamp
+ExtrapolationMode parseExtrapolationMode(const char *name) {
+    if (strcmp(name, "linear") == 0) {
+        return EXTRAPOLATE_LINEAR;
+    }
+    if (strcmp(name, "nan") == 0) {
+        return EXTRAPOLATE_NAN;
+    }
+    return EXTRAPOLATE_CLAMP;
+}
@@ -0,0 +1,51 @@
+#ifndef INTERP_H
+#define INTERP_H
+
+#include "curve_fitting.h"
+
+// Perilaku untuk query di luar rentang x data
+typedef enum {
+    EXTRAPOLATE_CLAMP,  // Pakai nilai y di ujung terdekat
+    EXTRAPOLATE_LINEAR, // Lanjutkan segmen ujung
+    EXTRAPOLATE_NAN     // Kembalikan NaN
+} ExtrapolationMode;
+
+// Indeks interpolasi: salinan data yang sudah diurutkan menurut x, dibangun sekali lalu
+// dipakai untuk banyak query. Titik dengan x yang sama digabung menjadi satu titik
+// dengan y rata-rata, sehingga x selalu naik tegas.
+typedef struct {
+    size_t n;
+    double *x;
+    double *y;
+    ExtrapolationMode extrapolation;
+} InterpIndex;
+
+// Deklarasi fungsi
+int interpIndexBuild(InterpIndex *index, const double *x, const double *y, size_t stride, size_t n,
+                     ExtrapolationMode extrapolation);
+void interpIndexFree(InterpIndex *index);
+size_t interpIndexSegment(const InterpIndex *index, double x);
+double interpIndexLinear(const InterpIndex *index, double x);
+void interpIndexLinearBatch(const InterpIndex *index, const double *queries, double *out, size_t num_queries);
+ExtrapolationMode parseExtrapolationMode(const char *name);
+
+// 1 jika query urut naik (syarat sapuan maju). NaN membuat hasilnya 0. Dipakai juga oleh spline.
+static inline int interpQueriesSorted(const double *queries, size_t num_queries) {
+    for (size_t i = 1; i < num_queries; i++) {
+        if (!(queries[i - 1] <= queries[i])) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Langkah sapuan maju: geser segmen sampai x[segment + 1] > x (atau segmen terakhir)
+static inline size_t interpSweepSegment(const InterpIndex *index, size_t segment, double x) {
+    size_t last_segment = index->n - 2;
+    while (segment < last_segment && index->x[segment + 1] <= x) {
+        segment++;
+    }
+    return segment;
+}
+
+#endif
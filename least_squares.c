@@ -0,0 +1,398 @@
+#include "least_squares.h"
+
+#define LSQ_MAX_DIM (LSQ_MAX_TERMS + 1) // Suku + kolom y
+
+typedef struct {
+    const double *const *x;
+    const int *degrees;
+    int num_x;
+    int dim; // Kolom matriks augmented [1 T y]
+    size_t stride;
+    const double *y;
+    const double *weights;
+    size_t n;
+    size_t chunk_rows;
+    double shift[MAX_COLUMNS];
+    double inv_scale[MAX_COLUMNS];
+    double y_shift;
+} LSQProblem;
+
+typedef struct {
+    double gram[LSQ_MAX_DIM * LSQ_MAX_DIM]; // Segitiga atas
+    size_t count;
+} LSQChunk;
+
+typedef struct {
+    const LSQProblem *problem;
+    LSQChunk *chunks;
+} LSQJob;
+
+// Isi satu baris augmented (bobot belum dikalikan). Return 0 jika ada nilai tidak valid.
+static inline int lsqRow(const LSQProblem *p, size_t i, double *row, double *weight) {
+    double w = p->weights ? p->weights[i * p->stride] : 1.0;
+    double yv = p->y[i * p->stride];
+    if (!(w >= 0) || !isfinite(w) || !isfinite(yv)) {
+        return 0;
+    }
+    int k = 0;
+    row[k++] = 1.0;
+    for (int j = 0; j < p->num_x; j++) {
+        double v = p->x[j][i * p->stride];
+        if (!isfinite(v)) {
+            return 0;
+        }
+        double t = (v - p->shift[j]) * p->inv_scale[j];
+        double power = t;
+        for (int d = 0; d < p->degrees[j]; d++) {
+            row[k++] = power;
+            power *= t;
+        }
+    }
+    row[k] = yv - p->y_shift;
+    *weight = w;
+    return 1;
+}
+
+// Isi tile kolom-mayor untuk baris [begin, begin + rows): kolom 0 berisi 1, lalu suku dan y. Bobot baris
+// yang tidak valid dibuat 0 dan nilainya diganti 0, sehingga tidak ada cabang di kernel Gram.
+// Return jumlah baris valid.
+static size_t lsqFillTile(const LSQProblem *p, size_t begin, size_t rows, double *z, double *w) {
+    size_t stride = p->stride;
+    unsigned char ok_row[LSQ_TILE_ROWS];
+    double *ycol = z + (size_t)(p->dim - 1) * LSQ_TILE_ROWS;
+    for (size_t k = 0; k < rows; k++) {
+        double wv = p->weights ? p->weights[(begin + k) * stride] : 1.0;
+        double yv = p->y[(begin + k) * stride];
+        int ok = wv >= 0 && isfinite(wv) && isfinite(yv);
+        ok_row[k] = (unsigned char)ok;
+        w[k] = ok ? wv : 0.0;
+        ycol[k] = ok ? yv - p->y_shift : 0.0;
+        z[k] = 1.0;
+    }
+    size_t first = 1; // Kolom 0 adalah intersep
+    for (int j = 0; j < p->num_x; j++) {
+        const double *x = p->x[j] + begin * stride;
+        double shift = p->shift[j], inv_scale = p->inv_scale[j];
+        double *tile = z + first * LSQ_TILE_ROWS; // Pangkat 1..degrees[j] dari x ini, berurutan
+        for (size_t k = 0; k < rows; k++) {
+            double v = x[k * stride];
+            int ok = isfinite(v);
+            ok_row[k] &= (unsigned char)ok;
+            w[k] = ok ? w[k] : 0.0;
+            tile[k] = ok ? (v - shift) * inv_scale : 0.0;
+        }
+        // Pangkat d + 1 = pangkat d * pangkat 1, tanpa pow
+        for (int d = 1; d < p->degrees[j]; d++) {
+            const double *power = tile + (size_t)(d - 1) * LSQ_TILE_ROWS;
+            double *next = tile + (size_t)d * LSQ_TILE_ROWS;
+            for (size_t k = 0; k < rows; k++) {
+                next[k] = power[k] * tile[k];
+            }
+        }
+        first += (size_t)p->degrees[j];
+    }
+    size_t valid = 0;
+    for (size_t k = 0; k < rows; k++) {
+        valid += ok_row[k];
+    }
+    return valid;
+}
+
+// Gram satu tile: G[a][b] += Σ_k w_k z_a z_b untuk b >= a. Empat kolom b sekaligus: setiap w_k z_a
+// dibaca sekali untuk empat rantai penjumlahan yang saling bebas (urutan tetap, hasil deterministik).
+static void lsqTileGram(double *gram, int dim, const double *z, const double *w, size_t rows) {
+    double wa[LSQ_TILE_ROWS];
+    for (int a = 0; a < dim; a++) {
+        const double *za = z + (size_t)a * LSQ_TILE_ROWS;
+        for (size_t k = 0; k < rows; k++) {
+            wa[k] = w[k] * za[k];
+        }
+        int b = a;
+        for (; b + 4 <= dim; b += 4) {
+            const double *z0 = z + (size_t)b * LSQ_TILE_ROWS;
+            const double *z1 = z0 + LSQ_TILE_ROWS, *z2 = z1 + LSQ_TILE_ROWS, *z3 = z2 + LSQ_TILE_ROWS;
+            double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+            for (size_t k = 0; k < rows; k++) {
+                s0 += wa[k] * z0[k];
+                s1 += wa[k] * z1[k];
+                s2 += wa[k] * z2[k];
+                s3 += wa[k] * z3[k];
+            }
+            gram[a * dim + b] += s0;
+            gram[a * dim + b + 1] += s1;
+            gram[a * dim + b + 2] += s2;
+            gram[a * dim + b + 3] += s3;
+        }
+        for (; b < dim; b++) {
+            const double *zb = z + (size_t)b * LSQ_TILE_ROWS;
+            double s = 0;
+            for (size_t k = 0; k < rows; k++) {
+                s += wa[k] * zb[k];
+            }
+            gram[a * dim + b] += s;
+        }
+    }
+}
+
+static void lsqChunkWork(void *arg, size_t index) {
+    const LSQJob *job = (const LSQJob *)arg;
+    const LSQProblem *p = job->problem;
+    LSQChunk *chunk = &job->chunks[index];
+    size_t begin = index * p->chunk_rows;
+    size_t end = begin + p->chunk_rows < p->n ? begin + p->chunk_rows : p->n;
+    double z[LSQ_MAX_DIM * LSQ_TILE_ROWS];
+    double w[LSQ_TILE_ROWS];
+    memset(chunk, 0, sizeof(*chunk));
+    for (size_t i = begin; i < end; i += LSQ_TILE_ROWS) {
+        size_t rows = end - i < LSQ_TILE_ROWS ? end - i : LSQ_TILE_ROWS;
+        chunk->count += lsqFillTile(p, i, rows, z, w);
+        lsqTileGram(chunk->gram, p->dim, z, w, rows);
+    }
+}
+
+// QR streaming pada baris √w·[1 T y] (TSQR seperti polyFitQR). Return SS_res, atau -1 jika singular.
+static double lsqSolveQR(const LSQProblem *p, double *solution) {
+    enum { BLOCK = 64 };
+    int dim = p->dim;
+    double work[LSQ_MAX_DIM * (LSQ_MAX_DIM + BLOCK)];
+    double row[LSQ_MAX_DIM];
+    memset(work, 0, sizeof(double) * dim * (dim + BLOCK));
+    int rows = dim;
+    for (size_t i = 0; i < p->n; i++) {
+        double w;
+        if (!lsqRow(p, i, row, &w)) {
+            continue;
+        }
+        double sw = sqrt(w);
+        for (int a = 0; a < dim; a++) {
+            work[rows * dim + a] = sw * row[a];
+        }
+        if (++rows == dim + BLOCK) {
+            householderTriangularize(work, rows, dim);
+            rows = dim;
+        }
+    }
+    householderTriangularize(work, rows, dim);
+    // Diagonal R yang relatif nol berarti kolom kolinear (rank kurang)
+    int terms = dim - 1;
+    double max_diag = 0;
+    for (int k = 0; k < terms; k++) {
+        max_diag = fabs(work[k * dim + k]) > max_diag ? fabs(work[k * dim + k]) : max_diag;
+    }
+    for (int k = 0; k < terms; k++) {
+        if (!(fabs(work[k * dim + k]) > 1e-12 * max_diag)) {
+            return -1;
+        }
+        solution[k] = work[k * dim + terms];
+    }
+    if (upperTriangularSolve(work, terms, dim, solution) != 0) {
+        return -1;
+    }
+    double residual = work[terms * dim + terms];
+    return residual * residual;
+}
+
+// Rentang kolom yang hanya memperhitungkan nilai hingga (NaN dari dataset dilewati)
+static void lsqRangeScale(const double *x, size_t stride, size_t n, double *shift, double *inv_scale) {
+    double min_x = INFINITY, max_x = -INFINITY;
+    for (size_t i = 0; i < n; i++) {
+        double v = x[i * stride];
+        if (isfinite(v)) {
+            min_x = v < min_x ? v : min_x;
+            max_x = v > max_x ? v : max_x;
+        }
+    }
+    *shift = min_x <= max_x ? 0.5 * (min_x + max_x) : 0.0;
+    double scale = 0.5 * (max_x - min_x);
+    *inv_scale = scale > 0 && isfinite(scale) ? 1.0 / scale : 1.0;
+}
+
+// Fit y ≈ b0 + Σ_j Σ_{d=1..degrees[j]} b_jd x_j^d dengan bobot per baris (weights NULL: semua 1).
+// degrees NULL berarti semua kolom linear. Baris yang salah satu nilainya bukan angka, atau
+// bobotnya negatif, dilewati. pool NULL berarti serial.
+CFStatus leastSquaresFit(const double *const *x, const int *degrees, int num_x, size_t stride, const double *y,
+                         const double *weights, size_t n, PolySolver solver, ThreadPool *pool,
+                         LeastSquaresResult *result) {
+    memset(result, 0, sizeof(*result));
+    if (num_x < 1 || num_x > MAX_COLUMNS) {
+        return CF_ERROR_ARGUMENT;
+    }
+    LSQProblem p = {x, NULL, num_x, 2, stride, y, weights, n, 0, {0}, {0}, 0};
+    int ones[MAX_COLUMNS];
+    for (int j = 0; j < num_x; j++) {
+        ones[j] = degrees ? degrees[j] : 1;
+        if (ones[j] < 1 || ones[j] > MAX_POLY_DEGREE) {
+            return CF_ERROR_ARGUMENT;
+        }
+        p.dim += ones[j];
+    }
+    p.degrees = ones;
+    if (p.dim - 1 > LSQ_MAX_TERMS) {
+        return CF_ERROR_ARGUMENT;
+    }
+    double span = metricsSpanBegin();
+    for (int j = 0; j < num_x; j++) {
+        lsqRangeScale(x[j], stride, n, &p.shift[j], &p.inv_scale[j]);
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (isfinite(y[i * stride])) {
+            p.y_shift = y[i * stride];
+            break;
+        }
+    }
+
+    // Potongan berukuran tetap (bergantung n saja) supaya urutan penjumlahan tidak bergantung thread
+    p.chunk_rows = n / LSQ_MAX_CHUNKS + 1;
+    p.chunk_rows = p.chunk_rows > LSQ_MIN_CHUNK_ROWS ? p.chunk_rows : LSQ_MIN_CHUNK_ROWS;
+    size_t num_chunks = n ? (n + p.chunk_rows - 1) / p.chunk_rows : 0;
+    LSQChunk *chunks = (LSQChunk *)malloc((num_chunks ? num_chunks : 1) * sizeof(LSQChunk));
+    if (!chunks) {
+        return CF_ERROR_MEMORY;
+    }
+    LSQJob job = {&p, chunks};
+    threadPoolParallelFor(num_chunks > 1 ? pool : NULL, num_chunks, lsqChunkWork, &job);
+
+    int dim = p.dim, terms = dim - 1;
+    double gram[LSQ_MAX_DIM * LSQ_MAX_DIM] = {0};
+    size_t count = 0;
+    for (size_t c = 0; c < num_chunks; c++) {
+        for (int a = 0; a < dim; a++) {
+            for (int b = a; b < dim; b++) {
+                gram[a * dim + b] += chunks[c].gram[a * dim + b];
+            }
+        }
+        count += chunks[c].count;
+    }
+    free(chunks);
+    if (count < (size_t)dim) {
+        return CF_ERROR_NO_DATA;
+    }
+
+    // Persamaan normal dari segitiga atas Gram; kolom terakhir adalah XᵀWy, sudut kanan bawah yᵀWy
+    double weight_sum = gram[0], sum_wy = gram[terms], sum_wyy = gram[terms * dim + terms];
+    double solution[LSQ_MAX_TERMS], matrix[LSQ_MAX_TERMS * LSQ_MAX_TERMS];
+    double ss_res = -1;
+    if (solver != POLY_SOLVER_QR) {
+        for (int a = 0; a < terms; a++) {
+            for (int b = 0; b < terms; b++) {
+                matrix[a * terms + b] = a <= b ? gram[a * dim + b] : gram[b * dim + a];
+            }
+            solution[a] = gram[a * dim + terms];
+        }
+        if (choleskySolveEquilibratedPivot(matrix, terms, solution, LSQ_MIN_PIVOT) == 0) {
+            double explained = 0;
+            for (int a = 0; a < terms; a++) {
+                explained += solution[a] * gram[a * dim + terms];
+            }
+            ss_res = sum_wyy - explained > 0 ? sum_wyy - explained : 0;
+        } else if (solver == POLY_SOLVER_CHOLESKY) {
+            return CF_ERROR_ARGUMENT;
+        }
+    }
+    if (ss_res < 0) {
+        ss_res = lsqSolveQR(&p, solution);
+        if (ss_res < 0) {
+            return CF_ERROR_ARGUMENT; // Kolom kolinear
+        }
+        result->used_qr = 1;
+    }
+
+    // Kembali ke basis x biasa: setiap kolom diekspansi seperti polynomial, intercept dijumlahkan
+    result->num_x = num_x;
+    result->num_terms = terms;
+    result->coefficients[0] = solution[0] + p.y_shift;
+    int k = 1;
+    for (int j = 0; j < num_x; j++) {
+        double scaled[MAX_POLY_DEGREE + 1], raw[MAX_POLY_DEGREE + 1];
+        scaled[0] = 0;
+        memcpy(scaled + 1, solution + k, ones[j] * sizeof(double));
+        polyToRawBasis(scaled, ones[j], p.shift[j], 1.0 / p.inv_scale[j], 0.0, raw);
+        result->coefficients[0] += raw[0];
+        memcpy(result->coefficients + k, raw + 1, ones[j] * sizeof(double));
+        result->degrees[j] = ones[j];
+        k += ones[j];
+    }
+
+    double ss_tot = sum_wyy - sum_wy * sum_wy / weight_sum;
+    double df = (double)count - terms;
+    result->num_points = count;
+    result->weight_sum = weight_sum;
+    result->r_squared = ss_tot > 0 ? 1 - ss_res / ss_tot : NAN;
+    result->adjusted_r_squared = df > 0 ? 1 - (1 - result->r_squared) * ((double)count - 1) / df : NAN;
+    result->residual_std = df > 0 ? sqrt(ss_res / df) : NAN;
+    metricsSpanEnd(METRIC_SPAN_FIT_MULTIPLE, span);
+    metricsAdd(METRIC_FITS, 1);
+    return CF_OK;
+}
+
+// Fit pada kolom dataset. weight_column -1 berarti tanpa bobot.
+CFStatus datasetLeastSquares(const Dataset *ds, const int *x_columns, const int *degrees, int num_x, int y_column,
+                             int weight_column, ThreadPool *pool, LeastSquaresResult *result) {
+    const double *x[MAX_COLUMNS];
+    if (num_x < 1 || num_x > MAX_COLUMNS || y_column < 0 || y_column >= ds->num_columns ||
+        weight_column >= ds->num_columns) {
+        return CF_ERROR_ARGUMENT;
+    }
+    for (int j = 0; j < num_x; j++) {
+        if (x_columns[j] < 0 || x_columns[j] >= ds->num_columns) {
+            return CF_ERROR_ARGUMENT;
+        }
+        x[j] = ds->values[x_columns[j]];
+    }
+    const double *weights = weight_column >= 0 ? ds->values[weight_column] : NULL;
+    return leastSquaresFit(x, degrees, num_x, 1, ds->values[y_column], weights, ds->num_rows, POLY_SOLVER_AUTO, pool,
+                           result);
+}
+
+// Prediksi untuk satu baris x (satu nilai per kolom x, urutan seperti saat fit)
+double leastSquaresEval(const LeastSquaresResult *result, const double *x) {
+    double value = result->coefficients[0];
+    int k = 1;
+    for (int j = 0; j < result->num_x; j++) {
+        double term = 0;
+        for (int d = result->degrees[j]; d >= 1; d--) {
+            term = (term + result->coefficients[k + d - 1]) * x[j];
+        }
+        value += term;
+        k += result->degrees[j];
+    }
+    return value;
+}
+
+// Angka JSON; NaN/inf (misalnya R² adjusted tanpa derajat bebas) ditulis null
+static void lsqWriteNumber(FILE *out, const char *key, double value, const char *suffix) {
+    fprintf(out, "  \"%s\": ", key);
+    if (isfinite(value)) {
+        fprintf(out, "%.17g%s", value, suffix);
+    } else {
+        fprintf(out, "null%s", suffix);
+    }
+}
+
+// Satu objek JSON: kolom y/bobot, intercept dan satu entri per suku (kolom, pangkat, koefisien)
+void writeLeastSquaresJSON(FILE *out, const Dataset *ds, const int *x_columns, int y_column, int weight_column,
+                           const LeastSquaresResult *result) {
+    fprintf(out, "{\n  \"y\": ");
+    writeQuotedName(out, ds->columns[y_column].name, '\\');
+    fprintf(out, ",\n  \"weights\": ");
+    if (weight_column >= 0) {
+        writeQuotedName(out, ds->columns[weight_column].name, '\\');
+    } else {
+        fprintf(out, "null");
+    }
+    fprintf(out, ",\n  \"n\": %zu,\n  \"weight_sum\": %.17g,\n  \"intercept\": %.17g,\n  \"terms\": [",
+            result->num_points, result->weight_sum, result->coefficients[0]);
+    int k = 1;
+    for (int j = 0; j < result->num_x; j++) {
+        for (int d = 1; d <= result->degrees[j]; d++, k++) {
+            fprintf(out, "%s\n    {\"column\": ", k > 1 ? "," : "");
+            writeQuotedName(out, ds->columns[x_columns[j]].name, '\\');
+            fprintf(out, ", \"power\": %d, \"coefficient\": %.17g}", d, result->coefficients[k]);
+        }
+    }
+    fprintf(out, "\n  ],\n");
+    lsqWriteNumber(out, "r_squared", result->r_squared, ",\n");
+    lsqWriteNumber(out, "adjusted_r_squared", result->adjusted_r_squared, ",\n");
+    lsqWriteNumber(out, "residual_std", result->residual_std, ",\n");
+    fprintf(out, "  \"solver\": \"%s\"\n}\n", result->used_qr ? "qr" : "cholesky");
+}
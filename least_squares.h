@@ -0,0 +1,46 @@
+#ifndef LEAST_SQUARES_H
+#define LEAST_SQUARES_H
+
+#include "batch_fit.h"
+
+// Least squares berganda (dan berbobot) atas beberapa kolom x. Setiap kolom x_j menyumbang suku
+// pangkat 1..degree_j pada basis t_j = (x_j - shift_j) / scale_j (rentang [-1, 1]), sehingga regresi
+// linear berganda adalah semua degree 1 dan polynomial adalah satu kolom dengan degree d.
+//
+// Satu lintasan data membentuk matriks Gram [1 T y]ᵀ W [1 T y] (berisi XᵀWX, XᵀWy dan yᵀWy): baris
+// diisi per tile kolom-mayor LSQ_TILE_ROWS baris, lalu setiap elemen Gram adalah dot product dua kolom
+// tile yang kontigu. Data dibagi ke potongan berukuran tetap yang dikerjakan paralel dan digabung
+// berurutan, jadi hasilnya identik untuk berapa pun jumlah thread. Solusi dengan Cholesky (equilibrasi),
+// otomatis pindah ke Householder QR streaming jika matriks tidak positif definit.
+
+#define LSQ_MAX_TERMS 32         // Suku termasuk intercept
+#define LSQ_TILE_ROWS 128        // Baris per tile
+#define LSQ_MIN_CHUNK_ROWS 65536 // Minimal baris per potongan paralel
+#define LSQ_MAX_CHUNKS 256
+// Pivot Cholesky terequilibrasi di bawah ini dianggap kolinear: jalur AUTO pindah ke QR (cek rank)
+#define LSQ_MIN_PIVOT 1e-12
+
+typedef struct {
+    int num_x;
+    int num_terms;                      // Termasuk intercept
+    int degrees[MAX_COLUMNS];
+    double coefficients[LSQ_MAX_TERMS]; // [0] intercept, lalu per kolom x: pangkat 1..degree (basis x biasa)
+    double r_squared;
+    double adjusted_r_squared;          // 1 - (1 - R²)(n - 1)/(n - k - 1), k = suku tanpa intercept
+    double residual_std;                // sqrt(SS_res / (n - k - 1)), berbobot
+    size_t num_points;                  // Baris valid (semua kolom numerik, bobot >= 0)
+    double weight_sum;
+    int used_qr;                        // 1 jika solusi dari QR
+} LeastSquaresResult;
+
+// Deklarasi fungsi
+CFStatus leastSquaresFit(const double *const *x, const int *degrees, int num_x, size_t stride, const double *y,
+                         const double *weights, size_t n, PolySolver solver, ThreadPool *pool,
+                         LeastSquaresResult *result);
+CFStatus datasetLeastSquares(const Dataset *ds, const int *x_columns, const int *degrees, int num_x, int y_column,
+                             int weight_column, ThreadPool *pool, LeastSquaresResult *result);
+double leastSquaresEval(const LeastSquaresResult *result, const double *x);
+void writeLeastSquaresJSON(FILE *out, const Dataset *ds, const int *x_columns, int y_column, int weight_column,
+                           const LeastSquaresResult *result);
+
+#endif
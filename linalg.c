@@ -0,0 +1,140 @@
+#include "linalg.h"
+
+// Faktorisasi Cholesky A = L Lᵀ lalu selesaikan A x = b. a (n×n, simetris positif
+// definit) ditimpa oleh L, b ditimpa oleh x. Return -1 jika ada pivot (sebelum akar) <= min_pivot.
+static int choleskySolvePivot(double *a, int n, double *b, double min_pivot) {
+    for (int j = 0; j < n; j++) {
+        double d = a[j * n + j];
+        for (int k = 0; k < j; k++) {
+            d -= a[j * n + k] * a[j * n + k];
+        }
+        if (!(d > min_pivot)) {
+            return -1;
+        }
+        d = sqrt(d);
+        a[j * n + j] = d;
+        for (int i = j + 1; i < n; i++) {
+            double s = a[i * n + j];
+            for (int k = 0; k < j; k++) {
+                s -= a[i * n + k] * a[j * n + k];
+            }
+            a[i * n + j] = s / d;
+        }
+    }
+
+    // L y = b
+    for (int i = 0; i < n; i++) {
+        double s = b[i];
+        for (int k = 0; k < i; k++) {
+            s -= a[i * n + k] * b[k];
+        }
+        b[i] = s / a[i * n + i];
+    }
+    // Lᵀ x = y
+    for (int i = n - 1; i >= 0; i--) {
+        double s = b[i];
+        for (int k = i + 1; k < n; k++) {
+            s -= a[k * n + i] * b[k];
+        }
+        b[i] = s / a[i * n + i];
+    }
+    return 0;
+}
+
+// Return -1 jika A tidak positif definit
+int choleskySolve(double *a, int n, double *b) {
+    return choleskySolvePivot(a, n, b, 0.0);
+}
+
+// Cholesky dengan equilibrasi diagonal (D^-1/2 A D^-1/2), mengurangi condition number
+// untuk matriks yang skala barisnya sangat berbeda (misalnya matriks momen polynomial)
+int choleskySolveEquilibrated(double *a, int n, double *b) {
+    return choleskySolveEquilibratedPivot(a, n, b, 0.0);
+}
+
+// Seperti choleskySolveEquilibrated, tetapi pivot matriks terequilibrasi (diagonal 1) harus > min_pivot.
+// Pivot sekecil itu berarti suatu kolom hampir kombinasi linear kolom sebelumnya; dengan pembulatan
+// pivot kolom yang kolinear persis bisa tetap sedikit positif, jadi min_pivot > 0 menolaknya.
+int choleskySolveEquilibratedPivot(double *a, int n, double *b, double min_pivot) {
+    double scale[64];
+    if (n > 64) {
+        return choleskySolvePivot(a, n, b, min_pivot);
+    }
+    for (int i = 0; i < n; i++) {
+        double d = a[i * n + i];
+        if (!(d > 0.0)) {
+            return -1;
+        }
+        scale[i] = 1.0 / sqrt(d);
+    }
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            a[i * n + j] *= scale[i] * scale[j];
+        }
+        b[i] *= scale[i];
+    }
+    if (choleskySolvePivot(a, n, b, min_pivot) != 0) {
+        return -1;
+    }
+    for (int i = 0; i < n; i++) {
+        b[i] *= scale[i];
+    }
+    return 0;
+}
+
+// Triangularisasi Householder in-place untuk matriks rows×cols (rows >= cols):
+// setelah selesai, segitiga atas baris 0..cols-1 berisi R dan sisanya nol.
+// Dipakai juga secara streaming: R lama ditumpuk di atas blok baris baru (TSQR).
+void householderTriangularize(double *a, int rows, int cols) {
+    for (int k = 0; k < cols && k < rows; k++) {
+        double norm2 = 0.0;
+        for (int i = k; i < rows; i++) {
+            norm2 += a[i * cols + k] * a[i * cols + k];
+        }
+        double norm = sqrt(norm2);
+        if (norm == 0.0) {
+            continue;
+        }
+        double alpha = a[k * cols + k] > 0 ? -norm : norm;
+        // v = x - alpha e1, disimpan di kolom k
+        double v0 = a[k * cols + k] - alpha;
+        double vnorm2 = v0 * v0;
+        for (int i = k + 1; i < rows; i++) {
+            vnorm2 += a[i * cols + k] * a[i * cols + k];
+        }
+        if (vnorm2 == 0.0) {
+            continue;
+        }
+        for (int j = k + 1; j < cols; j++) {
+            double dot = v0 * a[k * cols + j];
+            for (int i = k + 1; i < rows; i++) {
+                dot += a[i * cols + k] * a[i * cols + j];
+            }
+            double f = 2.0 * dot / vnorm2;
+            a[k * cols + j] -= f * v0;
+            for (int i = k + 1; i < rows; i++) {
+                a[i * cols + j] -= f * a[i * cols + k];
+            }
+        }
+        a[k * cols + k] = alpha;
+        for (int i = k + 1; i < rows; i++) {
+            a[i * cols + k] = 0.0;
+        }
+    }
+}
+
+// Substitusi mundur R x = b untuk R segitiga atas n×n dengan leading dimension ld
+int upperTriangularSolve(const double *r, int n, int ld, double *b) {
+    for (int i = n - 1; i >= 0; i--) {
+        double d = r[i * ld + i];
+        if (d == 0.0) {
+            return -1;
+        }
+        double s = b[i];
+        for (int k = i + 1; k < n; k++) {
+            s -= r[i * ld + k] * b[k];
+        }
+        b[i] = s / d;
+    }
+    return 0;
+}
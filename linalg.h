@@ -0,0 +1,17 @@
+#ifndef LINALG_H
+#define LINALG_H
+
+#include <math.h>
+#include <stddef.h>
+
+// Solver sistem linear kecil dan padat. Semua matriks disimpan row-major dalam satu
+// array kontigu (bukan double**), dengan leading dimension = jumlah kolom.
+
+// Deklarasi fungsi
+int choleskySolve(double *a, int n, double *b);
+int choleskySolveEquilibrated(double *a, int n, double *b);
+int choleskySolveEquilibratedPivot(double *a, int n, double *b, double min_pivot);
+void householderTriangularize(double *a, int rows, int cols);
+int upperTriangularSolve(const double *r, int n, int ld, double *b);
+
+#endif
@@ -1,75 +1,1363 @@
 #include "curve_fitting.h"
+#include "batch_fit.h"
+#include "dataset.h"
+#include "gnuplot.h"
+#include "group_fit.h"
+#include "incremental.h"
+#include "interp.h"
+#include "least_squares.h"
+#include "model_io.h"
+#include "model_select.h"
+#include "plot.h"
+#include "predict.h"
+#include "rolling.h"
+#include "spline.h"
+#include "streaming.h"
 #include <math.h>
+#include <unistd.h>
 
-int main() {
-    char filename[256];
-    printf("Masukkan nama file CSV: ");
-    scanf("%255s", filename);
+// Fungsi library tidak mencetak apa pun; CLI menerjemahkan kode status menjadi pesan
+static void printStatusError(CFStatus status, const char *subject) {
+    if (subject) {
+        printf("Error: %s (%s)\n", cfStatusMessage(status), subject);
+    } else {
+        printf("Error: %s\n", cfStatusMessage(status));
+    }
+}
+
+// File tujuan metrics (--metrics atau CURVEFIT_METRICS), ditulis sekali saat program selesai
+static const char *metrics_path = NULL;
+
+static void writeMetricsAtExit(void) {
+    CFStatus status = metricsWriteFile(metrics_path);
+    if (status != CF_OK) {
+        fprintf(stderr, "Error: gagal menulis metrics ke %s: %s\n", metrics_path, cfStatusMessage(status));
+    }
+}
+
+// Ambil opsi global --metrics FILE dari argv (berlaku untuk semua mode) lalu aktifkan metrics.
+// Return argc baru.
+static int takeMetricsOption(int argc, char *argv[]) {
+    int kept = 0;
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "--metrics") == 0 && i + 1 < argc) {
+            metrics_path = argv[++i];
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    argv[kept] = NULL;
+    if (!metrics_path) {
+        const char *env = getenv("CURVEFIT_METRICS");
+        metrics_path = env && *env ? env : NULL;
+    }
+    if (metrics_path) {
+        metricsEnable(1);
+        atexit(writeMetricsAtExit);
+    }
+    return kept;
+}
+
+// Mode batch non-interaktif: fit semua pasangan kolom lalu tulis satu tabel hasil
+static int runBatchCommand(int argc, char *argv[]) {
+    const char *filename = NULL;
+    const char *output = NULL;
+    const char *format = "csv";
+    const char *plot_dir = NULL;
+    int use_gnuplot = 0;
+    BatchFitOptions options;
+    defaultBatchFitOptions(&options);
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            options.num_threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--degrees") == 0 && i + 1 < argc) {
+            if (sscanf(argv[++i], "%d-%d", &options.min_degree, &options.max_degree) == 1) {
+                options.max_degree = options.min_degree;
+            }
+        } else if (strcmp(argv[i], "--models") == 0 && i + 1 < argc) {
+            const char *models = argv[++i];
+            options.fit_linear = strstr(models, "linear") != NULL;
+            options.fit_polynomial = strstr(models, "poly") != NULL;
+            options.fit_logistic = strstr(models, "logistic") != NULL;
+        } else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            format = argv[++i];
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            output = argv[++i];
+        } else if (strcmp(argv[i], "--plots") == 0 && i + 1 < argc) {
+            plot_dir = argv[++i];
+        } else if (strcmp(argv[i], "--gnuplot") == 0) {
+            use_gnuplot = 1;
+        } else if (!filename && argv[i][0] != '-') {
+            filename = argv[i];
+        } else {
+            filename = NULL;
+            break;
+        }
+    }
+    if (!filename || (strcmp(format, "csv") != 0 && strcmp(format, "json") != 0)) {
+        printf("Penggunaan: curve_fitting batch FILE.csv [--degrees MIN-MAX] [--models linear,poly,logistic]\n"
+               "                            [--threads N] [--format csv|json] [--output FILE]\n"
+               "                            [--plots DIREKTORI] [--gnuplot]\n");
+        return 1;
+    }
+
+    Dataset dataset;
+    CFStatus load_status = loadDataset(filename, &dataset, options.num_threads, NULL);
+    if (load_status != CF_OK) {
+        printStatusError(load_status, filename);
+        return 1;
+    }
+
+    BatchFitEntry *entries;
+    int num_entries;
+    if (runBatchFit(&dataset, &options, &entries, &num_entries) != 0) {
+        printf("Error: memori tidak cukup untuk mode batch\n");
+        freeDataset(&dataset);
+        return 1;
+    }
+
+    FILE *out = output ? fopen(output, "w") : stdout;
+    if (!out) {
+        printf("Error membuka file %s\n", output);
+        freeBatchFit(entries, num_entries);
+        freeDataset(&dataset);
+        return 1;
+    }
+    if (strcmp(format, "json") == 0) {
+        writeBatchFitJSON(out, &dataset, entries, num_entries);
+    } else {
+        writeBatchFitCSV(out, &dataset, entries, num_entries);
+    }
+    if (out != stdout) {
+        fclose(out);
+    }
+
+    // Satu PNG per hasil, dirender paralel (renderer bawaan, atau satu proses gnuplot per thread)
+    int status = 0;
+    if (plot_dir) {
+        CFStatus plot_status = use_gnuplot
+                                   ? gnuplotBatchFit(&dataset, entries, num_entries, plot_dir, options.num_threads)
+                                   : plotBatchFit(&dataset, entries, num_entries, plot_dir, options.num_threads);
+        if (plot_status != CF_OK) {
+            printf("Error: sebagian plot gagal ditulis ke %s: %s\n", plot_dir, cfStatusMessage(plot_status));
+            status = 1;
+        }
+    }
+
+    freeBatchFit(entries, num_entries);
+    freeDataset(&dataset);
+    return status;
+}
+
+// Kolom bisa ditulis sebagai nomor (mulai dari 1) atau nama dari header. Return -1 jika tidak ada.
+static int resolveColumnArg(const char *arg, const ColumnInfo *columns, int num_columns) {
+    char *end;
+    long number = strtol(arg, &end, 10);
+    if (*arg && *end == '\0') {
+        return number >= 1 ? (int)number - 1 : -1;
+    }
+    for (int i = 0; columns && i < num_columns; i++) {
+        if (strcmp(columns[i].name, arg) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Cetak persamaan dan R-squared hasil regresi
+static void printRegressionSummary(FILE *out, const RegressionResult *result) {
+    if (result->type == REGRESSION_LINEAR) {
+        fprintf(out, "y = %.6fx + %.6f\n", result->slope, result->intercept);
+    } else if (result->type == REGRESSION_LOGISTIC) {
+        fprintf(out, "y = %.6f / (1 + %.6f * e^(-%.6f * (x - %.6f)))\n", result->c, result->a, result->b,
+                result->mean_x);
+    } else {
+        fprintf(out, "y = ");
+        for (int i = result->degree; i >= 0; i--) {
+            fprintf(out, "%.6fx^%d%s", result->coefficients[i], i, i > 0 ? " + " : "\n");
+        }
+    }
+    fprintf(out, "R-squared = %.6f\n", result->r_squared);
+}
+
+// Mode streaming: regresi linear/polynomial untuk file (atau stdin) yang tidak muat di RAM
+static int runStreamCommand(int argc, char *argv[]) {
+    const char *filename = NULL;
+    const char *x_arg = NULL;
+    const char *y_arg = NULL;
+    RegressionType type = REGRESSION_LINEAR;
+    int degree = 2;
+    size_t chunk_size = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-x") == 0 && i + 1 < argc) {
+            x_arg = argv[++i];
+        } else if (strcmp(argv[i], "-y") == 0 && i + 1 < argc) {
+            y_arg = argv[++i];
+        } else if (strcmp(argv[i], "--type") == 0 && i + 1 < argc) {
+            i++;
+            type = strncmp(argv[i], "poly", 4) == 0 ? REGRESSION_POLYNOMIAL : REGRESSION_LINEAR;
+        } else if (strcmp(argv[i], "--degree") == 0 && i + 1 < argc) {
+            degree = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--chunk") == 0 && i + 1 < argc) {
+            chunk_size = (size_t)strtoull(argv[++i], NULL, 10);
+        } else if (!filename && (argv[i][0] != '-' || strcmp(argv[i], "-") == 0)) {
+            filename = argv[i];
+        } else {
+            filename = NULL;
+            break;
+        }
+    }
+    if (!filename || !x_arg || !y_arg || degree < 1 || degree > MAX_POLY_DEGREE) {
+        printf("Penggunaan: curve_fitting stream FILE.csv|- -x KOLOM -y KOLOM [--type linear|poly]\n"
+               "                             [--degree D] [--chunk BYTES]\n");
+        return 1;
+    }
+
+    // Nama kolom hanya bisa dipakai jika header bisa dibaca terpisah (bukan stdin)
+    int num_columns = 0;
+    ColumnInfo *columns = strcmp(filename, "-") != 0 ? readCSVHeader(filename, &num_columns) : NULL;
+    int x_column = resolveColumnArg(x_arg, columns, num_columns);
+    int y_column = resolveColumnArg(y_arg, columns, num_columns);
+    free(columns);
+    if (x_column < 0 || y_column < 0) {
+        printf("Error: kolom tidak ditemukan\n");
+        return 1;
+    }
+
+    CSVLoadStats stats;
+    RegressionResult result;
+    CFStatus status = streamRegression(filename, x_column, y_column, type, degree, chunk_size, &stats, &result);
+    if (status != CF_OK) {
+        printStatusError(status, filename);
+        return 1;
+    }
+    if (isnan(result.r_squared)) {
+        printf("Error: regresi tidak dapat dihitung\n");
+        freeRegressionResult(&result);
+        return 1;
+    }
+
+    printf("Dibaca %zu baris (%zu dilewati) dalam %.3f detik: %.2f MB/s, %.0f baris/s\n",
+           stats.rows, stats.rows_skipped, stats.seconds, stats.mb_per_sec, stats.rows_per_sec);
+    printRegressionSummary(stdout, &result);
+    freeRegressionResult(&result);
+    return 0;
+}
+
+// Mode inkremental untuk CSV append-only: state disimpan di file, setiap run hanya membaca
+// baris yang ditambahkan sejak run sebelumnya
+static int runUpdateCommand(int argc, char *argv[]) {
+    const char *filename = NULL;
+    const char *state_path = NULL;
+    const char *x_arg = NULL;
+    const char *y_arg = NULL;
+    RegressionType type = REGRESSION_LINEAR;
+    int degree = 2;
+    uint64_t window_rows = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--state") == 0 && i + 1 < argc) {
+            state_path = argv[++i];
+        } else if (strcmp(argv[i], "-x") == 0 && i + 1 < argc) {
+            x_arg = argv[++i];
+        } else if (strcmp(argv[i], "-y") == 0 && i + 1 < argc) {
+            y_arg = argv[++i];
+        } else if (strcmp(argv[i], "--type") == 0 && i + 1 < argc) {
+            i++;
+            type = strncmp(argv[i], "poly", 4) == 0 ? REGRESSION_POLYNOMIAL : REGRESSION_LINEAR;
+        } else if (strcmp(argv[i], "--degree") == 0 && i + 1 < argc) {
+            degree = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--window") == 0 && i + 1 < argc) {
+            window_rows = strtoull(argv[++i], NULL, 10);
+        } else if (!filename && argv[i][0] != '-') {
+            filename = argv[i];
+        } else {
+            filename = NULL;
+            break;
+        }
+    }
+    if (!filename || !state_path || degree < 1 || degree > MAX_POLY_DEGREE) {
+        printf("Penggunaan: curve_fitting update FILE.csv --state FILE.state [-x KOLOM -y KOLOM]\n"
+               "                             [--type linear|poly] [--degree D] [--window BARIS]\n");
+        return 1;
+    }
+
+    // State lama dipakai apa adanya; kolom dan jenis regresi hanya dibutuhkan untuk run pertama
+    IncrementalFit fit;
+    CFStatus status;
+    if (access(state_path, F_OK) == 0) {
+        status = incrementalFitLoad(state_path, &fit);
+        if (status != CF_OK) {
+            printStatusError(status, state_path);
+            return 1;
+        }
+    } else {
+        if (!x_arg || !y_arg) {
+            printf("Error: -x dan -y wajib diisi untuk state baru\n");
+            return 1;
+        }
+        int num_columns = 0;
+        ColumnInfo *columns = readCSVHeader(filename, &num_columns);
+        int x_column = resolveColumnArg(x_arg, columns, num_columns);
+        int y_column = resolveColumnArg(y_arg, columns, num_columns);
+        free(columns);
+        if (x_column < 0 || y_column < 0) {
+            printf("Error: kolom tidak ditemukan\n");
+            return 1;
+        }
+        incrementalFitInit(&fit, x_column, y_column, type, degree, window_rows);
+    }
+
+    CSVLoadStats stats;
+    status = incrementalFitUpdate(&fit, filename, &stats);
+    if (status != CF_OK) {
+        printStatusError(status, filename);
+        return 1;
+    }
+    printf("Baris baru: %zu (%zu dilewati) dalam %.3f detik, total %.0f baris dalam model\n",
+           stats.rows, stats.rows_skipped, stats.seconds, fit.acc.n);
+
+    RegressionResult result = incrementalFitResult(&fit);
+    if (isnan(result.r_squared)) {
+        printf("Error: regresi tidak dapat dihitung\n");
+    } else {
+        printRegressionSummary(stdout, &result);
+    }
+    freeRegressionResult(&result);
+    status = incrementalFitSave(state_path, &fit);
+    if (status != CF_OK) {
+        printStatusError(status, state_path);
+        return 1;
+    }
+    return 0;
+}
+
+// Mode rolling: regresi untuk setiap jendela window baris terakhir, satu baris hasil per langkah
+static int runRollingCommand(int argc, char *argv[]) {
+    const char *filename = NULL;
+    const char *x_arg = NULL;
+    const char *y_arg = NULL;
+    const char *output_path = NULL;
+    RegressionType type = REGRESSION_LINEAR;
+    int degree = 2;
+    size_t window = 0;
+    int num_threads = 0;
+    int digits = 10;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-x") == 0 && i + 1 < argc) {
+            x_arg = argv[++i];
+        } else if (strcmp(argv[i], "-y") == 0 && i + 1 < argc) {
+            y_arg = argv[++i];
+        } else if (strcmp(argv[i], "--window") == 0 && i + 1 < argc) {
+            window = (size_t)strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--type") == 0 && i + 1 < argc) {
+            i++;
+            type = strncmp(argv[i], "poly", 4) == 0 ? REGRESSION_POLYNOMIAL : REGRESSION_LINEAR;
+        } else if (strcmp(argv[i], "--degree") == 0 && i + 1 < argc) {
+            degree = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            output_path = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            num_threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--digits") == 0 && i + 1 < argc) {
+            digits = atoi(argv[++i]);
+        } else if (!filename && argv[i][0] != '-') {
+            filename = argv[i];
+        } else {
+            filename = NULL;
+            break;
+        }
+    }
+    if (type == REGRESSION_LINEAR) {
+        degree = 1;
+    }
+    if (!filename || !x_arg || !y_arg || window < (size_t)degree + 1 || degree < 1 || degree > MAX_POLY_DEGREE ||
+        digits < 1 || digits > 17) {
+        printf("Penggunaan: curve_fitting rolling FILE.csv -x KOLOM -y KOLOM --window W [--type linear|poly]\n"
+               "                             [--degree D] [--output FILE] [--threads N] [--digits 1-17]\n");
+        return 1;
+    }
+
+    Dataset dataset;
+    CFStatus status = loadDataset(filename, &dataset, num_threads, NULL);
+    if (status != CF_OK) {
+        printStatusError(status, filename);
+        return 1;
+    }
+    int x_column = resolveColumnArg(x_arg, dataset.columns, dataset.num_columns);
+    int y_column = resolveColumnArg(y_arg, dataset.columns, dataset.num_columns);
+    if (x_column < 0 || y_column < 0 || x_column >= dataset.num_columns || y_column >= dataset.num_columns) {
+        printf("Error: kolom tidak ditemukan\n");
+        freeDataset(&dataset);
+        return 1;
+    }
+
+    // Baris dengan x atau y kosong dilewati; jendela dihitung atas baris yang lengkap
+    const double *x, *y;
+    double *scratch = NULL;
+    int num_points = 0;
+    if (datasetPairColumns(&dataset, x_column, y_column, &x, &y, &num_points, &scratch) != 0) {
+        printStatusError(CF_ERROR_MEMORY, NULL);
+        freeDataset(&dataset);
+        return 1;
+    }
+    size_t n = (size_t)num_points;
+    size_t steps = n >= window ? n - window + 1 : 0;
+    double *coefficients = (double *)malloc((steps ? steps : 1) * (degree + 1) * sizeof(double));
+    double *r_squared = (double *)malloc((steps ? steps : 1) * sizeof(double));
+    FILE *out = output_path ? fopen(output_path, "w") : stdout;
+    FILE *info = output_path ? stdout : stderr;
+    status = !coefficients || !r_squared ? CF_ERROR_MEMORY : (!out ? CF_ERROR_IO : CF_OK);
+
+    double start = monotonicSeconds();
+    if (status == CF_OK) {
+        ThreadPool *pool = num_threads > 0 ? threadPoolCreate(num_threads) : threadPoolShared();
+        status = rollingRegression(x, y, 1, n, window, degree, pool, coefficients, r_squared);
+        if (num_threads > 0) {
+            threadPoolDestroy(pool);
+        }
+    }
+    double seconds = monotonicSeconds() - start;
+    if (status == CF_OK) {
+        writeRollingCSV(out, x, 1, n, window, degree, coefficients, r_squared, digits);
+        fprintf(info, "%zu jendela dari %zu baris dalam %.3f detik (%.0f jendela/s)\n", steps, n, seconds,
+                seconds > 0 ? steps / seconds : 0.0);
+    } else {
+        printStatusError(status, status == CF_ERROR_IO ? output_path : filename);
+    }
+
+    if (out && out != stdout && fclose(out) != 0 && status == CF_OK) {
+        printStatusError(CF_ERROR_IO, output_path);
+        status = CF_ERROR_IO;
+    }
+    free(coefficients);
+    free(r_squared);
+    free(scratch);
+    freeDataset(&dataset);
+    return status == CF_OK ? 0 : 1;
+}
+
+// Baca query x (satu angka per baris) dari stream. Baris yang bukan angka dilewati.
+static double *readQueries(FILE *in, size_t *num_queries) {
+    size_t count = 0, capacity = 1024;
+    double *queries = (double *)malloc(capacity * sizeof(double));
+    char line[256];
+    while (queries && fgets(line, sizeof(line), in)) {
+        double value;
+        if (!parseDoubleField(line, line + strcspn(line, "\r\n"), &value)) {
+            continue;
+        }
+        if (count == capacity) {
+            double *grown = (double *)realloc(queries, 2 * capacity * sizeof(double));
+            if (!grown) {
+                free(queries);
+                return NULL;
+            }
+            queries = grown;
+            capacity *= 2;
+        }
+        queries[count++] = value;
+    }
+    *num_queries = count;
+    return queries;
+}
 
-    // Baca header untuk mendapatkan informasi kolom
-    int num_columns;
+// Mode interpolasi: jawab banyak query x terhadap data (bukan model hasil regresi)
+static int runInterpCommand(int argc, char *argv[]) {
+    const char *filename = NULL;
+    const char *x_arg = NULL;
+    const char *y_arg = NULL;
+    const char *query_path = NULL;
+    const char *method = "linear";
+    ExtrapolationMode extrapolation = EXTRAPOLATE_CLAMP;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-x") == 0 && i + 1 < argc) {
+            x_arg = argv[++i];
+        } else if (strcmp(argv[i], "-y") == 0 && i + 1 < argc) {
+            y_arg = argv[++i];
+        } else if (strcmp(argv[i], "--extrapolate") == 0 && i + 1 < argc) {
+            extrapolation = parseExtrapolationMode(argv[++i]);
+        } else if (strcmp(argv[i], "--queries") == 0 && i + 1 < argc) {
+            query_path = argv[++i];
+        } else if (strcmp(argv[i], "--method") == 0 && i + 1 < argc) {
+            method = argv[++i];
+        } else if (!filename && argv[i][0] != '-') {
+            filename = argv[i];
+        } else {
+            filename = NULL;
+            break;
+        }
+    }
+    int use_spline = strcmp(method, "spline") == 0 || strcmp(method, "pchip") == 0;
+    if (!filename || !x_arg || !y_arg || (!use_spline && strcmp(method, "linear") != 0)) {
+        printf("Penggunaan: curve_fitting interp FILE.csv -x KOLOM -y KOLOM [--method linear|spline|pchip]\n"
+               "                             [--extrapolate clamp|linear|nan]\n"
+               "                             [--queries FILE]   (default: query dari stdin)\n");
+        return 1;
+    }
+
+    Dataset dataset;
+    CFStatus load_status = loadDataset(filename, &dataset, 0, NULL);
+    if (load_status != CF_OK) {
+        printStatusError(load_status, filename);
+        return 1;
+    }
+    int x_column = resolveColumnArg(x_arg, dataset.columns, dataset.num_columns);
+    int y_column = resolveColumnArg(y_arg, dataset.columns, dataset.num_columns);
+    if (x_column < 0 || y_column < 0 || x_column >= dataset.num_columns || y_column >= dataset.num_columns) {
+        printf("Error: kolom tidak ditemukan\n");
+        freeDataset(&dataset);
+        return 1;
+    }
+
+    // Spline memakai indeks terurut yang sama di dalam struct Spline
+    Spline spline;
+    InterpIndex index;
+    int status;
+    if (use_spline) {
+        SplineKind kind = strcmp(method, "pchip") == 0 ? SPLINE_PCHIP : SPLINE_NATURAL;
+        status = splineBuild(&spline, dataset.values[x_column], dataset.values[y_column], 1, dataset.num_rows, kind,
+                             extrapolation);
+    } else {
+        status = interpIndexBuild(&index, dataset.values[x_column], dataset.values[y_column], 1, dataset.num_rows,
+                                  extrapolation);
+    }
+    freeDataset(&dataset);
+    if (status != 0) {
+        printf("Error: tidak ada titik data yang valid\n");
+        return 1;
+    }
+
+    FILE *in = query_path ? fopen(query_path, "r") : stdin;
+    if (!in) {
+        printf("Error membuka file %s\n", query_path);
+        use_spline ? splineFree(&spline) : interpIndexFree(&index);
+        return 1;
+    }
+    size_t num_queries = 0;
+    double *queries = readQueries(in, &num_queries);
+    if (in != stdin) {
+        fclose(in);
+    }
+    double *values = (double *)malloc((num_queries ? num_queries : 1) * sizeof(double));
+    if (!queries || !values) {
+        printf("Error: memori tidak cukup\n");
+        free(queries);
+        free(values);
+        use_spline ? splineFree(&spline) : interpIndexFree(&index);
+        return 1;
+    }
+
+    if (use_spline) {
+        splineEvalBatch(&spline, queries, values, num_queries);
+    } else {
+        interpIndexLinearBatch(&index, queries, values, num_queries);
+    }
+    for (size_t i = 0; i < num_queries; i++) {
+        printf("%.10g,%.10g\n", queries[i], values[i]);
+    }
+
+    free(queries);
+    free(values);
+    use_spline ? splineFree(&spline) : interpIndexFree(&index);
+    return 0;
+}
+
+// "linear", "poly"/"polynomial" atau "logistic"; nama lain dianggap linear
+static RegressionType parseRegressionTypeArg(const char *name) {
+    if (strncmp(name, "poly", 4) == 0) {
+        return REGRESSION_POLYNOMIAL;
+    }
+    return strcmp(name, "logistic") == 0 ? REGRESSION_LOGISTIC : REGRESSION_LINEAR;
+}
+
+// Fit dari CSV lalu simpan hasilnya sebagai ModelFile (termasuk asal data). Return 0 jika berhasil.
+static int fitModelFile(const char *filename, const char *x_arg, const char *y_arg, RegressionType type, int degree,
+                        int num_threads, ModelFile *model) {
+    Dataset dataset;
+    CFStatus load_status = loadDataset(filename, &dataset, num_threads, NULL);
+    if (load_status != CF_OK) {
+        printStatusError(load_status, filename);
+        return -1;
+    }
+    int x_column = resolveColumnArg(x_arg, dataset.columns, dataset.num_columns);
+    int y_column = resolveColumnArg(y_arg, dataset.columns, dataset.num_columns);
+    if (x_column < 0 || y_column < 0 || x_column >= dataset.num_columns || y_column >= dataset.num_columns) {
+        printf("Error: kolom tidak ditemukan\n");
+        freeDataset(&dataset);
+        return -1;
+    }
+
+    RegressionResult result = datasetRegression(&dataset, x_column, y_column, type, degree);
+    const double *x, *y;
+    double *scratch = NULL;
+    int num_points = 0;
+    datasetPairColumns(&dataset, x_column, y_column, &x, &y, &num_points, &scratch);
+    free(scratch);
+    int status = isnan(result.r_squared) ? -1
+                                         : modelFileFromResult(&result, filename, dataset.columns[x_column].name,
+                                                               dataset.columns[y_column].name, (uint64_t)num_points,
+                                                               model);
+    freeRegressionResult(&result);
+    freeDataset(&dataset);
+    if (status != 0) {
+        printf("Error: regresi tidak dapat dihitung\n");
+    }
+    return status;
+}
+
+// Cetak persamaan dan R-squared dari file model
+static void printModelSummary(FILE *out, const ModelFile *model) {
+    RegressionResult result = modelFileToResult(model);
+    printRegressionSummary(out, &result);
+    freeRegressionResult(&result);
+}
+
+// Mode multi: least squares berganda atas beberapa kolom x, opsional berbobot dan dengan suku pangkat
+// per kolom ("-x luas,umur:2" = luas + umur + umur²)
+static int runMultiCommand(int argc, char *argv[]) {
+    const char *filename = NULL;
+    const char *x_arg = NULL;
+    const char *y_arg = NULL;
+    const char *weight_arg = NULL;
+    const char *json_path = NULL;
+    int num_threads = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-x") == 0 && i + 1 < argc) {
+            x_arg = argv[++i];
+        } else if (strcmp(argv[i], "-y") == 0 && i + 1 < argc) {
+            y_arg = argv[++i];
+        } else if (strcmp(argv[i], "--weights") == 0 && i + 1 < argc) {
+            weight_arg = argv[++i];
+        } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            num_threads = atoi(argv[++i]);
+        } else if (!filename && argv[i][0] != '-') {
+            filename = argv[i];
+        } else {
+            filename = NULL;
+            break;
+        }
+    }
+    if (!filename || !x_arg || !y_arg) {
+        printf("Penggunaan: curve_fitting multi FILE.csv -x KOLOM[:DERAJAT],KOLOM[:DERAJAT],... -y KOLOM\n"
+               "                             [--weights KOLOM] [--json FILE|-] [--threads N]\n");
+        return 1;
+    }
+
+    Dataset dataset;
+    CFStatus status = loadDataset(filename, &dataset, num_threads, NULL);
+    if (status != CF_OK) {
+        printStatusError(status, filename);
+        return 1;
+    }
+
+    // Daftar kolom x dipisah koma, masing-masing boleh diberi ":derajat"
+    int x_columns[MAX_COLUMNS], degrees[MAX_COLUMNS], num_x = 0, num_terms = 1;
+    char list[1024];
+    snprintf(list, sizeof(list), "%s", x_arg);
+    int bad_column = 0, too_many = 0;
+    for (char *item = strtok(list, ","); item; item = strtok(NULL, ",")) {
+        if (num_x == MAX_COLUMNS) {
+            too_many = 1;
+            break;
+        }
+        char *colon = strrchr(item, ':');
+        int degree = 1;
+        if (colon) {
+            *colon = '\0';
+            degree = atoi(colon + 1);
+        }
+        int column = resolveColumnArg(item, dataset.columns, dataset.num_columns);
+        bad_column = column < 0 || column >= dataset.num_columns || degree < 1 || degree > MAX_POLY_DEGREE;
+        if (bad_column) {
+            break;
+        }
+        x_columns[num_x] = column;
+        degrees[num_x++] = degree;
+        num_terms += degree;
+    }
+    if (too_many || num_terms > LSQ_MAX_TERMS) {
+        printf("Error: terlalu banyak suku (maksimal %d kolom x dan %d suku termasuk intercept)\n", MAX_COLUMNS,
+               LSQ_MAX_TERMS);
+        freeDataset(&dataset);
+        return 1;
+    }
+    int y_column = resolveColumnArg(y_arg, dataset.columns, dataset.num_columns);
+    int weight_column = weight_arg ? resolveColumnArg(weight_arg, dataset.columns, dataset.num_columns) : -1;
+    if (bad_column || num_x == 0 || y_column < 0 || y_column >= dataset.num_columns ||
+        (weight_arg && (weight_column < 0 || weight_column >= dataset.num_columns))) {
+        printf("Error: kolom tidak ditemukan atau derajat tidak valid\n");
+        freeDataset(&dataset);
+        return 1;
+    }
+
+    LeastSquaresResult result;
+    ThreadPool *pool = num_threads > 0 ? threadPoolCreate(num_threads) : threadPoolShared();
+    double start = monotonicSeconds();
+    status = datasetLeastSquares(&dataset, x_columns, degrees, num_x, y_column, weight_column, pool, &result);
+    double seconds = monotonicSeconds() - start;
+    if (num_threads > 0) {
+        threadPoolDestroy(pool);
+    }
+    if (status != CF_OK) {
+        printStatusError(status, status == CF_ERROR_ARGUMENT ? "kolom x kolinear" : filename);
+        freeDataset(&dataset);
+        return 1;
+    }
+
+    if (!json_path || strcmp(json_path, "-") != 0) {
+        printf("\nHasil Regresi Berganda (%zu baris, %.3f ms%s):\n", result.num_points, seconds * 1000.0,
+               weight_column >= 0 ? ", berbobot" : "");
+        printf("%s = %.6g", dataset.columns[y_column].name, result.coefficients[0]);
+        int k = 1;
+        for (int j = 0; j < num_x; j++) {
+            for (int d = 1; d <= degrees[j]; d++, k++) {
+                printf(" + %.6g*%s", result.coefficients[k], dataset.columns[x_columns[j]].name);
+                if (d > 1) {
+                    printf("^%d", d);
+                }
+            }
+        }
+        printf("\nR-squared: %.6f\nAdjusted R-squared: %.6f\nStd residual: %.6g\nSolver: %s\n", result.r_squared,
+               result.adjusted_r_squared, result.residual_std, result.used_qr ? "QR" : "Cholesky");
+    }
+    if (json_path) {
+        FILE *out = strcmp(json_path, "-") == 0 ? stdout : fopen(json_path, "w");
+        if (!out) {
+            printf("Error membuka file %s\n", json_path);
+            freeDataset(&dataset);
+            return 1;
+        }
+        writeLeastSquaresJSON(out, &dataset, x_columns, y_column, weight_column, &result);
+        if (out != stdout) {
+            fclose(out);
+        }
+    }
+    freeDataset(&dataset);
+    return 0;
+}
+
+// Mode group: file format panjang (kolom kunci + x + y), satu model per nilai kunci dalam satu lintasan
+static int runGroupCommand(int argc, char *argv[]) {
+    const char *filename = NULL;
+    const char *key_arg = NULL;
+    const char *x_arg = NULL;
+    const char *y_arg = NULL;
+    const char *output_path = NULL;
+    const char *format = "csv";
+    RegressionType type = REGRESSION_LINEAR;
+    int degree = 2;
+    int num_threads = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--by") == 0 && i + 1 < argc) {
+            key_arg = argv[++i];
+        } else if (strcmp(argv[i], "-x") == 0 && i + 1 < argc) {
+            x_arg = argv[++i];
+        } else if (strcmp(argv[i], "-y") == 0 && i + 1 < argc) {
+            y_arg = argv[++i];
+        } else if (strcmp(argv[i], "--type") == 0 && i + 1 < argc) {
+            type = parseRegressionTypeArg(argv[++i]);
+        } else if (strcmp(argv[i], "--degree") == 0 && i + 1 < argc) {
+            degree = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            format = argv[++i];
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            output_path = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            num_threads = atoi(argv[++i]);
+        } else if (!filename && argv[i][0] != '-') {
+            filename = argv[i];
+        } else {
+            filename = NULL;
+            break;
+        }
+    }
+    if (!filename || !key_arg || !x_arg || !y_arg || degree < 1 || degree > MAX_POLY_DEGREE ||
+        (strcmp(format, "csv") != 0 && strcmp(format, "json") != 0)) {
+        printf("Penggunaan: curve_fitting group FILE.csv --by KOLOM -x KOLOM -y KOLOM [--type linear|poly|logistic]\n"
+               "                             [--degree D] [--format csv|json] [--output FILE] [--threads N]\n");
+        return 1;
+    }
+
+    int num_columns = 0;
     ColumnInfo *columns = readCSVHeader(filename, &num_columns);
     if (!columns) {
-        printf("Error membaca header file\n");
+        printStatusError(CF_ERROR_IO, filename);
+        return 1;
+    }
+    int key_column = resolveColumnArg(key_arg, columns, num_columns);
+    int x_column = resolveColumnArg(x_arg, columns, num_columns);
+    int y_column = resolveColumnArg(y_arg, columns, num_columns);
+    if (key_column < 0 || x_column < 0 || y_column < 0 || key_column >= num_columns || x_column >= num_columns ||
+        y_column >= num_columns) {
+        printf("Error: kolom tidak ditemukan\n");
+        free(columns);
         return 1;
     }
 
-    // Tampilkan pilihan kolom
-    printf("\nKolom yang tersedia:\n");
-    for (int i = 0; i < num_columns; i++) {
-        printf("%d. %s\n", i + 1, columns[i].name);
+    GroupFitEntry *entries = NULL;
+    size_t num_groups = 0;
+    CSVLoadStats stats;
+    ThreadPool *pool = num_threads > 0 ? threadPoolCreate(num_threads) : threadPoolShared();
+    CFStatus status = groupFitFile(filename, key_column, x_column, y_column, type, degree, pool, &entries,
+                                   &num_groups, &stats);
+    if (num_threads > 0) {
+        threadPoolDestroy(pool);
+    }
+    if (status != CF_OK) {
+        printStatusError(status, filename);
+        free(columns);
+        return 1;
     }
 
-    // Pilih kolom untuk sumbu X
-    int x_choice;
-    do {
-        printf("\nPilih kolom untuk sumbu X (1-%d): ", num_columns);
-        scanf("%d", &x_choice);
-    } while (x_choice < 1 || x_choice > num_columns);
+    // Ringkasan ke stderr jika tabel ditulis ke stdout, supaya output tetap bisa di-pipe
+    FILE *out = output_path ? fopen(output_path, "w") : stdout;
+    FILE *info = output_path ? stdout : stderr;
+    if (!out) {
+        printStatusError(CF_ERROR_IO, output_path);
+        freeGroupFit(entries, num_groups);
+        free(columns);
+        return 1;
+    }
+    if (strcmp(format, "json") == 0) {
+        writeGroupFitJSON(out, columns[key_column].name, entries, num_groups);
+    } else {
+        writeGroupFitCSV(out, columns[key_column].name, entries, num_groups);
+    }
+    fprintf(info, "%zu grup dari %zu baris (%zu dilewati) dalam %.3f detik: %.2f MB/s, %.0f baris/s\n", num_groups,
+            stats.rows, stats.rows_skipped, stats.seconds, stats.mb_per_sec, stats.rows_per_sec);
+    if (out != stdout && fclose(out) != 0) {
+        printStatusError(CF_ERROR_IO, output_path);
+        status = CF_ERROR_IO;
+    }
+    freeGroupFit(entries, num_groups);
+    free(columns);
+    return status == CF_OK ? 0 : 1;
+}
 
-    // Pilih kolom untuk sumbu Y
-    int y_choice;
-    do {
-        printf("Pilih kolom untuk sumbu Y (1-%d): ", num_columns);
-        scanf("%d", &y_choice);
-    } while (y_choice < 1 || y_choice > num_columns);
+// Mode autofit: validasi silang k-fold atas linear, polynomial 2..D dan logistic, cetak scoreboard dan
+// model terpilih (opsional disimpan sebagai file model untuk predict --model)
+static int runAutoFitCommand(int argc, char *argv[]) {
+    const char *filename = NULL;
+    const char *x_arg = NULL;
+    const char *y_arg = NULL;
+    const char *save_path = NULL;
+    const char *json_path = NULL;
+    int num_threads = 0;
+    int usage_error = 0;
+    AutoFitOptions options;
+    defaultAutoFitOptions(&options);
 
-    // Konversi pilihan ke indeks (0-based)
-    int x_column = x_choice - 1;
-    int y_column = y_choice - 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-x") == 0 && i + 1 < argc) {
+            x_arg = argv[++i];
+        } else if (strcmp(argv[i], "-y") == 0 && i + 1 < argc) {
+            y_arg = argv[++i];
+        } else if (strcmp(argv[i], "--folds") == 0 && i + 1 < argc) {
+            options.folds = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--max-degree") == 0 && i + 1 < argc) {
+            options.max_degree = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--criterion") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "cv") == 0) {
+                options.criterion = AUTOFIT_CRITERION_CV;
+            } else if (strcmp(argv[i], "aic") == 0) {
+                options.criterion = AUTOFIT_CRITERION_AIC;
+            } else if (strcmp(argv[i], "bic") == 0) {
+                options.criterion = AUTOFIT_CRITERION_BIC;
+            } else {
+                usage_error = 1;
+            }
+        } else if (strcmp(argv[i], "--no-logistic") == 0) {
+            options.include_logistic = 0;
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            options.seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--save") == 0 && i + 1 < argc) {
+            save_path = argv[++i];
+        } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            num_threads = atoi(argv[++i]);
+        } else if (!filename && argv[i][0] != '-') {
+            filename = argv[i];
+        } else {
+            usage_error = 1;
+        }
+    }
+    if (usage_error || !filename || !x_arg || !y_arg || options.folds < 2 || options.folds > AUTOFIT_MAX_FOLDS ||
+        options.max_degree < 1 || options.max_degree > MAX_POLY_DEGREE) {
+        printf("Penggunaan: curve_fitting autofit FILE.csv -x KOLOM -y KOLOM [--folds 2-%d] [--criterion cv|aic|bic]\n"
+               "                             [--max-degree D] [--no-logistic] [--seed S] [--save MODEL.bin]\n"
+               "                             [--json FILE|-] [--threads N]\n",
+               AUTOFIT_MAX_FOLDS);
+        return 1;
+    }
+
+    Dataset dataset;
+    CFStatus status = loadDataset(filename, &dataset, num_threads, NULL);
+    if (status != CF_OK) {
+        printStatusError(status, filename);
+        return 1;
+    }
+    int x_column = resolveColumnArg(x_arg, dataset.columns, dataset.num_columns);
+    int y_column = resolveColumnArg(y_arg, dataset.columns, dataset.num_columns);
+    if (x_column < 0 || y_column < 0 || x_column >= dataset.num_columns || y_column >= dataset.num_columns) {
+        printf("Error: kolom tidak ditemukan\n");
+        freeDataset(&dataset);
+        return 1;
+    }
+    const double *x, *y;
+    double *scratch = NULL;
+    int num_points = 0;
+    if (datasetPairColumns(&dataset, x_column, y_column, &x, &y, &num_points, &scratch) != 0) {
+        printStatusError(CF_ERROR_MEMORY, NULL);
+        freeDataset(&dataset);
+        return 1;
+    }
+
+    AutoFitResult result;
+    ThreadPool *pool = num_threads > 0 ? threadPoolCreate(num_threads) : threadPoolShared();
+    double start = monotonicSeconds();
+    status = autoFit(x, y, 1, (size_t)num_points, &options, pool, &result);
+    double seconds = monotonicSeconds() - start;
+    if (num_threads > 0) {
+        threadPoolDestroy(pool);
+    }
+    free(scratch);
+    if (status != CF_OK) {
+        printStatusError(status, filename);
+        freeDataset(&dataset);
+        return 1;
+    }
+
+    const char *x_name = dataset.columns[x_column].name;
+    const char *y_name = dataset.columns[y_column].name;
+    if (!json_path || strcmp(json_path, "-") != 0) {
+        printf("\nValidasi silang %d-fold atas %zu baris (%.3f ms), kriteria %s:\n", result.folds, result.num_points,
+               seconds * 1000.0, autoFitCriterionName(result.criterion));
+        printf("  %-14s %6s %14s %12s %10s %14s %14s\n", "model", "param", "cv_rmse", "sd", "r_squared", "aic",
+               "bic");
+        for (int i = 0; i < result.num_candidates; i++) {
+            const AutoFitCandidate *c = &result.candidates[i];
+            char name[32];
+            snprintf(name, sizeof(name), c->type == REGRESSION_POLYNOMIAL ? "%s %d" : "%s", regressionTypeName(c->type),
+                     c->degree);
+            if (c->ok) {
+                printf("%c %-14s %6d %14.6g %12.4g %10.6f %14.6g %14.6g\n", i == result.best ? '*' : ' ', name,
+                       c->num_params, c->cv_rmse, c->cv_rmse_sd, c->r_squared, c->aic, c->bic);
+            } else {
+                printf("  %-14s %6d %14s\n", name, c->num_params, "gagal");
+            }
+        }
+        printf("\nModel terpilih: ");
+        printRegressionSummary(stdout, &result.model);
+    }
 
-    // Baca data dari file
+    ModelFile model;
+    if (save_path) {
+        status = modelFileFromResult(&result.model, filename, x_name, y_name, (uint64_t)num_points, &model) != 0
+                     ? CF_ERROR_ARGUMENT
+                     : modelFileSave(save_path, &model);
+        if (status != CF_OK) {
+            printStatusError(status, save_path);
+        }
+    }
+    if (json_path && status == CF_OK) {
+        FILE *out = strcmp(json_path, "-") == 0 ? stdout : fopen(json_path, "w");
+        if (out) {
+            writeAutoFitJSON(out, x_name, y_name, &result);
+            if (out != stdout) {
+                fclose(out);
+            }
+        } else {
+            printf("Error membuka file %s\n", json_path);
+            status = CF_ERROR_IO;
+        }
+    }
+    freeAutoFitResult(&result);
+    freeDataset(&dataset);
+    return status == CF_OK ? 0 : 1;
+}
+
+// Mode fit: fit sekali dari CSV, simpan model biner (untuk predict --model) dan/atau JSON
+static int runFitCommand(int argc, char *argv[]) {
+    const char *filename = NULL;
+    const char *x_arg = NULL;
+    const char *y_arg = NULL;
+    const char *save_path = NULL;
+    const char *json_path = NULL;
+    RegressionType type = REGRESSION_LINEAR;
+    int degree = 2;
+    int num_threads = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-x") == 0 && i + 1 < argc) {
+            x_arg = argv[++i];
+        } else if (strcmp(argv[i], "-y") == 0 && i + 1 < argc) {
+            y_arg = argv[++i];
+        } else if (strcmp(argv[i], "--type") == 0 && i + 1 < argc) {
+            type = parseRegressionTypeArg(argv[++i]);
+        } else if (strcmp(argv[i], "--degree") == 0 && i + 1 < argc) {
+            degree = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--save") == 0 && i + 1 < argc) {
+            save_path = argv[++i];
+        } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            num_threads = atoi(argv[++i]);
+        } else if (!filename && argv[i][0] != '-') {
+            filename = argv[i];
+        } else {
+            filename = NULL;
+            break;
+        }
+    }
+    if (!filename || !x_arg || !y_arg || degree < 1 || degree > MAX_POLY_DEGREE) {
+        printf("Penggunaan: curve_fitting fit FILE.csv -x KOLOM -y KOLOM [--type linear|poly|logistic]\n"
+               "                             [--degree D] [--save MODEL.bin] [--json FILE|-] [--threads N]\n");
+        return 1;
+    }
+
+    ModelFile model;
+    if (fitModelFile(filename, x_arg, y_arg, type, degree, num_threads, &model) != 0) {
+        return 1;
+    }
+    if (!json_path || strcmp(json_path, "-") != 0) {
+        printModelSummary(stdout, &model);
+    }
+    CFStatus status = save_path ? modelFileSave(save_path, &model) : CF_OK;
+    if (status != CF_OK) {
+        printStatusError(status, save_path);
+        return 1;
+    }
+    if (json_path) {
+        FILE *out = strcmp(json_path, "-") == 0 ? stdout : fopen(json_path, "w");
+        if (!out) {
+            printf("Error membuka file %s\n", json_path);
+            return 1;
+        }
+        modelFileWriteJSON(out, &model);
+        if (out != stdout) {
+            fclose(out);
+        }
+    }
+    return 0;
+}
+
+// Mode prediksi batch: model dari file model (--model) atau di-fit dari data, lalu seluruh
+// kolom file input dievaluasi secara paralel. Prediksi ditulis satu per baris, sejajar
+// dengan baris input.
+static int runPredictCommand(int argc, char *argv[]) {
+    const char *filename = NULL;
+    const char *model_path = NULL;
+    const char *x_arg = NULL;
+    const char *y_arg = NULL;
+    const char *input_path = NULL;
+    const char *output_path = NULL;
+    RegressionType type = REGRESSION_LINEAR;
+    int degree = 2;
+    int input_column = 1;
+    int num_threads = 0;
+    int digits = 10;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-x") == 0 && i + 1 < argc) {
+            x_arg = argv[++i];
+        } else if (strcmp(argv[i], "-y") == 0 && i + 1 < argc) {
+            y_arg = argv[++i];
+        } else if (strcmp(argv[i], "--model") == 0 && i + 1 < argc) {
+            model_path = argv[++i];
+        } else if (strcmp(argv[i], "--type") == 0 && i + 1 < argc) {
+            type = parseRegressionTypeArg(argv[++i]);
+        } else if (strcmp(argv[i], "--degree") == 0 && i + 1 < argc) {
+            degree = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--input") == 0 && i + 1 < argc) {
+            input_path = argv[++i];
+        } else if (strcmp(argv[i], "--column") == 0 && i + 1 < argc) {
+            input_column = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            output_path = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            num_threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--digits") == 0 && i + 1 < argc) {
+            digits = atoi(argv[++i]);
+        } else if (!filename && argv[i][0] != '-') {
+            filename = argv[i];
+        } else {
+            filename = NULL;
+            model_path = NULL;
+            break;
+        }
+    }
+    int from_data = filename && x_arg && y_arg;
+    if ((!from_data && !model_path) || !input_path || input_column < 1 || degree < 1 || degree > MAX_POLY_DEGREE ||
+        digits < 1 || digits > 17) {
+        printf("Penggunaan: curve_fitting predict FILE.csv -x KOLOM -y KOLOM --input FILE [--column N]\n"
+               "                             [--type linear|poly|logistic] [--degree D] [--output FILE]\n"
+               "                             [--threads N] [--digits 1-17]\n"
+               "           curve_fitting predict --model MODEL.bin --input FILE [opsi]\n");
+        return 1;
+    }
+
+    // File model cukup dipetakan ke memori; tanpa --model, fit dulu dari data
+    ModelFile fitted;
+    MappedFile mf = {NULL, 0, -1};
+    const ModelFile *model = NULL;
+    if (model_path) {
+        CFStatus map_status = modelFileMap(model_path, &mf, &model);
+        if (map_status != CF_OK) {
+            printStatusError(map_status, model_path);
+            return 1;
+        }
+    } else if (fitModelFile(filename, x_arg, y_arg, type, degree, num_threads, &fitted) == 0) {
+        model = &fitted;
+    }
+    if (!model) {
+        return 1;
+    }
+    CompiledModel compiled;
+    modelFileCompile(model, &compiled);
+
+    // Ringkasan ke stderr jika prediksi ditulis ke stdout, supaya output tetap bisa di-pipe
+    FILE *out = output_path ? fopen(output_path, "w") : stdout;
+    FILE *info = output_path ? stdout : stderr;
+    if (!out) {
+        printf("Error membuka file %s\n", output_path);
+        unmapFile(&mf);
+        return 1;
+    }
+    printModelSummary(info, model);
+    unmapFile(&mf);
+
+    ThreadPool *pool = num_threads > 0 ? threadPoolCreate(num_threads) : threadPoolShared();
+    CSVLoadStats stats;
+    CFStatus status = predictCSVFile(&compiled, input_path, input_column - 1, out, pool, digits, &stats);
+    if (num_threads > 0) {
+        threadPoolDestroy(pool);
+    }
+    if (out != stdout && fclose(out) != 0 && status == CF_OK) {
+        status = CF_ERROR_IO;
+    }
+    if (status != CF_OK) {
+        fprintf(info, "Error: prediksi gagal: %s\n", cfStatusMessage(status));
+        return 1;
+    }
+    fprintf(info, "Diprediksi %zu baris (%zu bukan angka) dalam %.3f detik: %.2f MB/s, %.0f baris/s\n",
+            stats.rows, stats.rows_skipped, stats.seconds, stats.mb_per_sec, stats.rows_per_sec);
+    return 0;
+}
+
+// Tanya bilangan bulat dalam [min, max] sampai jawabannya valid. Return -1 jika input habis (EOF).
+static int promptRange(const char *prompt, int min, int max, int *value) {
+    for (;;) {
+        printf("%s (%d-%d): ", prompt, min, max);
+        int matched = scanf("%d", value);
+        if (matched == EOF) {
+            return -1;
+        }
+        if (matched == 1 && *value >= min && *value <= max) {
+            return 0;
+        }
+        scanf("%*[^\n]"); // Buang sisa baris yang bukan angka
+    }
+}
+
+int main(int argc, char *argv[]) {
+    argc = takeMetricsOption(argc, argv);
+    if (argc > 1 && strcmp(argv[1], "batch") == 0) {
+        return runBatchCommand(argc - 1, argv + 1);
+    }
+    if (argc > 1 && strcmp(argv[1], "stream") == 0) {
+        return runStreamCommand(argc - 1, argv + 1);
+    }
+    if (argc > 1 && strcmp(argv[1], "update") == 0) {
+        return runUpdateCommand(argc - 1, argv + 1);
+    }
+    if (argc > 1 && strcmp(argv[1], "rolling") == 0) {
+        return runRollingCommand(argc - 1, argv + 1);
+    }
+    if (argc > 1 && strcmp(argv[1], "interp") == 0) {
+        return runInterpCommand(argc - 1, argv + 1);
+    }
+    if (argc > 1 && strcmp(argv[1], "multi") == 0) {
+        return runMultiCommand(argc - 1, argv + 1);
+    }
+    if (argc > 1 && strcmp(argv[1], "group") == 0) {
+        return runGroupCommand(argc - 1, argv + 1);
+    }
+    if (argc > 1 && strcmp(argv[1], "autofit") == 0) {
+        return runAutoFitCommand(argc - 1, argv + 1);
+    }
+    if (argc > 1 && strcmp(argv[1], "fit") == 0) {
+        return runFitCommand(argc - 1, argv + 1);
+    }
+    if (argc > 1 && strcmp(argv[1], "predict") == 0) {
+        return runPredictCommand(argc - 1, argv + 1);
+    }
+
+    // Opsi baris perintah. Nilai yang tidak diberikan lewat opsi ditanyakan secara interaktif;
+    // jika file, kolom dan jenis regresi lengkap, program berjalan tanpa prompt sama sekali.
+    const char *filename = NULL;
+    const char *x_arg = NULL;
+    const char *y_arg = NULL;
+    const char *type_arg = NULL;
+    const char *plot_path = NULL;
+    int degree = 0;
+    int num_threads = 0;
+    int use_gnuplot = 0;
+    int usage_error = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-x") == 0 && i + 1 < argc) {
+            x_arg = argv[++i];
+        } else if (strcmp(argv[i], "-y") == 0 && i + 1 < argc) {
+            y_arg = argv[++i];
+        } else if (strcmp(argv[i], "--type") == 0 && i + 1 < argc) {
+            type_arg = argv[++i];
+        } else if (strcmp(argv[i], "--degree") == 0 && i + 1 < argc) {
+            degree = atoi(argv[++i]);
+            usage_error |= degree < 1 || degree > MAX_POLY_DEGREE;
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            num_threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--plot") == 0 && i + 1 < argc) {
+            plot_path = argv[++i];
+        } else if (strcmp(argv[i], "--gnuplot") == 0) {
+            use_gnuplot = 1;
+        } else if (!filename && argv[i][0] != '-') {
+            filename = argv[i];
+        } else {
+            usage_error = 1;
+        }
+    }
+    if (usage_error) {
+        printf("Penggunaan: %s [FILE.csv] [-x KOLOM] [-y KOLOM] [--type linear|poly|logistic] [--degree D]\n"
+               "           %*s [--threads N] [--plot FILE.png|FILE.svg] [--gnuplot]\n"
+               "           %s batch FILE.csv [opsi]\n"
+               "           %s stream FILE.csv|- -x KOLOM -y KOLOM [opsi]\n"
+               "           %s update FILE.csv --state FILE.state [opsi]\n"
+               "           %s rolling FILE.csv -x KOLOM -y KOLOM --window W [opsi]\n"
+               "           %s interp FILE.csv -x KOLOM -y KOLOM [opsi] < query.txt\n"
+               "           %s multi FILE.csv -x KOLOM[:D],KOLOM[:D],... -y KOLOM [--weights KOLOM] [opsi]\n"
+               "           %s group FILE.csv --by KOLOM -x KOLOM -y KOLOM [--type linear|poly|logistic] [opsi]\n"
+               "           %s autofit FILE.csv -x KOLOM -y KOLOM [--folds K] [--criterion cv|aic|bic] [opsi]\n"
+               "           %s fit FILE.csv -x KOLOM -y KOLOM [--save MODEL.bin] [--json FILE]\n"
+               "           %s predict FILE.csv -x KOLOM -y KOLOM --input FILE [opsi]\n"
+               "           %s predict --model MODEL.bin --input FILE [opsi]\n"
+               "Opsi global: --metrics FILE.json|FILE.prom|- (waktu per tahap dan counter, ditulis saat selesai)\n",
+               argv[0], (int)strlen(argv[0]), "", argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0],
+               argv[0], argv[0], argv[0], argv[0]);
+        return 1;
+    }
+    int interactive = !filename || !x_arg || !y_arg || !type_arg;
+    if (interactive && !plot_path) {
+        plot_path = "plot.png";
+    }
+
+    char filename_buffer[256];
+    if (!filename) {
+        printf("Masukkan nama file CSV: ");
+        if (scanf("%255s", filename_buffer) != 1) {
+            return 1;
+        }
+        filename = filename_buffer;
+    }
+
+    // Baca header dan semua kolom numerik dalam satu lintasan
+    Dataset dataset;
+    CSVLoadStats load_stats;
+    CFStatus load_status = loadDataset(filename, &dataset, num_threads, &load_stats);
+    if (load_status != CF_OK) {
+        printStatusError(load_status, filename);
+        return 1;
+    }
+    printf("\nDibaca %zu baris dalam %.3f detik: %.2f MB/s, %.0f baris/s\n",
+           load_stats.rows, load_stats.seconds, load_stats.mb_per_sec, load_stats.rows_per_sec);
+    int num_columns = dataset.num_columns;
+    ColumnInfo *columns = dataset.columns;
+
+    // Kolom dari opsi (nomor atau nama), atau pilih dari daftar
+    int x_column = x_arg ? resolveColumnArg(x_arg, columns, num_columns) : -1;
+    int y_column = y_arg ? resolveColumnArg(y_arg, columns, num_columns) : -1;
+    if ((x_arg && (x_column < 0 || x_column >= num_columns)) || (y_arg && (y_column < 0 || y_column >= num_columns))) {
+        printf("Error: kolom tidak ditemukan\n");
+        freeDataset(&dataset);
+        return 1;
+    }
+    if (!x_arg || !y_arg) {
+        printf("\nKolom yang tersedia:\n");
+        for (int i = 0; i < num_columns; i++) {
+            printf("%d. %s\n", i + 1, columns[i].name);
+        }
+        int choice;
+        if (!x_arg) {
+            if (promptRange("\nPilih kolom untuk sumbu X", 1, num_columns, &choice) != 0) {
+                freeDataset(&dataset);
+                return 1;
+            }
+            x_column = choice - 1;
+        }
+        if (!y_arg) {
+            if (promptRange("Pilih kolom untuk sumbu Y", 1, num_columns, &choice) != 0) {
+                freeDataset(&dataset);
+                return 1;
+            }
+            y_column = choice - 1;
+        }
+    }
+
+    // Ambil pasangan kolom dari dataset
     int num_points;
-    DataPoint *data = readCSVData(filename, x_column, y_column, &num_points);
+    DataPoint *data = datasetToPoints(&dataset, x_column, y_column, &num_points);
     if (!data) {
         printf("Error membaca data\n");
-        free(columns);
+        freeDataset(&dataset);
         return 1;
     }
 
     // Pilih jenis regresi
-    int regression_type;
-    printf("\nPilih jenis regresi:\n");
-    printf("1. Linear\n");
-    printf("2. Polynomial\n");
-    printf("3. Logistic\n");
-    printf("Pilihan (1-3): ");
-    scanf("%d", &regression_type);
+    RegressionType type;
+    if (type_arg) {
+        type = parseRegressionTypeArg(type_arg);
+    } else {
+        int regression_type;
+        printf("\nPilih jenis regresi:\n");
+        printf("1. Linear\n");
+        printf("2. Polynomial\n");
+        printf("3. Logistic\n");
+        if (promptRange("Pilihan", 1, 3, &regression_type) != 0) {
+            freeData(data);
+            freeDataset(&dataset);
+            return 1;
+        }
+        type = regression_type == 1 ? REGRESSION_LINEAR
+                                    : (regression_type == 2 ? REGRESSION_POLYNOMIAL : REGRESSION_LOGISTIC);
+    }
 
     RegressionResult result;
-    int degree = 1; // Default degree
-
-    if (regression_type == 1) {
+    if (type == REGRESSION_LINEAR) {
         result = linearRegression(data, num_points);
 
         printf("\nHasil Analisis Regresi Linear:\n");
         printf("Persamaan: y = %.4fx + %.4f\n", result.slope, result.intercept);
         printf("R-squared: %.4f\n", result.r_squared);
-    } else if (regression_type == 2) {
-        do {
-            printf("\nMasukkan derajat polynomial (1-%d): ", MAX_POLY_DEGREE);
-            scanf("%d", &degree);
-        } while (degree < 1 || degree > MAX_POLY_DEGREE);
+    } else if (type == REGRESSION_POLYNOMIAL) {
+        if (degree == 0 && interactive) {
+            printf("\n");
+            if (promptRange("Masukkan derajat polynomial", 1, MAX_POLY_DEGREE, &degree) != 0) {
+                freeData(data);
+                freeDataset(&dataset);
+                return 1;
+            }
+        } else if (degree == 0) {
+            degree = 2;
+        }
 
         result = polynomialRegression(data, num_points, degree);
 
@@ -84,54 +1372,64 @@ int main() {
         }
         printf("\nR-squared: %.4f\n", result.r_squared);
     } else {
-        result = logisticRegression(data, num_points);
+        LMReport report;
+        result = logisticRegressionWithReport(&data[0].x, &data[0].y, 2, num_points, NULL, &report);
+        printf("\n%s setelah %d iterasi (%d evaluasi, %.3f ms)\n", lmStatusName(report.status),
+               report.iterations, report.evaluations, report.seconds * 1000.0);
+
+        // Contoh prediksi untuk verifikasi
+        printf("\nContoh prediksi:\n");
+        int sample_step = num_points >= 5 ? num_points / 5 : 1;
+        for (int i = 0; i < num_points; i += sample_step) {
+            double y_pred = result.c / (1 + result.a * exp(-result.b * (data[i].x - result.mean_x)));
+            printf("x=%.2f: y_aktual=%.4f, y_prediksi=%.4f\n", data[i].x, data[i].y, y_pred);
+        }
 
         printf("\nHasil Analisis Regresi Logistic:\n");
-        printf("Persamaan: y = %.4f / (1 + %.4f * e^(-%.4f * x))\n",
-               result.c, result.a, result.b);
+        printf("Persamaan: y = %.4f / (1 + %.4f * e^(-%.4f * (x - %.4f)))\n",
+               result.c, result.a, result.b, result.mean_x);
         printf("R-squared: %.4f\n", result.r_squared);
     }
 
-    // Buat plot
-    plotWithGNUPlot(data, num_points, &result);
+    // Buat plot: renderer bawaan, atau gnuplot jika diminta. Tanpa --plot, mode non-interaktif tidak membuat plot.
+    if (plot_path) {
+        PlotOptions plot_options;
+        defaultPlotOptions(&plot_options);
+        plot_options.x_label = columns[x_column].name;
+        plot_options.y_label = columns[y_column].name;
+        CFStatus plot_status =
+            use_gnuplot ? gnuplotPlot(plot_path, &data[0].x, &data[0].y, 2, num_points, &result, &plot_options)
+                        : renderPlot(plot_path, &data[0].x, &data[0].y, 2, num_points, &result, &plot_options);
+        if (plot_status == CF_OK) {
+            printf("Plot telah disimpan ke file '%s'\n", plot_path);
+        } else {
+            printf("Error: gagal menulis plot ke %s: %s\n", plot_path, cfStatusMessage(plot_status));
+        }
+    }
 
-    // Interpolasi
-    char choice;
-    do {
+    // Interpolasi: model dikompilasi sekali, setiap query hanya evaluasi Horner/logistic
+    CompiledModel model;
+    if (interactive && compileModel(&result, &model) != 0) {
+        printf("Error: model tidak valid untuk prediksi\n");
+        freeData(data);
+        freeDataset(&dataset);
+        freeRegressionResult(&result);
+        return 1;
+    }
+    while (interactive) {
         double x;
+        char choice;
         printf("\nMasukkan nilai %s untuk interpolasi (atau 'q' untuk keluar): ", columns[x_column].name);
-        if (scanf(" %lf", &x) == 1) {
-            double y;
-            double mean_x = 0;
-
-            switch (regression_type) {
-            case 1: // Linear
-                y = result.slope * x + result.intercept;
-                break;
-            case 2: // Polynomial
-                y = 0;
-                for (int i = 0; i <= degree; i++) {
-                    y += result.coefficients[i] * pow(x, i);
-                }
-                break;
-            case 3: // Logistic
-                for (int i = 0; i < num_points; i++) {
-                    mean_x += data[i].x;
-                }
-                mean_x /= num_points;
-                y = result.c / (1 + result.a * exp(-result.b * (x - mean_x)));
-                break;
-            }
-            printf("Nilai %s yang diinterpolasi: %.2f\n", columns[y_column].name, y);
-        } else {
-            scanf(" %c", &choice);
-            if (choice == 'q' || choice == 'Q')
-                break;
+        int matched = scanf(" %lf", &x);
+        if (matched == 1) {
+            printf("Nilai %s yang diinterpolasi: %.2f\n", columns[y_column].name, compiledModelEvalOne(&model, x));
+        } else if (matched == EOF || scanf(" %c", &choice) != 1 || choice == 'q' || choice == 'Q') {
+            break;
         }
-    } while (1);
+    }
 
     freeData(data);
-    free(columns);
+    freeDataset(&dataset);
     freeRegressionResult(&result);
 
     return 0;
@@ -0,0 +1,108 @@
+#include "metrics.h"
+
+int metrics_enabled = 0;
+
+typedef struct {
+    uint64_t count;
+    uint64_t total_ns;
+    uint64_t max_ns;
+} SpanStats;
+
+static SpanStats metrics_spans[METRIC_SPAN_COUNT];
+static uint64_t metrics_counters[METRIC_COUNTER_COUNT];
+
+static const char *const metric_span_names[METRIC_SPAN_COUNT] = {
+    "csv_load", "csv_stream", "fit_linear", "fit_polynomial", "fit_logistic", "fit_multiple", "autofit",
+    "group_fit", "rolling", "predict", "plot_render", "gnuplot_spawn", "gnuplot_plot", "gnuplot_wait"};
+
+static const char *const metric_counter_names[METRIC_COUNTER_COUNT] = {
+    "rows_parsed", "bytes_read", "rows_skipped", "fields_non_numeric", "fits", "lm_iterations",
+    "lm_evaluations", "lm_not_converged", "workspace_allocations", "predictions", "plots"};
+
+void metricsEnable(int enabled) {
+    metrics_enabled = enabled;
+}
+
+void metricsReset(void) {
+    memset(metrics_spans, 0, sizeof(metrics_spans));
+    memset(metrics_counters, 0, sizeof(metrics_counters));
+}
+
+void metricsRecordSpan(MetricSpan span, double seconds) {
+    SpanStats *stats = &metrics_spans[span];
+    uint64_t ns = seconds > 0 ? (uint64_t)(seconds * 1e9) : 0;
+    __atomic_fetch_add(&stats->count, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&stats->total_ns, ns, __ATOMIC_RELAXED);
+    uint64_t max = __atomic_load_n(&stats->max_ns, __ATOMIC_RELAXED);
+    while (ns > max &&
+           !__atomic_compare_exchange_n(&stats->max_ns, &max, ns, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+void metricsRecordCount(MetricCounter counter, uint64_t value) {
+    __atomic_fetch_add(&metrics_counters[counter], value, __ATOMIC_RELAXED);
+}
+
+const char *metricSpanName(MetricSpan span) {
+    return span < METRIC_SPAN_COUNT ? metric_span_names[span] : "?";
+}
+
+const char *metricCounterName(MetricCounter counter) {
+    return counter < METRIC_COUNTER_COUNT ? metric_counter_names[counter] : "?";
+}
+
+// {"spans": {"csv_load": {"count": 1, "total_ms": ..., "max_ms": ...}, ...}, "counters": {...}}
+void metricsWriteJSON(FILE *out) {
+    fprintf(out, "{\n  \"spans\": {");
+    for (int i = 0; i < METRIC_SPAN_COUNT; i++) {
+        const SpanStats *s = &metrics_spans[i];
+        fprintf(out, "%s\n    \"%s\": {\"count\": %llu, \"total_ms\": %.6f, \"max_ms\": %.6f}", i ? "," : "",
+                metric_span_names[i], (unsigned long long)s->count, s->total_ns / 1e6, s->max_ns / 1e6);
+    }
+    fprintf(out, "\n  },\n  \"counters\": {");
+    for (int i = 0; i < METRIC_COUNTER_COUNT; i++) {
+        fprintf(out, "%s\n    \"%s\": %llu", i ? "," : "", metric_counter_names[i],
+                (unsigned long long)metrics_counters[i]);
+    }
+    fprintf(out, "\n  }\n}\n");
+}
+
+// Format teks Prometheus: span sebagai summary (tanpa kuantil) plus gauge maksimum, counter sebagai *_total
+void metricsWritePrometheus(FILE *out) {
+    fprintf(out, "# HELP curvefit_stage_seconds Waktu per tahap.\n# TYPE curvefit_stage_seconds summary\n");
+    for (int i = 0; i < METRIC_SPAN_COUNT; i++) {
+        fprintf(out, "curvefit_stage_seconds_sum{stage=\"%s\"} %.9f\n", metric_span_names[i],
+                metrics_spans[i].total_ns / 1e9);
+        fprintf(out, "curvefit_stage_seconds_count{stage=\"%s\"} %llu\n", metric_span_names[i],
+                (unsigned long long)metrics_spans[i].count);
+    }
+    fprintf(out, "# HELP curvefit_stage_max_seconds Durasi terlama per tahap.\n"
+                 "# TYPE curvefit_stage_max_seconds gauge\n");
+    for (int i = 0; i < METRIC_SPAN_COUNT; i++) {
+        fprintf(out, "curvefit_stage_max_seconds{stage=\"%s\"} %.9f\n", metric_span_names[i],
+                metrics_spans[i].max_ns / 1e9);
+    }
+    for (int i = 0; i < METRIC_COUNTER_COUNT; i++) {
+        fprintf(out, "# TYPE curvefit_%s_total counter\ncurvefit_%s_total %llu\n", metric_counter_names[i],
+                metric_counter_names[i], (unsigned long long)metrics_counters[i]);
+    }
+}
+
+// Tulis metrics ke path: "-" untuk JSON ke stderr, akhiran .prom untuk format Prometheus, selain itu JSON
+CFStatus metricsWriteFile(const char *path) {
+    if (strcmp(path, "-") == 0) {
+        metricsWriteJSON(stderr);
+        return CF_OK;
+    }
+    FILE *out = fopen(path, "w");
+    if (!out) {
+        return CF_ERROR_IO;
+    }
+    size_t length = strlen(path);
+    if (length >= 5 && strcmp(path + length - 5, ".prom") == 0) {
+        metricsWritePrometheus(out);
+    } else {
+        metricsWriteJSON(out);
+    }
+    return fclose(out) == 0 ? CF_OK : CF_ERROR_IO;
+}
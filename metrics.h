@@ -0,0 +1,79 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "csv_fast.h"
+#include "status.h"
+
+// Instrumentasi ringan per tahap. Mati secara default: setiap titik ukur hanya memeriksa satu
+// flag global, tanpa membaca jam dan tanpa atomic, sehingga biayanya praktis nol. Setelah
+// metricsEnable(1), span mencatat jumlah, total dan durasi maksimum (jam monotonic) dan counter
+// dijumlahkan secara atomic, aman dipanggil dari thread mana pun. Titik ukur ada di level tahap
+// (satu file, satu fit, satu plot), tidak di dalam loop per baris.
+
+typedef enum {
+    METRIC_SPAN_CSV_LOAD,      // Baca CSV ke memori (loadDataset, readCSVData*)
+    METRIC_SPAN_CSV_STREAM,    // Baca CSV per batch (mode streaming)
+    METRIC_SPAN_FIT_LINEAR,
+    METRIC_SPAN_FIT_POLYNOMIAL,
+    METRIC_SPAN_FIT_LOGISTIC,
+    METRIC_SPAN_FIT_MULTIPLE,  // Least squares berganda/berbobot
+    METRIC_SPAN_AUTOFIT,       // Pemilihan model dengan validasi silang (termasuk fit per fold)
+    METRIC_SPAN_GROUP_FIT,     // Fit per grup kolom kunci (parse, tabel hash dan fit semua grup)
+    METRIC_SPAN_ROLLING,
+    METRIC_SPAN_PREDICT,       // Prediksi file (predictCSVFile)
+    METRIC_SPAN_PLOT_RENDER,   // Renderer bawaan, termasuk encode PNG/SVG
+    METRIC_SPAN_GNUPLOT_SPAWN, // Start proses gnuplot
+    METRIC_SPAN_GNUPLOT_PLOT,  // Kirim satu plot ke gnuplot
+    METRIC_SPAN_GNUPLOT_WAIT,  // Tunggu gnuplot selesai saat sesi ditutup
+    METRIC_SPAN_COUNT
+} MetricSpan;
+
+typedef enum {
+    METRIC_ROWS_PARSED,
+    METRIC_BYTES_READ,
+    METRIC_ROWS_SKIPPED,          // Baris tanpa pasangan angka yang valid
+    METRIC_FIELDS_NON_NUMERIC,    // Field kosong/bukan angka di dataset (disimpan sebagai NaN)
+    METRIC_FITS,
+    METRIC_LM_ITERATIONS,
+    METRIC_LM_EVALUATIONS,
+    METRIC_LM_NOT_CONVERGED,
+    METRIC_WORKSPACE_ALLOCATIONS, // malloc oleh FitWorkspace (nol di steady state)
+    METRIC_PREDICTIONS,
+    METRIC_PLOTS,
+    METRIC_COUNTER_COUNT
+} MetricCounter;
+
+extern int metrics_enabled;
+
+// Deklarasi fungsi
+void metricsEnable(int enabled);
+void metricsReset(void);
+void metricsRecordSpan(MetricSpan span, double seconds);
+void metricsRecordCount(MetricCounter counter, uint64_t value);
+const char *metricSpanName(MetricSpan span);
+const char *metricCounterName(MetricCounter counter);
+void metricsWriteJSON(FILE *out);
+void metricsWritePrometheus(FILE *out);
+CFStatus metricsWriteFile(const char *path);
+
+// Awal span: 0 jika metrics mati (jam tidak dibaca)
+static inline double metricsSpanBegin(void) {
+    return metrics_enabled ? monotonicSeconds() : 0.0;
+}
+
+static inline void metricsSpanEnd(MetricSpan span, double start) {
+    if (metrics_enabled) {
+        metricsRecordSpan(span, monotonicSeconds() - start);
+    }
+}
+
+static inline void metricsAdd(MetricCounter counter, uint64_t value) {
+    if (metrics_enabled) {
+        metricsRecordCount(counter, value);
+    }
+}
+
+#endif
@@ -0,0 +1,159 @@
+#include "model_io.h"
+
+static void modelCopyString(char *dest, size_t size, const char *src) {
+    memset(dest, 0, size);
+    if (src) {
+        strncpy(dest, src, size - 1);
+    }
+}
+
+// Isi ModelFile dari hasil regresi dan asal datanya. Return -1 jika model tidak valid.
+int modelFileFromResult(const RegressionResult *result, const char *source, const char *x_name, const char *y_name,
+                        uint64_t num_points, ModelFile *model) {
+    CompiledModel compiled;
+    if (compileModel(result, &compiled) != 0) {
+        return -1;
+    }
+    memset(model, 0, sizeof(*model));
+    model->magic = MODEL_FILE_MAGIC;
+    model->version = MODEL_FILE_VERSION;
+    model->size = sizeof(ModelFile);
+    model->type = (uint32_t)result->type;
+    model->degree = compiled.degree;
+    model->num_points = num_points;
+    model->created = (int64_t)time(NULL);
+    model->r_squared = result->r_squared;
+    model->slope = result->slope;
+    model->intercept = result->intercept;
+    model->a = result->a;
+    model->b = result->b;
+    model->c = result->c;
+    model->mean_x = result->mean_x;
+    memcpy(model->coefficients, compiled.coefficients, sizeof(model->coefficients));
+    model->logistic_k = compiled.logistic_k;
+
+    struct stat st;
+    if (source && stat(source, &st) == 0) {
+        model->source_size = (uint64_t)st.st_size;
+    }
+    modelCopyString(model->source, sizeof(model->source), source);
+    modelCopyString(model->x_name, sizeof(model->x_name), x_name);
+    modelCopyString(model->y_name, sizeof(model->y_name), y_name);
+    return 0;
+}
+
+// Tulis ke file sementara lalu rename, seperti file state inkremental
+CFStatus modelFileSave(const char *path, const ModelFile *model) {
+    char tmp_path[1024];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+    FILE *file = fopen(tmp_path, "wb");
+    if (!file) {
+        return CF_ERROR_IO;
+    }
+    int ok = fwrite(model, sizeof(*model), 1, file) == 1;
+    ok = fclose(file) == 0 && ok;
+    if (!ok || rename(tmp_path, path) != 0) {
+        remove(tmp_path);
+        return CF_ERROR_IO;
+    }
+    return CF_OK;
+}
+
+// Petakan file model dan validasi header. *model menunjuk ke model di dalam pemetaan
+// (berlaku sampai unmapFile(mf)). Jika gagal tidak ada yang perlu dibebaskan.
+CFStatus modelFileMap(const char *path, MappedFile *mf, const ModelFile **model) {
+    *model = NULL;
+    if (mapFile(path, mf) != 0) {
+        return CF_ERROR_IO;
+    }
+    const ModelFile *mapped = (const ModelFile *)mf->data;
+    int ok = mf->size == sizeof(ModelFile) && mapped->magic == MODEL_FILE_MAGIC &&
+             mapped->version == MODEL_FILE_VERSION && mapped->size == sizeof(ModelFile) &&
+             mapped->type <= REGRESSION_LOGISTIC && mapped->degree >= 0 && mapped->degree <= MAX_POLY_DEGREE &&
+             memchr(mapped->source, '\0', sizeof(mapped->source)) &&
+             memchr(mapped->x_name, '\0', sizeof(mapped->x_name)) &&
+             memchr(mapped->y_name, '\0', sizeof(mapped->y_name));
+    if (!ok) {
+        unmapFile(mf);
+        return CF_ERROR_FORMAT;
+    }
+    *model = mapped;
+    return CF_OK;
+}
+
+// Salin bentuk terkompilasi tanpa perhitungan ulang
+void modelFileCompile(const ModelFile *model, CompiledModel *compiled) {
+    memset(compiled, 0, sizeof(*compiled));
+    compiled->type = model->type == REGRESSION_LOGISTIC ? REGRESSION_LOGISTIC : REGRESSION_POLYNOMIAL;
+    compiled->degree = model->degree;
+    memcpy(compiled->coefficients, model->coefficients, sizeof(compiled->coefficients));
+    compiled->logistic_c = model->c;
+    compiled->logistic_b = model->b;
+    compiled->logistic_k = model->logistic_k;
+}
+
+// RegressionResult lengkap (koefisien polynomial dialokasikan, bebaskan dengan freeRegressionResult)
+RegressionResult modelFileToResult(const ModelFile *model) {
+    RegressionResult result;
+    memset(&result, 0, sizeof(result));
+    result.type = (RegressionType)model->type;
+    result.slope = model->slope;
+    result.intercept = model->intercept;
+    result.a = model->a;
+    result.b = model->b;
+    result.c = model->c;
+    result.mean_x = model->mean_x;
+    result.degree = model->degree;
+    result.r_squared = model->r_squared;
+    if (result.type == REGRESSION_POLYNOMIAL) {
+        result.coefficients = (double *)malloc((model->degree + 1) * sizeof(double));
+        if (result.coefficients) {
+            memcpy(result.coefficients, model->coefficients, (model->degree + 1) * sizeof(double));
+        } else {
+            result.r_squared = NAN;
+        }
+    }
+    return result;
+}
+
+static void writeModelJSONNumber(FILE *out, double value) {
+    if (isfinite(value)) {
+        fprintf(out, "%.17g", value);
+    } else {
+        fprintf(out, "null");
+    }
+}
+
+// Ekspor JSON untuk dibaca tool lain. Angka ditulis dengan 17 digit sehingga kembali persis.
+void modelFileWriteJSON(FILE *out, const ModelFile *model) {
+    const char *names[] = {"r_squared", "slope", "intercept", "a", "b", "c", "mean_x"};
+    const double values[] = {model->r_squared, model->slope, model->intercept, model->a,
+                             model->b,         model->c,     model->mean_x};
+
+    fprintf(out, "{\n  \"version\": %u,\n  \"model\": \"%s\",\n  \"degree\": %d,\n", model->version,
+            regressionTypeName((RegressionType)model->type), model->degree);
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        fprintf(out, "  \"%s\": ", names[i]);
+        writeModelJSONNumber(out, values[i]);
+        fprintf(out, ",\n");
+    }
+    fprintf(out, "  \"coefficients\": [");
+    int count = model->type == REGRESSION_LOGISTIC ? 0 : model->degree + 1;
+    for (int k = 0; k < count; k++) {
+        if (k) {
+            fprintf(out, ", ");
+        }
+        writeModelJSONNumber(out, model->coefficients[k]);
+    }
+    fprintf(out, "],\n  \"logistic_k\": ");
+    writeModelJSONNumber(out, model->logistic_k);
+    fprintf(out, ",\n  \"source\": ");
+    writeQuotedName(out, model->source, '\\');
+    fprintf(out, ",\n  \"x\": ");
+    writeQuotedName(out, model->x_name, '\\');
+    fprintf(out, ",\n  \"y\": ");
+    writeQuotedName(out, model->y_name, '\\');
+    fprintf(out, ",\n  \"num_points\": %llu,\n  \"source_size\": %llu,\n  \"created\": %lld\n}\n",
+            (unsigned long long)model->num_points, (unsigned long long)model->source_size,
+            (long long)model->created);
+}
@@ -0,0 +1,57 @@
+#ifndef MODEL_IO_H
+#define MODEL_IO_H
+
+#include <stdint.h>
+#include <time.h>
+
+#include "batch_fit.h"
+#include "predict.h"
+
+// Penanda dan versi file model
+#define MODEL_FILE_MAGIC 0x444D4643u // "CFMD"
+#define MODEL_FILE_VERSION 1
+#define MODEL_SOURCE_LENGTH 256
+#define MODEL_NAME_LENGTH 64
+
+// File model biner: satu struct dengan field lebar tetap dan tanpa pointer, sehingga file
+// yang dipetakan ke memori bisa langsung dipakai sebagai ModelFile tanpa parsing. Bentuk
+// terkompilasi (koefisien Horner, logistic_k) ikut disimpan supaya prediksi tidak perlu
+// menghitung apa pun saat start. Byte order mengikuti mesin (magic tidak cocok di mesin
+// big-endian, sehingga file ditolak).
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;   // sizeof(ModelFile)
+    uint32_t type;   // RegressionType
+    int32_t degree;  // 1 untuk linear, 0 untuk logistic
+    uint32_t reserved;
+    uint64_t num_points; // Jumlah titik data yang di-fit
+    int64_t created;     // Waktu fit (detik sejak epoch)
+    uint64_t source_size;
+    double r_squared;
+    // Parameter seperti di RegressionResult
+    double slope;
+    double intercept;
+    double a;
+    double b;
+    double c;
+    double mean_x;
+    // Bentuk terkompilasi: y = Σ coefficients[i] x^i, atau y = c / (1 + e^(logistic_k - b x))
+    double coefficients[MAX_POLY_DEGREE + 1];
+    double logistic_k;
+    // Asal model (string diakhiri '\0')
+    char source[MODEL_SOURCE_LENGTH];
+    char x_name[MODEL_NAME_LENGTH];
+    char y_name[MODEL_NAME_LENGTH];
+} ModelFile;
+
+// Deklarasi fungsi
+int modelFileFromResult(const RegressionResult *result, const char *source, const char *x_name, const char *y_name,
+                        uint64_t num_points, ModelFile *model);
+CFStatus modelFileSave(const char *path, const ModelFile *model);
+CFStatus modelFileMap(const char *path, MappedFile *mf, const ModelFile **model);
+void modelFileCompile(const ModelFile *model, CompiledModel *compiled);
+RegressionResult modelFileToResult(const ModelFile *model);
+void modelFileWriteJSON(FILE *out, const ModelFile *model);
+
+#endif
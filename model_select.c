@@ -0,0 +1,473 @@
+#include "model_select.h"
+
+// Lintasan jumlah pangkat: setiap chunk menyimpan satu PolyAccumulator per fold. Lintasan residual
+// memakai chunk dan pembagian blok yang sama.
+typedef struct {
+    const double *x;
+    const double *y;
+    size_t stride;
+    size_t n;
+    size_t block_rows;
+    size_t chunk_rows; // Kelipatan block_rows * folds, sehingga satu grup blok tidak terpotong chunk
+    int folds;
+    int degree;
+    double shift;
+    double scale;
+    double y_shift;
+    uint64_t seed;
+    PolyAccumulator *chunks; // chunks[chunk * folds + fold]
+    double *solutions;       // Koefisien basis t per (derajat, fold), lihat autoFitSolution
+    const int *solved;       // solved[degree]: semua fit derajat ini berhasil
+    double mean_dy;
+    double *sums;            // Per chunk (degree + 1) * (folds + 1) nilai, lihat autoFitSumIndex
+} AutoFitPass;
+
+// Fit logistic per fold. Data disusun ulang per fold lalu ditulis dua kali berturut-turut, sehingga
+// data latih fold f (semua fold lain) dan data ujinya sama-sama berupa satu rentang kontigu.
+typedef struct {
+    const double *xy; // Pasangan (x, y), stride 2, panjang 2n titik
+    size_t n;
+    int folds;
+    const size_t *offset;
+    const size_t *count;
+    ThreadPool *pool;
+    RegressionResult *fits; // folds + 1 fit; yang terakhir untuk seluruh data
+    double *sse;            // SSE held-out per fold; sse[folds] adalah SSE in-sample
+} AutoFitLogisticJob;
+
+void defaultAutoFitOptions(AutoFitOptions *options) {
+    options->folds = 5;
+    options->max_degree = MAX_POLY_DEGREE;
+    options->include_logistic = 1;
+    options->criterion = AUTOFIT_CRITERION_CV;
+    options->seed = 1;
+}
+
+const char *autoFitCriterionName(AutoFitCriterion criterion) {
+    switch (criterion) {
+    case AUTOFIT_CRITERION_CV:
+        return "cv";
+    case AUTOFIT_CRITERION_AIC:
+        return "aic";
+    case AUTOFIT_CRITERION_BIC:
+        return "bic";
+    }
+    return "unknown";
+}
+
+static inline uint64_t autoFitMix(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Fold untuk blok-blok dalam satu grup `folds` blok: permutasi acak (Fisher-Yates) per grup, sehingga
+// setiap fold mendapat tepat satu blok per grup dan ukuran fold seimbang walaupun data terurut
+static void autoFitGroupFolds(uint64_t seed, size_t group, int folds, int *fold_of_block) {
+    for (int i = 0; i < folds; i++) {
+        fold_of_block[i] = i;
+    }
+    uint64_t state = seed ^ ((uint64_t)group * 0x9E3779B97F4A7C15ULL);
+    for (int i = folds - 1; i > 0; i--) {
+        state += 0x9E3779B97F4A7C15ULL;
+        int j = (int)(autoFitMix(state) % (uint64_t)(i + 1));
+        int tmp = fold_of_block[i];
+        fold_of_block[i] = fold_of_block[j];
+        fold_of_block[j] = tmp;
+    }
+}
+
+static void autoFitChunkWork(void *arg, size_t index) {
+    const AutoFitPass *p = (const AutoFitPass *)arg;
+    PolyAccumulator *acc = p->chunks + index * p->folds;
+    for (int f = 0; f < p->folds; f++) {
+        polyAccumulatorInit(&acc[f], p->degree, p->shift, p->scale, p->y_shift);
+    }
+
+    size_t group_rows = p->block_rows * p->folds;
+    size_t begin = index * p->chunk_rows;
+    size_t end = begin + p->chunk_rows < p->n ? begin + p->chunk_rows : p->n;
+    int fold_of_block[AUTOFIT_MAX_FOLDS];
+    for (size_t group = begin; group < end; group += group_rows) {
+        autoFitGroupFolds(p->seed, group / group_rows, p->folds, fold_of_block);
+        for (int b = 0; b < p->folds; b++) {
+            size_t start = group + b * p->block_rows;
+            if (start >= end) {
+                break;
+            }
+            size_t rows = end - start < p->block_rows ? end - start : p->block_rows;
+            polyAccumulatorAdd(&acc[fold_of_block[b]], p->x + start * p->stride, p->y + start * p->stride,
+                               p->stride, rows);
+        }
+    }
+}
+
+// Koefisien derajat `degree` dari data latih fold `fold`; fold == folds berarti fit seluruh data
+static inline double *autoFitSolution(const AutoFitPass *p, int degree, int fold) {
+    return p->solutions + ((size_t)degree * (p->folds + 1) + fold) * (MAX_POLY_DEGREE + 1);
+}
+
+// SSE held-out derajat d pada fold f di [d][f], SSE in-sample di [d][folds], SS_tot di [0][folds]
+static inline size_t autoFitSumIndex(const AutoFitPass *p, int degree, int fold) {
+    return (size_t)degree * (p->folds + 1) + fold;
+}
+
+// Residual setiap kandidat dievaluasi langsung pada data. Menghitungnya dari jumlah pangkat
+// (Σy² - 2cᵀΣy·t^k + cᵀHc) kehilangan hampir semua digit saat R² mendekati 1.
+static void autoFitResidualWork(void *arg, size_t index) {
+    const AutoFitPass *p = (const AutoFitPass *)arg;
+    size_t width = autoFitSumIndex(p, p->degree + 1, 0);
+    double *sums = p->sums + index * width;
+    memset(sums, 0, width * sizeof(double));
+
+    double inv_scale = 1.0 / p->scale; // Sama dengan polyAccumulatorAdd
+    size_t group_rows = p->block_rows * p->folds;
+    size_t begin = index * p->chunk_rows;
+    size_t end = begin + p->chunk_rows < p->n ? begin + p->chunk_rows : p->n;
+    int fold_of_block[AUTOFIT_MAX_FOLDS];
+    double t[AUTOFIT_BLOCK_ROWS], dy[AUTOFIT_BLOCK_ROWS];
+    for (size_t group = begin; group < end; group += group_rows) {
+        autoFitGroupFolds(p->seed, group / group_rows, p->folds, fold_of_block);
+        for (int b = 0; b < p->folds; b++) {
+            size_t start = group + b * p->block_rows;
+            if (start >= end) {
+                break;
+            }
+            size_t rows = end - start < p->block_rows ? end - start : p->block_rows;
+            int fold = fold_of_block[b];
+            double ss_tot = 0;
+            for (size_t i = 0; i < rows; i++) {
+                t[i] = (p->x[(start + i) * p->stride] - p->shift) * inv_scale;
+                dy[i] = p->y[(start + i) * p->stride] - p->y_shift;
+                ss_tot += (dy[i] - p->mean_dy) * (dy[i] - p->mean_dy);
+            }
+            sums[autoFitSumIndex(p, 0, p->folds)] += ss_tot;
+
+            for (int degree = 1; degree <= p->degree; degree++) {
+                if (!p->solved[degree]) {
+                    continue;
+                }
+                const double *held = autoFitSolution(p, degree, fold);
+                const double *full = autoFitSolution(p, degree, p->folds);
+                double held_sse = 0, full_sse = 0;
+                for (size_t i = 0; i < rows; i++) {
+                    double held_value = held[degree], full_value = full[degree];
+                    for (int k = degree - 1; k >= 0; k--) {
+                        held_value = held_value * t[i] + held[k];
+                        full_value = full_value * t[i] + full[k];
+                    }
+                    held_sse += (dy[i] - held_value) * (dy[i] - held_value);
+                    full_sse += (dy[i] - full_value) * (dy[i] - full_value);
+                }
+                sums[autoFitSumIndex(p, degree, fold)] += held_sse;
+                sums[autoFitSumIndex(p, degree, p->folds)] += full_sse;
+            }
+        }
+    }
+}
+
+static void autoFitLogisticWork(void *arg, size_t index) {
+    const AutoFitLogisticJob *job = (const AutoFitLogisticJob *)arg;
+    const double *train = job->xy, *test = job->xy;
+    size_t train_n = job->n, test_n = job->n;
+    if ((int)index < job->folds) {
+        train = job->xy + 2 * (job->offset[index] + job->count[index]);
+        train_n = job->n - job->count[index];
+        test = job->xy + 2 * job->offset[index];
+        test_n = job->count[index];
+    }
+
+    job->fits[index] = logisticRegressionWorkspace(train, train + 1, 2, (int)train_n, job->pool, NULL, NULL);
+    job->sse[index] = NAN;
+    CompiledModel model;
+    if (isnan(job->fits[index].r_squared) || compileModel(&job->fits[index], &model) != 0) {
+        return;
+    }
+    double sse = 0;
+    for (size_t i = 0; i < test_n; i++) {
+        double residual = test[2 * i + 1] - compiledModelEvalOne(&model, test[2 * i]);
+        sse += residual * residual;
+    }
+    job->sse[index] = sse;
+}
+
+// Susun ulang pasangan (x, y) per fold dengan pembagian blok yang sama seperti lintasan jumlah pangkat,
+// lalu salin sekali lagi di belakangnya
+static double *autoFitFoldLayout(const AutoFitPass *p, const size_t *offset) {
+    double *xy = (double *)malloc(4 * p->n * sizeof(double));
+    size_t cursor[AUTOFIT_MAX_FOLDS];
+    int fold_of_block[AUTOFIT_MAX_FOLDS];
+    if (!xy) {
+        return NULL;
+    }
+    memcpy(cursor, offset, p->folds * sizeof(size_t));
+
+    size_t group_rows = p->block_rows * p->folds;
+    for (size_t group = 0; group < p->n; group += group_rows) {
+        autoFitGroupFolds(p->seed, group / group_rows, p->folds, fold_of_block);
+        for (int b = 0; b < p->folds; b++) {
+            size_t start = group + b * p->block_rows;
+            size_t end = start + p->block_rows < p->n ? start + p->block_rows : p->n;
+            double *dst = xy + 2 * cursor[fold_of_block[b]];
+            for (size_t i = start; i < end; i++) {
+                *dst++ = p->x[i * p->stride];
+                *dst++ = p->y[i * p->stride];
+            }
+            cursor[fold_of_block[b]] += start < end ? end - start : 0;
+        }
+    }
+    memcpy(xy + 2 * p->n, xy, 2 * p->n * sizeof(double));
+    return xy;
+}
+
+// AIC/BIC Gaussian dari SSE fit seluruh data (konstanta yang sama untuk semua kandidat dibuang)
+static void autoFitInformation(AutoFitCandidate *c, double sse, double n) {
+    double log_mse = log(sse / n > DBL_MIN ? sse / n : DBL_MIN);
+    c->aic = n * log_mse + 2.0 * c->num_params;
+    c->bic = n * log_mse + c->num_params * log(n);
+}
+
+static void autoFitFoldScores(AutoFitCandidate *c, const double *fold_sse, const size_t *count, int folds, double n) {
+    double total = 0, sum_rmse = 0, sum_rmse2 = 0;
+    for (int f = 0; f < folds; f++) {
+        double rmse = count[f] ? sqrt(fold_sse[f] / (double)count[f]) : 0;
+        total += fold_sse[f];
+        sum_rmse += rmse;
+        sum_rmse2 += rmse * rmse;
+    }
+    double mean = sum_rmse / folds;
+    double variance = (sum_rmse2 - folds * mean * mean) / (folds - 1);
+    c->cv_rmse = sqrt(total / n);
+    c->cv_rmse_sd = variance > 0 ? sqrt(variance) : 0;
+}
+
+static double autoFitScore(const AutoFitCandidate *c, AutoFitCriterion criterion) {
+    switch (criterion) {
+    case AUTOFIT_CRITERION_CV:
+        return c->cv_rmse;
+    case AUTOFIT_CRITERION_AIC:
+        return c->aic;
+    case AUTOFIT_CRITERION_BIC:
+        return c->bic;
+    }
+    return NAN;
+}
+
+// Pilih model dengan validasi silang k-fold atas linear, polynomial 2..max_degree dan (opsional) logistic.
+// Kandidat linear/polynomial tidak membaca data per kandidat: satu lintasan paralel mengumpulkan jumlah
+// pangkat Σt^0..Σt^2D per fold dan data latih fold f adalah gabungan akumulator fold lain. Lintasan kedua
+// mengevaluasi semua koefisien pada data untuk SSE held-out dan in-sample. Fit logistic per fold berjalan paralel.
+// Model terpilih di-fit ulang pada seluruh data dan disimpan di result->model.
+CFStatus autoFit(const double *x, const double *y, size_t stride, size_t n, const AutoFitOptions *options,
+                 ThreadPool *pool, AutoFitResult *result) {
+    memset(result, 0, sizeof(*result));
+    result->best = -1;
+    result->folds = options->folds;
+    result->criterion = options->criterion;
+    result->num_points = n;
+    if (options->folds < 2 || options->folds > AUTOFIT_MAX_FOLDS || options->max_degree < 1 ||
+        options->max_degree > MAX_POLY_DEGREE) {
+        return CF_ERROR_ARGUMENT;
+    }
+    if (n < 2 * (size_t)options->folds) {
+        return CF_ERROR_NO_DATA;
+    }
+    double span = metricsSpanBegin();
+
+    // Blok cukup kecil supaya setiap fold mendapat banyak blok yang tersebar di seluruh data
+    int folds = options->folds;
+    AutoFitPass pass;
+    pass.x = x;
+    pass.y = y;
+    pass.stride = stride;
+    pass.n = n;
+    pass.block_rows = n / ((size_t)folds * 64);
+    pass.block_rows = pass.block_rows < 1 ? 1 : (pass.block_rows > AUTOFIT_BLOCK_ROWS ? AUTOFIT_BLOCK_ROWS
+                                                                                       : pass.block_rows);
+    size_t group_rows = pass.block_rows * folds;
+    size_t chunk_rows = n / AUTOFIT_MAX_CHUNKS + 1;
+    chunk_rows = chunk_rows > AUTOFIT_MIN_CHUNK_ROWS ? chunk_rows : AUTOFIT_MIN_CHUNK_ROWS;
+    pass.chunk_rows = (chunk_rows + group_rows - 1) / group_rows * group_rows;
+    pass.folds = folds;
+    pass.degree = options->max_degree;
+    polyRangeScale(x, stride, n, &pass.shift, &pass.scale);
+    pass.y_shift = y[0];
+    pass.seed = options->seed;
+
+    size_t num_chunks = (n + pass.chunk_rows - 1) / pass.chunk_rows;
+    pass.chunks = (PolyAccumulator *)malloc(num_chunks * folds * sizeof(PolyAccumulator));
+    if (!pass.chunks) {
+        return CF_ERROR_MEMORY;
+    }
+    threadPoolParallelFor(pool, num_chunks, autoFitChunkWork, &pass);
+
+    // Gabungkan chunk berurutan (deterministik), lalu bentuk data latih per fold dan total
+    PolyAccumulator fold_acc[AUTOFIT_MAX_FOLDS], train_acc[AUTOFIT_MAX_FOLDS], total;
+    size_t count[AUTOFIT_MAX_FOLDS], offset[AUTOFIT_MAX_FOLDS];
+    polyAccumulatorInit(&total, pass.degree, pass.shift, pass.scale, pass.y_shift);
+    for (int f = 0; f < folds; f++) {
+        fold_acc[f] = pass.chunks[f];
+        for (size_t c = 1; c < num_chunks; c++) {
+            polyAccumulatorMerge(&fold_acc[f], &pass.chunks[c * folds + f]);
+        }
+        count[f] = (size_t)fold_acc[f].n;
+        offset[f] = f ? offset[f - 1] + count[f - 1] : 0;
+        polyAccumulatorMerge(&total, &fold_acc[f]);
+    }
+    for (int f = 0; f < folds; f++) {
+        polyAccumulatorInit(&train_acc[f], pass.degree, pass.shift, pass.scale, pass.y_shift);
+        for (int g = 0; g < folds; g++) {
+            if (g != f) {
+                polyAccumulatorMerge(&train_acc[f], &fold_acc[g]);
+            }
+        }
+    }
+
+    // Koefisien linear (derajat 1) dan polynomial 2..max_degree tetap dari jumlah pangkat per fold
+    double solutions[(MAX_POLY_DEGREE + 1) * (AUTOFIT_MAX_FOLDS + 1) * (MAX_POLY_DEGREE + 1)];
+    int solved[MAX_POLY_DEGREE + 1] = {0};
+    pass.solutions = solutions;
+    pass.solved = solved;
+    pass.mean_dy = total.cross_sums[0] / total.n;
+    for (int degree = 1; degree <= options->max_degree; degree++) {
+        solved[degree] = polyAccumulatorSolveScaled(&total, degree, autoFitSolution(&pass, degree, folds)) == 0;
+        for (int f = 0; f < folds && solved[degree]; f++) {
+            solved[degree] = polyAccumulatorSolveScaled(&train_acc[f], degree, autoFitSolution(&pass, degree, f)) == 0;
+        }
+    }
+
+    // SSE dari lintasan residual, digabung per chunk berurutan (deterministik)
+    size_t width = autoFitSumIndex(&pass, pass.degree + 1, 0);
+    pass.sums = (double *)malloc(num_chunks * width * sizeof(double));
+    if (!pass.sums) {
+        free(pass.chunks);
+        return CF_ERROR_MEMORY;
+    }
+    threadPoolParallelFor(pool, num_chunks, autoFitResidualWork, &pass);
+    double sums[(MAX_POLY_DEGREE + 1) * (AUTOFIT_MAX_FOLDS + 1)] = {0};
+    for (size_t c = 0; c < num_chunks; c++) {
+        for (size_t i = 0; i < width; i++) {
+            sums[i] += pass.sums[c * width + i];
+        }
+    }
+    free(pass.sums);
+    double ss_tot = sums[autoFitSumIndex(&pass, 0, folds)];
+
+    for (int degree = 1; degree <= options->max_degree; degree++) {
+        AutoFitCandidate *c = &result->candidates[result->num_candidates++];
+        c->type = degree == 1 ? REGRESSION_LINEAR : REGRESSION_POLYNOMIAL;
+        c->degree = degree;
+        c->num_params = degree + 1;
+        c->ok = solved[degree];
+        if (c->ok) {
+            double sse = sums[autoFitSumIndex(&pass, degree, folds)];
+            c->r_squared = 1 - sse / ss_tot;
+            autoFitInformation(c, sse, (double)n);
+            autoFitFoldScores(c, sums + autoFitSumIndex(&pass, degree, 0), count, folds, (double)n);
+        }
+    }
+
+    RegressionResult logistic_full;
+    memset(&logistic_full, 0, sizeof(logistic_full));
+    logistic_full.r_squared = NAN;
+    CFStatus status = CF_OK;
+    if (options->include_logistic) {
+        AutoFitCandidate *c = &result->candidates[result->num_candidates++];
+        c->type = REGRESSION_LOGISTIC;
+        c->degree = 0;
+        c->num_params = 3;
+        double *xy = autoFitFoldLayout(&pass, offset);
+        RegressionResult fits[AUTOFIT_MAX_FOLDS + 1];
+        double sse[AUTOFIT_MAX_FOLDS + 1];
+        if (xy) {
+            AutoFitLogisticJob job = {xy, n, folds, offset, count, pool, fits, sse};
+            threadPoolParallelFor(pool, (size_t)folds + 1, autoFitLogisticWork, &job);
+            c->ok = 1;
+            for (int f = 0; f <= folds; f++) {
+                c->ok &= !isnan(sse[f]);
+            }
+            if (c->ok) {
+                c->r_squared = 1 - sse[folds] / ss_tot;
+                autoFitInformation(c, sse[folds], (double)n);
+                autoFitFoldScores(c, sse, count, folds, (double)n);
+                logistic_full = fits[folds];
+            }
+            free(xy);
+        } else {
+            status = CF_ERROR_MEMORY;
+        }
+    }
+    free(pass.chunks);
+
+    // Skor terkecil menang; urutan kandidat dari yang paling sederhana, jadi skor sama memilih model sederhana
+    for (int i = 0; i < result->num_candidates; i++) {
+        const AutoFitCandidate *c = &result->candidates[i];
+        if (c->ok && (result->best < 0 || autoFitScore(c, options->criterion) <
+                                              autoFitScore(&result->candidates[result->best], options->criterion))) {
+            result->best = i;
+        }
+    }
+    if (status == CF_OK && result->best < 0) {
+        status = CF_ERROR_NO_DATA;
+    }
+    if (status == CF_OK) {
+        const AutoFitCandidate *best = &result->candidates[result->best];
+        result->model = best->type == REGRESSION_LOGISTIC
+                            ? logistic_full
+                            : regressionFromAccumulator(&total, best->type, best->degree);
+        if (best->type == REGRESSION_POLYNOMIAL && !result->model.coefficients) {
+            status = CF_ERROR_MEMORY;
+        }
+        result->model.r_squared = best->r_squared; // Dari lintasan residual, bukan Σy² - cᵀΣy·t^k
+    }
+    metricsSpanEnd(METRIC_SPAN_AUTOFIT, span);
+    return status;
+}
+
+void freeAutoFitResult(AutoFitResult *result) {
+    freeRegressionResult(&result->model);
+}
+
+static void autoFitWriteNumber(FILE *out, const char *key, double value, const char *suffix) {
+    fprintf(out, "\"%s\": ", key);
+    if (isfinite(value)) {
+        fprintf(out, "%.17g%s", value, suffix);
+    } else {
+        fprintf(out, "null%s", suffix);
+    }
+}
+
+// Objek JSON: kriteria, model terpilih (dengan koefisien) dan scoreboard lengkap
+void writeAutoFitJSON(FILE *out, const char *x_name, const char *y_name, const AutoFitResult *result) {
+    const RegressionResult *m = &result->model;
+    fprintf(out, "{\n  \"x\": ");
+    writeQuotedName(out, x_name, '\\');
+    fprintf(out, ",\n  \"y\": ");
+    writeQuotedName(out, y_name, '\\');
+    fprintf(out, ",\n  \"n\": %zu,\n  \"folds\": %d,\n  \"criterion\": \"%s\",\n  \"best\": {\"type\": \"%s\", ",
+            result->num_points, result->folds, autoFitCriterionName(result->criterion),
+            regressionTypeName(m->type));
+    if (m->type == REGRESSION_LINEAR) {
+        fprintf(out, "\"slope\": %.17g, \"intercept\": %.17g", m->slope, m->intercept);
+    } else if (m->type == REGRESSION_LOGISTIC) {
+        fprintf(out, "\"a\": %.17g, \"b\": %.17g, \"c\": %.17g, \"mean_x\": %.17g", m->a, m->b, m->c, m->mean_x);
+    } else {
+        fprintf(out, "\"degree\": %d, \"coefficients\": [", m->degree);
+        for (int i = 0; i <= m->degree; i++) {
+            fprintf(out, "%s%.17g", i ? ", " : "", m->coefficients[i]);
+        }
+        fprintf(out, "]");
+    }
+    fprintf(out, "},\n  \"candidates\": [");
+    for (int i = 0; i < result->num_candidates; i++) {
+        const AutoFitCandidate *c = &result->candidates[i];
+        fprintf(out, "%s\n    {\"type\": \"%s\", \"degree\": %d, \"params\": %d, \"selected\": %s, ", i ? "," : "",
+                regressionTypeName(c->type), c->degree, c->num_params, i == result->best ? "true" : "false");
+        autoFitWriteNumber(out, "cv_rmse", c->ok ? c->cv_rmse : NAN, ", ");
+        autoFitWriteNumber(out, "cv_rmse_sd", c->ok ? c->cv_rmse_sd : NAN, ", ");
+        autoFitWriteNumber(out, "r_squared", c->ok ? c->r_squared : NAN, ", ");
+        autoFitWriteNumber(out, "aic", c->ok ? c->aic : NAN, ", ");
+        autoFitWriteNumber(out, "bic", c->ok ? c->bic : NAN, "}");
+    }
+    fprintf(out, "\n  ]\n}\n");
+}
@@ -0,0 +1,64 @@
+#ifndef MODEL_SELECT_H
+#define MODEL_SELECT_H
+
+#include "batch_fit.h"
+#include "predict.h"
+
+// Kandidat: linear, polynomial derajat 2..MAX_POLY_DEGREE dan logistic
+#define AUTOFIT_MAX_CANDIDATES (MAX_POLY_DEGREE + 1)
+#define AUTOFIT_MAX_FOLDS 20
+// Fold dibagi per blok baris yang kontigu (maksimal sebanyak ini), bukan per baris, supaya jumlah
+// pangkat satu blok bisa langsung ditambahkan dengan polyAccumulatorAdd
+#define AUTOFIT_BLOCK_ROWS 256
+// Potongan kerja paralel untuk lintasan jumlah pangkat; ukurannya hanya bergantung pada jumlah
+// baris sehingga hasilnya identik untuk berapa pun jumlah thread
+#define AUTOFIT_MIN_CHUNK_ROWS 65536
+#define AUTOFIT_MAX_CHUNKS 256
+
+typedef enum {
+    AUTOFIT_CRITERION_CV,  // RMSE held-out dari validasi silang k-fold
+    AUTOFIT_CRITERION_AIC, // n·ln(SSE/n) + 2p, dari fit seluruh data
+    AUTOFIT_CRITERION_BIC  // n·ln(SSE/n) + p·ln(n)
+} AutoFitCriterion;
+
+typedef struct {
+    int folds;             // k pada k-fold (2..AUTOFIT_MAX_FOLDS)
+    int max_degree;        // Derajat polynomial tertinggi yang dicoba
+    int include_logistic;  // Logistic butuh fit LM per fold, jauh lebih mahal dari polynomial
+    AutoFitCriterion criterion;
+    uint64_t seed;         // Pembagian blok ke fold (deterministik untuk seed yang sama)
+} AutoFitOptions;
+
+// Satu baris scoreboard. Skor bernilai NaN dan ok = 0 jika model tidak bisa di-fit
+// (misalnya matriks momen singular pada salah satu fold).
+typedef struct {
+    RegressionType type;
+    int degree;          // 1 untuk linear, 0 untuk logistic
+    int num_params;
+    int ok;
+    double cv_rmse;      // Akar dari Σ SSE held-out semua fold / n
+    double cv_rmse_sd;   // Simpangan baku RMSE per fold
+    double r_squared;    // In-sample, fit seluruh data
+    double aic;
+    double bic;
+} AutoFitCandidate;
+
+typedef struct {
+    AutoFitCandidate candidates[AUTOFIT_MAX_CANDIDATES];
+    int num_candidates;
+    int best;                // Indeks kandidat terpilih, -1 jika tidak ada yang valid
+    int folds;
+    AutoFitCriterion criterion;
+    size_t num_points;
+    RegressionResult model;  // Kandidat terpilih, di-fit ulang pada seluruh data
+} AutoFitResult;
+
+// Deklarasi fungsi
+void defaultAutoFitOptions(AutoFitOptions *options);
+const char *autoFitCriterionName(AutoFitCriterion criterion);
+CFStatus autoFit(const double *x, const double *y, size_t stride, size_t n, const AutoFitOptions *options,
+                 ThreadPool *pool, AutoFitResult *result);
+void freeAutoFitResult(AutoFitResult *result);
+void writeAutoFitJSON(FILE *out, const char *x_name, const char *y_name, const AutoFitResult *result);
+
+#endif
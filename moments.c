@@ -0,0 +1,294 @@
+#include "moments.h"
+
+// Kernel blok: out = {Σdx, Σdy, Σdx², Σdxdy, Σdy²}
+typedef void (*MomentsBlockFn)(const double *x, const double *y, size_t n, double sx, double sy, double *out);
+
+// Versi skalar dengan stride: 1 untuk SoA, 2 untuk AoS (y = x + 1)
+static inline void momentsBlockScalarStrided(const double *x, const double *y, size_t stride, size_t n,
+                                             double sx, double sy, double *out) {
+    double ax0 = 0, ay0 = 0, axx0 = 0, axy0 = 0, ayy0 = 0;
+    double ax1 = 0, ay1 = 0, axx1 = 0, axy1 = 0, ayy1 = 0;
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        double dx0 = x[i * stride] - sx, dy0 = y[i * stride] - sy;
+        double dx1 = x[(i + 1) * stride] - sx, dy1 = y[(i + 1) * stride] - sy;
+        ax0 += dx0;
+        ay0 += dy0;
+        axx0 += dx0 * dx0;
+        axy0 += dx0 * dy0;
+        ayy0 += dy0 * dy0;
+        ax1 += dx1;
+        ay1 += dy1;
+        axx1 += dx1 * dx1;
+        axy1 += dx1 * dy1;
+        ayy1 += dy1 * dy1;
+    }
+    if (i < n) {
+        double dx = x[i * stride] - sx, dy = y[i * stride] - sy;
+        ax0 += dx;
+        ay0 += dy;
+        axx0 += dx * dx;
+        axy0 += dx * dy;
+        ayy0 += dy * dy;
+    }
+    out[0] = ax0 + ax1;
+    out[1] = ay0 + ay1;
+    out[2] = axx0 + axx1;
+    out[3] = axy0 + axy1;
+    out[4] = ayy0 + ayy1;
+}
+
+static void momentsBlockScalarAoS(const double *x, const double *y, size_t n, double sx, double sy, double *out) {
+    (void)y;
+    momentsBlockScalarStrided(x, x + 1, 2, n, sx, sy, out);
+}
+
+static void momentsBlockScalarSoA(const double *x, const double *y, size_t n, double sx, double sy, double *out) {
+    momentsBlockScalarStrided(x, y, 1, n, sx, sy, out);
+}
+
+#if MOMENTS_HAVE_X86
+__attribute__((target("avx2,fma"))) static double momentsHsum256(__m256d v) {
+    __m128d lo = _mm256_castpd256_pd128(v);
+    __m128d hi = _mm256_extractf128_pd(v, 1);
+    lo = _mm_add_pd(lo, hi);
+    return _mm_cvtsd_f64(lo) + _mm_cvtsd_f64(_mm_unpackhi_pd(lo, lo));
+}
+
+// AoS: satu register berisi [x0 y0 x1 y1]. Kuadrat memberi x² dan y² sekaligus,
+// perkalian dengan versi yang ditukar [y0 x0 y1 x1] memberi x*y.
+__attribute__((target("avx2,fma"))) static void momentsBlockAVX2AoS(const double *x, const double *y, size_t n,
+                                                                     double sx, double sy, double *out) {
+    (void)y;
+    const __m256d shift = _mm256_setr_pd(sx, sy, sx, sy);
+    __m256d lin0 = _mm256_setzero_pd(), lin1 = _mm256_setzero_pd();
+    __m256d sq0 = _mm256_setzero_pd(), sq1 = _mm256_setzero_pd();
+    __m256d cr0 = _mm256_setzero_pd(), cr1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d d0 = _mm256_sub_pd(_mm256_loadu_pd(x + 2 * i), shift);
+        __m256d d1 = _mm256_sub_pd(_mm256_loadu_pd(x + 2 * i + 4), shift);
+        lin0 = _mm256_add_pd(lin0, d0);
+        lin1 = _mm256_add_pd(lin1, d1);
+        sq0 = _mm256_fmadd_pd(d0, d0, sq0);
+        sq1 = _mm256_fmadd_pd(d1, d1, sq1);
+        cr0 = _mm256_fmadd_pd(d0, _mm256_permute_pd(d0, 0x5), cr0);
+        cr1 = _mm256_fmadd_pd(d1, _mm256_permute_pd(d1, 0x5), cr1);
+    }
+    double lin[4], sq[4], cr[4];
+    _mm256_storeu_pd(lin, _mm256_add_pd(lin0, lin1));
+    _mm256_storeu_pd(sq, _mm256_add_pd(sq0, sq1));
+    _mm256_storeu_pd(cr, _mm256_add_pd(cr0, cr1));
+    double tail[5];
+    momentsBlockScalarAoS(x + 2 * i, NULL, n - i, sx, sy, tail);
+    out[0] = lin[0] + lin[2] + tail[0];
+    out[1] = lin[1] + lin[3] + tail[1];
+    out[2] = sq[0] + sq[2] + tail[2];
+    out[3] = 0.5 * (cr[0] + cr[1] + cr[2] + cr[3]) + tail[3];
+    out[4] = sq[1] + sq[3] + tail[4];
+}
+
+__attribute__((target("avx2,fma"))) static void momentsBlockAVX2SoA(const double *x, const double *y, size_t n,
+                                                                     double sx, double sy, double *out) {
+    const __m256d vsx = _mm256_set1_pd(sx);
+    const __m256d vsy = _mm256_set1_pd(sy);
+    __m256d ax[2], ay[2], axx[2], axy[2], ayy[2];
+    for (int u = 0; u < 2; u++) {
+        ax[u] = ay[u] = axx[u] = axy[u] = ayy[u] = _mm256_setzero_pd();
+    }
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        for (int u = 0; u < 2; u++) {
+            __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x + i + 4 * u), vsx);
+            __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(y + i + 4 * u), vsy);
+            ax[u] = _mm256_add_pd(ax[u], dx);
+            ay[u] = _mm256_add_pd(ay[u], dy);
+            axx[u] = _mm256_fmadd_pd(dx, dx, axx[u]);
+            axy[u] = _mm256_fmadd_pd(dx, dy, axy[u]);
+            ayy[u] = _mm256_fmadd_pd(dy, dy, ayy[u]);
+        }
+    }
+    double tail[5];
+    momentsBlockScalarSoA(x + i, y + i, n - i, sx, sy, tail);
+    out[0] = momentsHsum256(_mm256_add_pd(ax[0], ax[1])) + tail[0];
+    out[1] = momentsHsum256(_mm256_add_pd(ay[0], ay[1])) + tail[1];
+    out[2] = momentsHsum256(_mm256_add_pd(axx[0], axx[1])) + tail[2];
+    out[3] = momentsHsum256(_mm256_add_pd(axy[0], axy[1])) + tail[3];
+    out[4] = momentsHsum256(_mm256_add_pd(ayy[0], ayy[1])) + tail[4];
+}
+
+__attribute__((target("avx512f"))) static void momentsBlockAVX512AoS(const double *x, const double *y, size_t n,
+                                                                      double sx, double sy, double *out) {
+    (void)y;
+    const __m512d shift = _mm512_setr_pd(sx, sy, sx, sy, sx, sy, sx, sy);
+    __m512d lin0 = _mm512_setzero_pd(), lin1 = _mm512_setzero_pd();
+    __m512d sq0 = _mm512_setzero_pd(), sq1 = _mm512_setzero_pd();
+    __m512d cr0 = _mm512_setzero_pd(), cr1 = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d d0 = _mm512_sub_pd(_mm512_loadu_pd(x + 2 * i), shift);
+        __m512d d1 = _mm512_sub_pd(_mm512_loadu_pd(x + 2 * i + 8), shift);
+        lin0 = _mm512_add_pd(lin0, d0);
+        lin1 = _mm512_add_pd(lin1, d1);
+        sq0 = _mm512_fmadd_pd(d0, d0, sq0);
+        sq1 = _mm512_fmadd_pd(d1, d1, sq1);
+        cr0 = _mm512_fmadd_pd(d0, _mm512_permute_pd(d0, 0x55), cr0);
+        cr1 = _mm512_fmadd_pd(d1, _mm512_permute_pd(d1, 0x55), cr1);
+    }
+    double lin[8], sq[8], cr[8];
+    _mm512_storeu_pd(lin, _mm512_add_pd(lin0, lin1));
+    _mm512_storeu_pd(sq, _mm512_add_pd(sq0, sq1));
+    _mm512_storeu_pd(cr, _mm512_add_pd(cr0, cr1));
+    double tail[5];
+    momentsBlockScalarAoS(x + 2 * i, NULL, n - i, sx, sy, tail);
+    out[0] = tail[0];
+    out[1] = tail[1];
+    out[2] = tail[2];
+    out[3] = tail[3];
+    out[4] = tail[4];
+    double cross = 0;
+    for (int k = 0; k < 8; k += 2) {
+        out[0] += lin[k];
+        out[1] += lin[k + 1];
+        out[2] += sq[k];
+        out[4] += sq[k + 1];
+        cross += cr[k] + cr[k + 1];
+    }
+    out[3] += 0.5 * cross;
+}
+
+__attribute__((target("avx512f"))) static void momentsBlockAVX512SoA(const double *x, const double *y, size_t n,
+                                                                      double sx, double sy, double *out) {
+    const __m512d vsx = _mm512_set1_pd(sx);
+    const __m512d vsy = _mm512_set1_pd(sy);
+    __m512d ax[2], ay[2], axx[2], axy[2], ayy[2];
+    for (int u = 0; u < 2; u++) {
+        ax[u] = ay[u] = axx[u] = axy[u] = ayy[u] = _mm512_setzero_pd();
+    }
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        for (int u = 0; u < 2; u++) {
+            __m512d dx = _mm512_sub_pd(_mm512_loadu_pd(x + i + 8 * u), vsx);
+            __m512d dy = _mm512_sub_pd(_mm512_loadu_pd(y + i + 8 * u), vsy);
+            ax[u] = _mm512_add_pd(ax[u], dx);
+            ay[u] = _mm512_add_pd(ay[u], dy);
+            axx[u] = _mm512_fmadd_pd(dx, dx, axx[u]);
+            axy[u] = _mm512_fmadd_pd(dx, dy, axy[u]);
+            ayy[u] = _mm512_fmadd_pd(dy, dy, ayy[u]);
+        }
+    }
+    double tail[5];
+    momentsBlockScalarSoA(x + i, y + i, n - i, sx, sy, tail);
+    out[0] = _mm512_reduce_add_pd(_mm512_add_pd(ax[0], ax[1])) + tail[0];
+    out[1] = _mm512_reduce_add_pd(_mm512_add_pd(ay[0], ay[1])) + tail[1];
+    out[2] = _mm512_reduce_add_pd(_mm512_add_pd(axx[0], axx[1])) + tail[2];
+    out[3] = _mm512_reduce_add_pd(_mm512_add_pd(axy[0], axy[1])) + tail[3];
+    out[4] = _mm512_reduce_add_pd(_mm512_add_pd(ayy[0], ayy[1])) + tail[4];
+}
+#endif
+
+// Pilih kernel terbaik yang didukung CPU saat runtime
+MomentsKernel selectMomentsKernel(void) {
+#if MOMENTS_HAVE_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return MOMENTS_KERNEL_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return MOMENTS_KERNEL_AVX2;
+    }
+#endif
+    return MOMENTS_KERNEL_SCALAR;
+}
+
+const char *momentsKernelName(MomentsKernel kernel) {
+    switch (kernel) {
+    case MOMENTS_KERNEL_AUTO:
+        return momentsKernelName(selectMomentsKernel());
+    case MOMENTS_KERNEL_SCALAR:
+        return "scalar";
+    case MOMENTS_KERNEL_AVX2:
+        return "avx2";
+    case MOMENTS_KERNEL_AVX512:
+        return "avx512";
+    }
+    return "unknown";
+}
+
+static MomentsBlockFn momentsBlockFunction(MomentsKernel kernel, int aos) {
+    // Deteksi CPU sekali; atomic karena bisa dipanggil dari banyak thread sekaligus
+    static MomentsKernel detected = MOMENTS_KERNEL_AUTO;
+    if (kernel == MOMENTS_KERNEL_AUTO) {
+        kernel = __atomic_load_n(&detected, __ATOMIC_RELAXED);
+        if (kernel == MOMENTS_KERNEL_AUTO) {
+            kernel = selectMomentsKernel();
+            __atomic_store_n(&detected, kernel, __ATOMIC_RELAXED);
+        }
+    }
+#if MOMENTS_HAVE_X86
+    if (kernel == MOMENTS_KERNEL_AVX512) {
+        return aos ? momentsBlockAVX512AoS : momentsBlockAVX512SoA;
+    }
+    if (kernel == MOMENTS_KERNEL_AVX2) {
+        return aos ? momentsBlockAVX2AoS : momentsBlockAVX2SoA;
+    }
+#endif
+    return aos ? momentsBlockScalarAoS : momentsBlockScalarSoA;
+}
+
+// Penjumlahan terkompensasi Neumaier
+static inline void momentsCompensatedAdd(double *sum, double *compensation, double value) {
+    double t = *sum + value;
+    if (fabs(*sum) >= fabs(value)) {
+        *compensation += (*sum - t) + value;
+    } else {
+        *compensation += (value - t) + *sum;
+    }
+    *sum = t;
+}
+
+static Moments computeMomentsBlocked(MomentsBlockFn block, const double *x, const double *y, size_t stride,
+                                     size_t num_points) {
+    Moments m;
+    memset(&m, 0, sizeof(m));
+    m.n = (double)num_points;
+    if (num_points == 0) {
+        return m;
+    }
+    m.shift_x = x[0];
+    m.shift_y = y[0];
+
+    double sum[5] = {0}, comp[5] = {0};
+    for (size_t start = 0; start < num_points; start += MOMENTS_BLOCK) {
+        size_t count = num_points - start < MOMENTS_BLOCK ? num_points - start : MOMENTS_BLOCK;
+        double partial[5];
+        block(x + start * stride, y + start * stride, count, m.shift_x, m.shift_y, partial);
+        for (int k = 0; k < 5; k++) {
+            momentsCompensatedAdd(&sum[k], &comp[k], partial[k]);
+        }
+    }
+    m.sum_x = sum[0] + comp[0];
+    m.sum_y = sum[1] + comp[1];
+    m.sum_xx = sum[2] + comp[2];
+    m.sum_xy = sum[3] + comp[3];
+    m.sum_yy = sum[4] + comp[4];
+    return m;
+}
+
+Moments computeMomentsInterleavedWith(MomentsKernel kernel, const double *xy, size_t num_points) {
+    return computeMomentsBlocked(momentsBlockFunction(kernel, 1), xy, xy + 1, 2, num_points);
+}
+
+Moments computeMomentsColumnsWith(MomentsKernel kernel, const double *x, const double *y, size_t num_points) {
+    return computeMomentsBlocked(momentsBlockFunction(kernel, 0), x, y, 1, num_points);
+}
+
+// Semua momen dalam satu lintasan data AoS berpasangan [x0 y0 x1 y1 ...] (array DataPoint)
+Moments computeMomentsInterleaved(const double *xy, size_t num_points) {
+    return computeMomentsInterleavedWith(MOMENTS_KERNEL_AUTO, xy, num_points);
+}
+
+// Semua momen dalam satu lintasan data kolumnar (SoA)
+Moments computeMomentsColumns(const double *x, const double *y, size_t num_points) {
+    return computeMomentsColumnsWith(MOMENTS_KERNEL_AUTO, x, y, num_points);
+}
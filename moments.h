@@ -0,0 +1,48 @@
+#ifndef MOMENTS_H
+#define MOMENTS_H
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define MOMENTS_HAVE_X86 1
+#else
+#define MOMENTS_HAVE_X86 0
+#endif
+
+// Jumlah titik per blok. Di dalam blok dijumlah dengan beberapa akumulator biasa,
+// antar blok digabung dengan penjumlahan terkompensasi (Neumaier), sehingga error
+// tetap kecil walaupun jumlah titik mencapai 10^9.
+#define MOMENTS_BLOCK 1024
+
+// Momen orde dua dari pasangan (x, y) relatif terhadap titik acuan (shift) untuk
+// mengurangi cancellation pada data yang jauh dari nol
+typedef struct {
+    double n;
+    double shift_x;
+    double shift_y;
+    double sum_x;  // Σ(x - shift_x)
+    double sum_y;  // Σ(y - shift_y)
+    double sum_xx; // Σ(x - shift_x)²
+    double sum_xy; // Σ(x - shift_x)(y - shift_y)
+    double sum_yy; // Σ(y - shift_y)²
+} Moments;
+
+typedef enum {
+    MOMENTS_KERNEL_AUTO,
+    MOMENTS_KERNEL_SCALAR,
+    MOMENTS_KERNEL_AVX2,
+    MOMENTS_KERNEL_AVX512
+} MomentsKernel;
+
+// Deklarasi fungsi
+MomentsKernel selectMomentsKernel(void);
+const char *momentsKernelName(MomentsKernel kernel);
+Moments computeMomentsInterleaved(const double *xy, size_t num_points);
+Moments computeMomentsColumns(const double *x, const double *y, size_t num_points);
+Moments computeMomentsInterleavedWith(MomentsKernel kernel, const double *xy, size_t num_points);
+Moments computeMomentsColumnsWith(MomentsKernel kernel, const double *x, const double *y, size_t num_points);
+
+#endif
@@ -0,0 +1,254 @@
+#include "nonlinear.h"
+
+void defaultLMOptions(LMOptions *options) {
+    options->max_iterations = 200;
+    options->ftol = 1e-12;
+    options->xtol = 1e-10;
+    options->gtol = 1e-10;
+    options->initial_lambda = 1e-3;
+    options->pool = NULL;
+    options->workspace = NULL;
+}
+
+const char *lmStatusName(LMStatus status) {
+    switch (status) {
+    case LM_CONVERGED_COST:
+        return "Konvergen (cost)";
+    case LM_CONVERGED_STEP:
+        return "Konvergen (langkah)";
+    case LM_CONVERGED_GRADIENT:
+        return "Konvergen (gradien)";
+    case LM_MAX_ITERATIONS:
+        return "Batas iterasi tercapai";
+    default:
+        return "Gagal";
+    }
+}
+
+// Tambahkan satu blok baris Jacobian ke JᵀJ (segitiga atas), Jᵀr dan Σr². Selalu di-inline
+// dengan p konstan untuk model kecil, sehingga loop j/k terbuka dan akumulator tetap di register.
+static inline __attribute__((always_inline)) void lmAccumulateRows(const double *jacobian, const double *values,
+                                                                   const double *y, size_t stride, size_t count,
+                                                                   int p, LMNormalEquations *out) {
+    double jtj[LM_MAX_PARAMS * LM_MAX_PARAMS] = {0};
+    double jtr[LM_MAX_PARAMS] = {0};
+    double cost = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        const double *row = jacobian + i * p;
+        double r = y[i * stride] - values[i];
+        cost += r * r;
+#pragma GCC unroll 8
+        for (int j = 0; j < p; j++) {
+            jtr[j] += row[j] * r;
+#pragma GCC unroll 8
+            for (int k = j; k < p; k++) {
+                jtj[j * p + k] += row[j] * row[k];
+            }
+        }
+    }
+    out->cost += cost;
+    for (int j = 0; j < p; j++) {
+        out->jtr[j] += jtr[j];
+        for (int k = j; k < p; k++) {
+            out->jtj[j * p + k] += jtj[j * p + k];
+        }
+    }
+}
+
+// Satu lintasan gabungan atas titik [begin, end): residual, JᵀJ (segitiga atas) dan Jᵀr.
+// Model dievaluasi per blok sehingga nilai dan turunan berbagi perhitungan mahal (exp).
+void lmAccumulate(const NonlinearModel *model, const double *params, const double *x, const double *y,
+                  size_t stride, size_t begin, size_t end, LMNormalEquations *out) {
+    int p = model->num_params;
+    double values[LM_BLOCK];
+    double jacobian[LM_BLOCK * LM_MAX_PARAMS];
+    memset(out, 0, sizeof(*out));
+
+    for (size_t start = begin; start < end; start += LM_BLOCK) {
+        size_t count = end - start < LM_BLOCK ? end - start : LM_BLOCK;
+        const double *y_block = y + start * stride;
+        model->eval(params, x + start * stride, stride, count, values, jacobian, model->ctx);
+        switch (p) {
+        case 2:
+            lmAccumulateRows(jacobian, values, y_block, stride, count, 2, out);
+            break;
+        case 3:
+            lmAccumulateRows(jacobian, values, y_block, stride, count, 3, out);
+            break;
+        case 4:
+            lmAccumulateRows(jacobian, values, y_block, stride, count, 4, out);
+            break;
+        default:
+            lmAccumulateRows(jacobian, values, y_block, stride, count, p, out);
+            break;
+        }
+    }
+    for (int j = 0; j < p; j++) {
+        for (int k = 0; k < j; k++) {
+            out->jtj[j * p + k] = out->jtj[k * p + j];
+        }
+    }
+}
+
+typedef struct {
+    const NonlinearModel *model;
+    const double *params;
+    const double *x;
+    const double *y;
+    size_t stride;
+    size_t n;
+    LMNormalEquations *partials;
+} LMChunkJob;
+
+static void lmChunkWork(void *arg, size_t chunk) {
+    LMChunkJob *job = (LMChunkJob *)arg;
+    size_t begin = chunk * LM_CHUNK;
+    size_t end = begin + LM_CHUNK < job->n ? begin + LM_CHUNK : job->n;
+    lmAccumulate(job->model, job->params, job->x, job->y, job->stride, begin, end, &job->partials[chunk]);
+}
+
+// Persamaan normal untuk seluruh n titik. Data dibagi ke chunk LM_CHUNK titik yang dikerjakan
+// paralel di pool, lalu hasil parsial dijumlah berurutan menurut indeks chunk. Karena batas
+// chunk tidak bergantung jumlah thread, hasilnya identik bit per bit untuk 1 atau N thread.
+// partials harus muat ceil(n / LM_CHUNK) elemen.
+void lmEvaluate(const NonlinearModel *model, const double *params, const double *x, const double *y, size_t stride,
+                size_t n, ThreadPool *pool, LMNormalEquations *partials, LMNormalEquations *out) {
+    size_t num_chunks = (n + LM_CHUNK - 1) / LM_CHUNK;
+    LMChunkJob job = {model, params, x, y, stride, n, partials};
+    threadPoolParallelFor(pool, num_chunks, lmChunkWork, &job);
+
+    int p = model->num_params;
+    memset(out, 0, sizeof(*out));
+    for (size_t c = 0; c < num_chunks; c++) {
+        out->cost += partials[c].cost;
+        for (int j = 0; j < p; j++) {
+            out->jtr[j] += partials[c].jtr[j];
+        }
+        for (int j = 0; j < p * p; j++) {
+            out->jtj[j] += partials[c].jtj[j];
+        }
+    }
+}
+
+// Levenberg-Marquardt dengan damping diagonal (Marquardt): selesaikan
+// (JᵀJ + λ diag(JᵀJ)) δ = Jᵀr dengan Cholesky. Langkah diterima jika cost turun (λ diperkecil),
+// ditolak jika tidak (λ diperbesar). Setiap langkah yang dicoba butuh tepat satu lintasan data.
+// params berisi tebakan awal dan ditimpa hasil. Return 0 jika konvergen, -1 jika tidak.
+int levenbergMarquardt(const NonlinearModel *model, const double *x, const double *y, size_t stride, size_t n,
+                       double *params, const LMOptions *options, LMReport *report) {
+    int p = model->num_params;
+    double start_time = monotonicSeconds();
+    LMOptions defaults;
+    if (!options) {
+        defaultLMOptions(&defaults);
+        options = &defaults;
+    }
+    LMReport local_report;
+    if (!report) {
+        report = &local_report;
+    }
+    memset(report, 0, sizeof(*report));
+    report->status = LM_FAILED;
+    if (p < 1 || p > LM_MAX_PARAMS || n < (size_t)p) {
+        return -1;
+    }
+
+    size_t partials_size = ((n + LM_CHUNK - 1) / LM_CHUNK) * sizeof(LMNormalEquations);
+    FitWorkspace *ws = options->workspace;
+    LMNormalEquations *partials =
+        (LMNormalEquations *)(ws ? fitWorkspaceAlloc(ws, partials_size) : malloc(partials_size));
+    if (!partials) {
+        return -1;
+    }
+    LMNormalEquations current, trial;
+    lmEvaluate(model, params, x, y, stride, n, options->pool, partials, &current);
+    report->evaluations = 1;
+    report->initial_cost = current.cost;
+    if (!isfinite(current.cost)) {
+        report->final_cost = current.cost;
+        report->seconds = monotonicSeconds() - start_time;
+        if (!ws) {
+            free(partials);
+        }
+        return -1;
+    }
+
+    double lambda = options->initial_lambda;
+    report->status = LM_MAX_ITERATIONS;
+    while (report->iterations < options->max_iterations) {
+        // Gradien sudah (hampir) nol: kosinus antara residual dan setiap kolom J
+        double gradient = 0.0;
+        for (int j = 0; j < p; j++) {
+            double denom = sqrt(current.jtj[j * p + j] * current.cost);
+            if (denom > 0) {
+                double g = fabs(current.jtr[j]) / denom;
+                gradient = g > gradient ? g : gradient;
+            }
+        }
+        if (gradient <= options->gtol) {
+            report->status = LM_CONVERGED_GRADIENT;
+            break;
+        }
+
+        double matrix[LM_MAX_PARAMS * LM_MAX_PARAMS];
+        double step[LM_MAX_PARAMS];
+        memcpy(matrix, current.jtj, sizeof(double) * p * p);
+        memcpy(step, current.jtr, sizeof(double) * p);
+        for (int j = 0; j < p; j++) {
+            double d = current.jtj[j * p + j];
+            matrix[j * p + j] += lambda * (d > DBL_MIN ? d : 1.0);
+        }
+        if (choleskySolve(matrix, p, step) != 0) {
+            lambda *= 10.0;
+            if (lambda > 1e16) {
+                report->status = LM_FAILED;
+                break;
+            }
+            continue;
+        }
+
+        double candidate[LM_MAX_PARAMS];
+        double step_norm = 0.0, param_norm = 0.0;
+        for (int j = 0; j < p; j++) {
+            candidate[j] = params[j] + step[j];
+            step_norm += step[j] * step[j];
+            param_norm += params[j] * params[j];
+        }
+        lmEvaluate(model, candidate, x, y, stride, n, options->pool, partials, &trial);
+        report->evaluations++;
+
+        if (isfinite(trial.cost) && trial.cost < current.cost) {
+            double reduction = current.cost - trial.cost;
+            memcpy(params, candidate, sizeof(double) * p);
+            current = trial;
+            report->iterations++;
+            lambda = lambda * 0.1 > 1e-12 ? lambda * 0.1 : 1e-12;
+
+            if (reduction <= options->ftol * (current.cost + reduction)) {
+                report->status = LM_CONVERGED_COST;
+                break;
+            }
+            if (sqrt(step_norm) <= options->xtol * (sqrt(param_norm) + options->xtol)) {
+                report->status = LM_CONVERGED_STEP;
+                break;
+            }
+        } else {
+            lambda *= 10.0;
+            // Damping sangat besar tanpa penurunan cost: sudah di minimum (dalam presisi double)
+            if (lambda > 1e16 || sqrt(step_norm) <= options->xtol * (sqrt(param_norm) + options->xtol)) {
+                report->status = LM_CONVERGED_STEP;
+                break;
+            }
+        }
+    }
+
+    if (!ws) {
+        free(partials);
+    }
+    report->final_cost = current.cost;
+    report->seconds = monotonicSeconds() - start_time;
+    return report->status == LM_CONVERGED_COST || report->status == LM_CONVERGED_STEP ||
+                   report->status == LM_CONVERGED_GRADIENT
+               ? 0
+               : -1;
+}
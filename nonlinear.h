@@ -0,0 +1,76 @@
+#ifndef NONLINEAR_H
+#define NONLINEAR_H
+
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+#include "csv_fast.h"
+#include "linalg.h"
+#include "thread_pool.h"
+#include "workspace.h"
+
+// Least squares nonlinear dengan Levenberg-Marquardt. Model apa pun bisa dipasang
+// lewat NonlinearModel: cukup sediakan fungsi yang menghitung nilai model dan turunannya
+// terhadap setiap parameter untuk satu blok titik.
+
+#define LM_MAX_PARAMS 8
+#define LM_BLOCK 256    // Titik per blok evaluasi model
+#define LM_CHUNK 32768  // Titik per chunk paralel; tetap, tidak bergantung jumlah thread
+
+// Hitung nilai model values[i] = f(x_i; params) dan Jacobian jacobian[i * num_params + k] =
+// ∂f/∂params[k] untuk n titik x dengan stride tertentu
+typedef void (*NonlinearEvalFn)(const double *params, const double *x, size_t stride, size_t n,
+                                double *values, double *jacobian, const void *ctx);
+
+typedef struct {
+    int num_params;
+    NonlinearEvalFn eval;
+    const void *ctx; // Data tambahan untuk model (misalnya normalisasi x)
+} NonlinearModel;
+
+typedef struct {
+    int max_iterations;
+    double ftol;             // Berhenti jika penurunan relatif cost <= ftol
+    double xtol;             // Berhenti jika langkah relatif parameter <= xtol
+    double gtol;             // Berhenti jika gradien (dinormalisasi) <= gtol
+    double initial_lambda;   // Damping awal
+    ThreadPool *pool;        // Pool untuk lintasan data paralel (NULL = thread pemanggil saja)
+    FitWorkspace *workspace; // Sumber buffer hasil parsial per chunk (NULL = malloc per panggilan)
+} LMOptions;
+
+typedef enum {
+    LM_CONVERGED_COST,
+    LM_CONVERGED_STEP,
+    LM_CONVERGED_GRADIENT,
+    LM_MAX_ITERATIONS,
+    LM_FAILED
+} LMStatus;
+
+typedef struct {
+    LMStatus status;
+    int iterations;   // Langkah yang diterima
+    int evaluations;  // Lintasan data (satu per langkah yang dicoba)
+    double initial_cost;
+    double final_cost; // Σ residual² pada parameter akhir
+    double seconds;
+} LMReport;
+
+// Persamaan normal hasil satu lintasan data: JᵀJ, Jᵀr dan Σr² (r = y - f)
+typedef struct {
+    double jtj[LM_MAX_PARAMS * LM_MAX_PARAMS];
+    double jtr[LM_MAX_PARAMS];
+    double cost;
+} LMNormalEquations;
+
+// Deklarasi fungsi
+void defaultLMOptions(LMOptions *options);
+const char *lmStatusName(LMStatus status);
+void lmAccumulate(const NonlinearModel *model, const double *params, const double *x, const double *y,
+                  size_t stride, size_t begin, size_t end, LMNormalEquations *out);
+void lmEvaluate(const NonlinearModel *model, const double *params, const double *x, const double *y, size_t stride,
+                size_t n, ThreadPool *pool, LMNormalEquations *partials, LMNormalEquations *out);
+int levenbergMarquardt(const NonlinearModel *model, const double *x, const double *y, size_t stride, size_t n,
+                       double *params, const LMOptions *options, LMReport *report);
+
+#endif
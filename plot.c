@@ -0,0 +1,933 @@
+#include "plot.h"
+
+void defaultPlotOptions(PlotOptions *options) {
+    options->width = PLOT_DEFAULT_WIDTH;
+    options->height = PLOT_DEFAULT_HEIGHT;
+    options->title = "Data Points dan Kurva Regresi";
+    options->x_label = "X";
+    options->y_label = "Y";
+}
+
+// ".svg" menghasilkan SVG, selain itu PNG
+PlotFormat plotFormatFromPath(const char *path) {
+    size_t length = strlen(path);
+    return length >= 4 && strcmp(path + length - 4, ".svg") == 0 ? PLOT_FORMAT_SVG : PLOT_FORMAT_PNG;
+}
+
+// Layout: rentang data, tick "bagus" (1, 2, 5 × 10^k) dan pemetaan ke piksel
+
+static double plotNiceStep(double span) {
+    double raw = span / PLOT_TARGET_TICKS;
+    double magnitude = pow(10.0, floor(log10(raw)));
+    double fraction = raw / magnitude;
+    return (fraction < 1.5 ? 1.0 : fraction < 3.0 ? 2.0 : fraction < 7.0 ? 5.0 : 10.0) * magnitude;
+}
+
+static void plotNiceRange(double lo, double hi, double *axis_min, double *axis_max, double *step) {
+    if (!(hi > lo)) {
+        double pad = lo != 0 ? fabs(lo) * 0.5 : 1.0;
+        lo -= pad;
+        hi += pad;
+    }
+    *step = plotNiceStep(hi - lo);
+    *axis_min = floor(lo / *step) * *step;
+    *axis_max = ceil(hi / *step) * *step;
+}
+
+static inline double plotMapX(const PlotLayout *layout, double x) {
+    return layout->left + (x - layout->x_min) / (layout->x_max - layout->x_min) * (layout->right - layout->left);
+}
+
+static inline double plotMapY(const PlotLayout *layout, double y) {
+    return layout->bottom - (y - layout->y_min) / (layout->y_max - layout->y_min) * (layout->bottom - layout->top);
+}
+
+// Koordinat piksel dijepit supaya nilai ekstrem tidak overflow saat dikonversi ke int
+static inline int plotPixel(double value) {
+    if (!(value > -1e6)) {
+        return -1000000;
+    }
+    return value < 1e6 ? (int)lround(value) : 1000000;
+}
+
+typedef struct {
+    const CompiledModel *model;
+    double x0, dx;  // x = x0 + indeks * dx
+    double y_scale; // Piksel per satuan y
+    double *cx, *cy;
+    size_t count;
+} PlotCurveSampler;
+
+static inline double plotCurveX(const PlotCurveSampler *s, size_t index) {
+    return s->x0 + (double)index * s->dx;
+}
+
+// Titik tengah ditambahkan di antara i0 dan i1; segmen dibelah lagi jika masih melengkung.
+// Urutan rekursi (kiri, tengah, kanan) menjaga sampel terurut menurut x.
+static void plotRefineCurve(PlotCurveSampler *s, size_t i0, double y0, size_t i1, double y1, int depth) {
+    size_t im = (i0 + i1) / 2;
+    double ym = compiledModelEvalOne(s->model, plotCurveX(s, im));
+    int bent;
+    if (isfinite(y0) && isfinite(y1) && isfinite(ym)) {
+        bent = fabs(ym - 0.5 * (y0 + y1)) * s->y_scale > PLOT_CURVE_TOLERANCE;
+    } else {
+        bent = isfinite(y0) || isfinite(y1) || isfinite(ym); // Batas daerah tak hingga dicari sampai piksel
+    }
+    int split = im - i0 > 1 && (depth < PLOT_CURVE_MIN_DEPTH || bent);
+    if (split) {
+        plotRefineCurve(s, i0, y0, im, ym, depth + 1);
+    }
+    s->cx[s->count] = plotCurveX(s, im);
+    s->cy[s->count++] = ym;
+    if (split) {
+        plotRefineCurve(s, im, ym, i1, y1, depth + 1);
+    }
+}
+
+// Sampel kurva adaptif menurut kelengkungan pada rentang x data: rapat di bagian yang
+// melengkung, jarang di bagian yang hampir lurus. x diambil dari grid 2^D titik (segmen
+// terkecil sekitar satu kolom piksel) dan dihitung dari indeks, jadi tanpa akumulasi galat
+// step. Skala y dari layout sementara. Return jumlah sampel (maksimal PLOT_MAX_CURVE_SAMPLES).
+static size_t plotSampleCurve(const PlotLayout *layout, const CompiledModel *model, double *cx, double *cy) {
+    size_t columns = (size_t)(layout->right - layout->left);
+    size_t segments = 2;
+    while (segments * 2 <= columns && segments * 2 < PLOT_MAX_CURVE_SAMPLES) {
+        segments *= 2;
+    }
+    PlotCurveSampler s = {model, layout->data_x_min, (layout->data_x_max - layout->data_x_min) / (double)segments,
+                          (layout->bottom - layout->top) / (layout->y_max - layout->y_min), cx, cy, 0};
+    double y0 = compiledModelEvalOne(model, s.x0);
+    double y1 = compiledModelEvalOne(model, layout->data_x_max);
+    cx[0] = s.x0;
+    cy[0] = y0;
+    s.count = 1;
+    plotRefineCurve(&s, 0, y0, segments, y1, 1);
+    cx[s.count] = layout->data_x_max;
+    cy[s.count++] = y1;
+    return s.count;
+}
+
+// Rentang sumbu dari data (titik NaN dilewati) dan dari kurva. Return -1 jika tidak ada titik.
+int plotComputeLayout(PlotLayout *layout, const PlotOptions *options, const double *x, const double *y,
+                      size_t stride, size_t n, const CompiledModel *model, double *cx, double *cy,
+                      size_t *num_samples) {
+    double x_lo = INFINITY, x_hi = -INFINITY, y_lo = INFINITY, y_hi = -INFINITY;
+    for (size_t i = 0; i < n; i++) {
+        double xv = x[i * stride], yv = y[i * stride];
+        if (!isfinite(xv) || !isfinite(yv)) {
+            continue;
+        }
+        x_lo = xv < x_lo ? xv : x_lo;
+        x_hi = xv > x_hi ? xv : x_hi;
+        y_lo = yv < y_lo ? yv : y_lo;
+        y_hi = yv > y_hi ? yv : y_hi;
+    }
+    if (x_lo > x_hi) {
+        return -1;
+    }
+
+    layout->width = options->width;
+    layout->height = options->height;
+    layout->left = PLOT_MARGIN_LEFT;
+    layout->right = options->width - PLOT_MARGIN_RIGHT;
+    layout->top = PLOT_MARGIN_TOP;
+    layout->bottom = options->height - PLOT_MARGIN_BOTTOM;
+    layout->data_x_min = x_lo;
+    layout->data_x_max = x_hi;
+    // Rentang y sementara dari data, untuk toleransi sampel kurva dalam piksel
+    plotNiceRange(y_lo, y_hi, &layout->y_min, &layout->y_max, &layout->y_step);
+
+    *num_samples = 0;
+    if (model) {
+        *num_samples = plotSampleCurve(layout, model, cx, cy);
+        for (size_t i = 0; i < *num_samples; i++) {
+            if (isfinite(cy[i])) {
+                y_lo = cy[i] < y_lo ? cy[i] : y_lo;
+                y_hi = cy[i] > y_hi ? cy[i] : y_hi;
+            }
+        }
+    }
+    plotNiceRange(x_lo, x_hi, &layout->x_min, &layout->x_max, &layout->x_step);
+    plotNiceRange(y_lo, y_hi, &layout->y_min, &layout->y_max, &layout->y_step);
+    return 0;
+}
+
+typedef struct {
+    const PlotLayout *layout;
+    int cell;
+    int columns, rows;
+    const double *x, *y;
+    size_t stride, n;
+    size_t num_parts;
+    uint8_t **occupied; // Peta sel per bagian (columns × rows byte)
+} PlotLODJob;
+
+static void plotLODWork(void *arg, size_t part) {
+    PlotLODJob *job = (PlotLODJob *)arg;
+    const PlotLayout *layout = job->layout;
+    uint8_t *occupied = job->occupied[part];
+    size_t begin = job->n * part / job->num_parts;
+    size_t end = job->n * (part + 1) / job->num_parts;
+    for (size_t i = begin; i < end; i++) {
+        double xv = job->x[i * job->stride], yv = job->y[i * job->stride];
+        if (!isfinite(xv) || !isfinite(yv)) {
+            continue;
+        }
+        // Pembulatan sama dengan rasterizer, jadi sel 1 piksel = piksel tempat titik digambar
+        int column = (plotPixel(plotMapX(layout, xv)) - layout->left) / job->cell;
+        int row = (plotPixel(plotMapY(layout, yv)) - layout->top) / job->cell;
+        column = column < 0 ? 0 : (column >= job->columns ? job->columns - 1 : column);
+        row = row < 0 ? 0 : (row >= job->rows ? job->rows - 1 : row);
+        occupied[(size_t)column * job->rows + row] = 1;
+    }
+}
+
+// Ringkas scatter untuk plot (level of detail): setiap titik dipetakan ke sel cell × cell piksel
+// pada layout, dan setiap sel yang terisi diwakili satu titik di tengah sel. Jumlah titik per
+// kolom piksel jadi terbatas oleh tinggi plot berapa pun ukuran data, dan dengan cell 1 hasil
+// raster sama dengan menggambar semua titik. Satu lintasan paralel: setiap thread mengisi peta
+// sel sendiri, lalu peta digabung. Hasil (x, y) berselang-seling di *points (stride 2, bebaskan
+// dengan free), terurut per kolom. pool NULL berarti serial. Return 0 jika berhasil, -1 jika gagal.
+int plotDownsample(const PlotLayout *layout, int cell, const double *x, const double *y, size_t stride, size_t n,
+                   ThreadPool *pool, double **points, size_t *count) {
+    cell = cell < 1 ? 1 : cell;
+    PlotLODJob job = {layout, cell, (layout->right - layout->left) / cell + 1, (layout->bottom - layout->top) / cell + 1,
+                      x, y, stride, n, 1, NULL};
+    size_t cells = (size_t)job.columns * job.rows;
+    size_t max_parts = n / PLOT_LOD_MIN_PART + 1;
+    job.num_parts = pool && (size_t)pool->num_threads < max_parts ? (size_t)pool->num_threads : (pool ? max_parts : 1);
+    job.occupied = (uint8_t **)calloc(job.num_parts, sizeof(uint8_t *));
+    int ok = job.occupied != NULL;
+    for (size_t i = 0; ok && i < job.num_parts; i++) {
+        job.occupied[i] = (uint8_t *)calloc(cells, 1);
+        ok = job.occupied[i] != NULL;
+    }
+    *points = NULL;
+    *count = 0;
+    if (ok) {
+        threadPoolParallelFor(pool, job.num_parts, plotLODWork, &job);
+        uint8_t *merged = job.occupied[0];
+        size_t occupied = 0;
+        for (size_t c = 0; c < cells; c++) {
+            for (size_t i = 1; i < job.num_parts; i++) {
+                merged[c] |= job.occupied[i][c];
+            }
+            occupied += merged[c];
+        }
+        *points = (double *)malloc((occupied ? occupied : 1) * 2 * sizeof(double));
+        ok = *points != NULL;
+        // Tengah sel kembali ke koordinat data (kebalikan plotMapX/plotMapY)
+        double x_per_pixel = (layout->x_max - layout->x_min) / (layout->right - layout->left);
+        double y_per_pixel = (layout->y_max - layout->y_min) / (layout->bottom - layout->top);
+        double center = (cell - 1) * 0.5;
+        for (int column = 0; ok && column < job.columns; column++) {
+            const uint8_t *rows = merged + (size_t)column * job.rows;
+            for (int row = 0; row < job.rows; row++) {
+                if (rows[row]) {
+                    (*points)[2 * *count] = layout->x_min + (column * cell + center) * x_per_pixel;
+                    (*points)[2 * *count + 1] = layout->y_max - (row * cell + center) * y_per_pixel;
+                    (*count)++;
+                }
+            }
+        }
+    }
+    for (size_t i = 0; job.occupied && i < job.num_parts; i++) {
+        free(job.occupied[i]);
+    }
+    free(job.occupied);
+    return ok ? 0 : -1;
+}
+
+// Label tick tanpa noise pembulatan (0.30000000000000004 -> 0.3)
+static int plotFormatTick(double value, double step, char *out) {
+    if (fabs(value) < step * 1e-9) {
+        value = 0.0;
+    }
+    int length = formatDouble(value, 6, out);
+    out[length] = '\0';
+    return length;
+}
+
+// Persamaan model untuk legenda
+void plotModelLabel(const RegressionResult *result, char *out, size_t size) {
+    switch (result->type) {
+    case REGRESSION_LINEAR:
+        snprintf(out, size, "Regresi Linear y = %.4gx + %.4g", result->slope, result->intercept);
+        break;
+    case REGRESSION_POLYNOMIAL:
+        snprintf(out, size, "Regresi Polynomial derajat %d", result->degree);
+        break;
+    case REGRESSION_LOGISTIC:
+        snprintf(out, size, "Regresi Logistic y = %.4g / (1 + %.4g e^(-%.4g (x - %.4g)))", result->c, result->a,
+                 result->b, result->mean_x);
+        break;
+    }
+}
+
+// Raster RGB dan font bitmap 5x7
+
+typedef struct {
+    int width;
+    int height;
+    uint8_t *pixels; // RGB, baris dari atas
+    // Area klip (untuk kurva dan titik)
+    int clip_left, clip_top, clip_right, clip_bottom;
+} PlotCanvas;
+
+typedef struct {
+    uint8_t r, g, b;
+} PlotColor;
+
+static const PlotColor plot_white = {255, 255, 255};
+static const PlotColor plot_black = {0, 0, 0};
+static const PlotColor plot_grid = {225, 225, 225};
+static const PlotColor plot_point_color = {31, 119, 180};
+static const PlotColor plot_curve_color = {214, 39, 40};
+
+// Font 5x7 untuk ASCII 32..126: 5 kolom per karakter, bit 0 = baris teratas
+static const uint8_t plot_font[95][5] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5F, 0x00, 0x00}, {0x00, 0x07, 0x00, 0x07, 0x00},
+    {0x14, 0x7F, 0x14, 0x7F, 0x14}, {0x24, 0x2A, 0x7F, 0x2A, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62},
+    {0x36, 0x49, 0x55, 0x22, 0x50}, {0x00, 0x05, 0x03, 0x00, 0x00}, {0x00, 0x1C, 0x22, 0x41, 0x00},
+    {0x00, 0x41, 0x22, 0x1C, 0x00}, {0x08, 0x2A, 0x1C, 0x2A, 0x08}, {0x08, 0x08, 0x3E, 0x08, 0x08},
+    {0x00, 0x50, 0x30, 0x00, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08}, {0x00, 0x60, 0x60, 0x00, 0x00},
+    {0x20, 0x10, 0x08, 0x04, 0x02}, {0x3E, 0x51, 0x49, 0x45, 0x3E}, {0x00, 0x42, 0x7F, 0x40, 0x00},
+    {0x42, 0x61, 0x51, 0x49, 0x46}, {0x21, 0x41, 0x45, 0x4B, 0x31}, {0x18, 0x14, 0x12, 0x7F, 0x10},
+    {0x27, 0x45, 0x45, 0x45, 0x39}, {0x3C, 0x4A, 0x49, 0x49, 0x30}, {0x01, 0x71, 0x09, 0x05, 0x03},
+    {0x36, 0x49, 0x49, 0x49, 0x36}, {0x06, 0x49, 0x49, 0x29, 0x1E}, {0x00, 0x36, 0x36, 0x00, 0x00},
+    {0x00, 0x56, 0x36, 0x00, 0x00}, {0x08, 0x14, 0x22, 0x41, 0x00}, {0x14, 0x14, 0x14, 0x14, 0x14},
+    {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x51, 0x09, 0x06}, {0x32, 0x49, 0x79, 0x41, 0x3E},
+    {0x7E, 0x11, 0x11, 0x11, 0x7E}, {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22},
+    {0x7F, 0x41, 0x41, 0x22, 0x1C}, {0x7F, 0x49, 0x49, 0x49, 0x41}, {0x7F, 0x09, 0x09, 0x09, 0x01},
+    {0x3E, 0x41, 0x49, 0x49, 0x7A}, {0x7F, 0x08, 0x08, 0x08, 0x7F}, {0x00, 0x41, 0x7F, 0x41, 0x00},
+    {0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41}, {0x7F, 0x40, 0x40, 0x40, 0x40},
+    {0x7F, 0x02, 0x0C, 0x02, 0x7F}, {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E},
+    {0x7F, 0x09, 0x09, 0x09, 0x06}, {0x3E, 0x41, 0x51, 0x21, 0x5E}, {0x7F, 0x09, 0x19, 0x29, 0x46},
+    {0x46, 0x49, 0x49, 0x49, 0x31}, {0x01, 0x01, 0x7F, 0x01, 0x01}, {0x3F, 0x40, 0x40, 0x40, 0x3F},
+    {0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x3F, 0x40, 0x38, 0x40, 0x3F}, {0x63, 0x14, 0x08, 0x14, 0x63},
+    {0x07, 0x08, 0x70, 0x08, 0x07}, {0x61, 0x51, 0x49, 0x45, 0x43}, {0x00, 0x7F, 0x41, 0x41, 0x00},
+    {0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x7F, 0x00}, {0x04, 0x02, 0x01, 0x02, 0x04},
+    {0x40, 0x40, 0x40, 0x40, 0x40}, {0x00, 0x01, 0x02, 0x04, 0x00}, {0x20, 0x54, 0x54, 0x54, 0x78},
+    {0x7F, 0x48, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x20}, {0x38, 0x44, 0x44, 0x48, 0x7F},
+    {0x38, 0x54, 0x54, 0x54, 0x18}, {0x08, 0x7E, 0x09, 0x01, 0x02}, {0x0C, 0x52, 0x52, 0x52, 0x3E},
+    {0x7F, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7D, 0x40, 0x00}, {0x20, 0x40, 0x44, 0x3D, 0x00},
+    {0x7F, 0x10, 0x28, 0x44, 0x00}, {0x00, 0x41, 0x7F, 0x40, 0x00}, {0x7C, 0x04, 0x18, 0x04, 0x78},
+    {0x7C, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38}, {0x7C, 0x14, 0x14, 0x14, 0x08},
+    {0x08, 0x14, 0x14, 0x18, 0x7C}, {0x7C, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x20},
+    {0x04, 0x3F, 0x44, 0x40, 0x20}, {0x3C, 0x40, 0x40, 0x20, 0x7C}, {0x1C, 0x20, 0x40, 0x20, 0x1C},
+    {0x3C, 0x40, 0x30, 0x40, 0x3C}, {0x44, 0x28, 0x10, 0x28, 0x44}, {0x0C, 0x50, 0x50, 0x50, 0x3C},
+    {0x44, 0x64, 0x54, 0x4C, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00}, {0x00, 0x00, 0x7F, 0x00, 0x00},
+    {0x00, 0x41, 0x36, 0x08, 0x00}, {0x08, 0x04, 0x08, 0x10, 0x08}};
+
+#define PLOT_GLYPH_ADVANCE 6 // 5 kolom + 1 spasi
+
+static inline void plotSetPixel(PlotCanvas *canvas, int x, int y, PlotColor color) {
+    if (x < 0 || y < 0 || x >= canvas->width || y >= canvas->height) {
+        return;
+    }
+    uint8_t *p = canvas->pixels + ((size_t)y * canvas->width + x) * 3;
+    p[0] = color.r;
+    p[1] = color.g;
+    p[2] = color.b;
+}
+
+static inline void plotSetPixelClipped(PlotCanvas *canvas, int x, int y, PlotColor color) {
+    if (x >= canvas->clip_left && x <= canvas->clip_right && y >= canvas->clip_top && y <= canvas->clip_bottom) {
+        plotSetPixel(canvas, x, y, color);
+    }
+}
+
+static void plotFillRect(PlotCanvas *canvas, int x0, int y0, int x1, int y1, PlotColor color) {
+    for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
+            plotSetPixel(canvas, x, y, color);
+        }
+    }
+}
+
+static int plotTextWidth(const char *text, int scale) {
+    int length = (int)strlen(text);
+    return length ? (length * PLOT_GLYPH_ADVANCE - 1) * scale : 0;
+}
+
+// Teks dengan pojok kiri atas di (x, y). vertical != 0 memutar teks 90° berlawanan jarum jam
+// (dibaca dari bawah ke atas, (x, y) menjadi pojok kiri bawah).
+static void plotDrawText(PlotCanvas *canvas, int x, int y, const char *text, int scale, int vertical,
+                         PlotColor color) {
+    for (int k = 0; text[k]; k++) {
+        unsigned char ch = (unsigned char)text[k];
+        const uint8_t *glyph = plot_font[(ch >= 32 && ch <= 126 ? ch : '?') - 32];
+        for (int col = 0; col < 5; col++) {
+            for (int row = 0; row < 7; row++) {
+                if (!(glyph[col] >> row & 1)) {
+                    continue;
+                }
+                int u = (k * PLOT_GLYPH_ADVANCE + col) * scale; // sepanjang arah teks
+                int v = row * scale;                            // tegak lurus arah teks
+                for (int dy = 0; dy < scale; dy++) {
+                    for (int dx = 0; dx < scale; dx++) {
+                        if (vertical) {
+                            plotSetPixel(canvas, x + v + dy, y - u - dx, color);
+                        } else {
+                            plotSetPixel(canvas, x + u + dx, y + v + dy, color);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Garis Bresenham dengan ketebalan `thickness` piksel, diklip ke area plot
+static void plotDrawLine(PlotCanvas *canvas, int x0, int y0, int x1, int y1, int thickness, PlotColor color) {
+    int dx = abs(x1 - x0), dy = -abs(y1 - y0);
+    int sx = x0 < x1 ? 1 : -1, sy = y0 < y1 ? 1 : -1;
+    int error = dx + dy;
+    int lo = -(thickness - 1) / 2, hi = thickness / 2;
+    for (;;) {
+        for (int oy = lo; oy <= hi; oy++) {
+            for (int ox = lo; ox <= hi; ox++) {
+                plotSetPixelClipped(canvas, x0 + ox, y0 + oy, color);
+            }
+        }
+        if (x0 == x1 && y0 == y1) {
+            break;
+        }
+        int e2 = 2 * error;
+        if (e2 >= dy) {
+            error += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx) {
+            error += dx;
+            y0 += sy;
+        }
+    }
+}
+
+static void plotDrawPoint(PlotCanvas *canvas, int cx, int cy, PlotColor color) {
+    int r = PLOT_POINT_RADIUS;
+    for (int dy = -r; dy <= r; dy++) {
+        for (int dx = -r; dx <= r; dx++) {
+            if (dx * dx + dy * dy <= r * r + 1) {
+                plotSetPixelClipped(canvas, cx + dx, cy + dy, color);
+            }
+        }
+    }
+}
+
+static void plotRasterize(PlotCanvas *canvas, const PlotLayout *layout, const PlotOptions *options,
+                          const double *x, const double *y, size_t stride, size_t n, const double *cx,
+                          const double *cy, size_t num_samples, const char *model_label, double r_squared) {
+    char label[64];
+    plotFillRect(canvas, 0, 0, canvas->width - 1, canvas->height - 1, plot_white);
+
+    // Grid dan label tick
+    for (double v = layout->x_min; v <= layout->x_max + layout->x_step * 0.5; v += layout->x_step) {
+        int px = plotPixel(plotMapX(layout, v));
+        plotFillRect(canvas, px, layout->top, px, layout->bottom, plot_grid);
+        plotFormatTick(v, layout->x_step, label);
+        plotDrawText(canvas, px - plotTextWidth(label, 1) / 2, layout->bottom + 8, label, 1, 0, plot_black);
+    }
+    for (double v = layout->y_min; v <= layout->y_max + layout->y_step * 0.5; v += layout->y_step) {
+        int py = plotPixel(plotMapY(layout, v));
+        plotFillRect(canvas, layout->left, py, layout->right, py, plot_grid);
+        plotFormatTick(v, layout->y_step, label);
+        plotDrawText(canvas, layout->left - 6 - plotTextWidth(label, 1), py - 3, label, 1, 0, plot_black);
+    }
+
+    // Data lalu kurva, keduanya diklip ke area plot
+    for (size_t i = 0; i < n; i++) {
+        double xv = x[i * stride], yv = y[i * stride];
+        if (isfinite(xv) && isfinite(yv)) {
+            plotDrawPoint(canvas, plotPixel(plotMapX(layout, xv)), plotPixel(plotMapY(layout, yv)), plot_point_color);
+        }
+    }
+    for (size_t i = 1; i < num_samples; i++) {
+        if (isfinite(cy[i - 1]) && isfinite(cy[i])) {
+            plotDrawLine(canvas, plotPixel(plotMapX(layout, cx[i - 1])), plotPixel(plotMapY(layout, cy[i - 1])),
+                         plotPixel(plotMapX(layout, cx[i])), plotPixel(plotMapY(layout, cy[i])), 2, plot_curve_color);
+        }
+    }
+
+    // Bingkai, judul, label sumbu, legenda dan R²
+    plotFillRect(canvas, layout->left, layout->top, layout->right, layout->top, plot_black);
+    plotFillRect(canvas, layout->left, layout->bottom, layout->right, layout->bottom, plot_black);
+    plotFillRect(canvas, layout->left, layout->top, layout->left, layout->bottom, plot_black);
+    plotFillRect(canvas, layout->right, layout->top, layout->right, layout->bottom, plot_black);
+    plotDrawText(canvas, (canvas->width - plotTextWidth(options->title, 2)) / 2, 14, options->title, 2, 0,
+                 plot_black);
+    plotDrawText(canvas, (layout->left + layout->right - plotTextWidth(options->x_label, 1)) / 2,
+                 canvas->height - 20, options->x_label, 1, 0, plot_black);
+    plotDrawText(canvas, 12, (layout->top + layout->bottom + plotTextWidth(options->y_label, 1)) / 2,
+                 options->y_label, 1, 1, plot_black);
+
+    int legend_x = layout->left + 10, legend_y = layout->top + 10;
+    if (model_label) {
+        plotFillRect(canvas, legend_x, legend_y + 3, legend_x + 20, legend_y + 4, plot_curve_color);
+        plotDrawText(canvas, legend_x + 26, legend_y, model_label, 1, 0, plot_black);
+        legend_y += 14;
+        snprintf(label, sizeof(label), "R^2 = %.4f", r_squared);
+        plotDrawText(canvas, legend_x + 26, legend_y, label, 1, 0, plot_black);
+    }
+}
+
+// PNG: filter per baris (None/Sub/Up, dipilih dengan heuristik jumlah absolut terkecil),
+// deflate dengan kode Huffman tetap dan run-length (jarak 1). Plot sebagian besar berupa
+// bidang warna rata, jadi hasil filter berupa deretan nol yang terkompresi sangat baik.
+
+typedef struct {
+    uint8_t *data;
+    size_t length;
+    size_t capacity;
+    uint32_t bits;
+    int bit_count;
+    int failed;
+} PlotBitWriter;
+
+static void plotBitWriterByte(PlotBitWriter *w, uint8_t byte) {
+    if (w->length == w->capacity) {
+        size_t new_capacity = w->capacity ? w->capacity * 2 : 1 << 16;
+        uint8_t *grown = (uint8_t *)realloc(w->data, new_capacity);
+        if (!grown) {
+            w->failed = 1;
+            return;
+        }
+        w->data = grown;
+        w->capacity = new_capacity;
+    }
+    w->data[w->length++] = byte;
+}
+
+// Tulis `count` bit dari value, bit terendah lebih dulu (urutan bit deflate)
+static void plotPutBits(PlotBitWriter *w, uint32_t value, int count) {
+    w->bits |= value << w->bit_count;
+    w->bit_count += count;
+    while (w->bit_count >= 8) {
+        plotBitWriterByte(w, (uint8_t)w->bits);
+        w->bits >>= 8;
+        w->bit_count -= 8;
+    }
+}
+
+// Kode Huffman ditulis dari bit tertinggi
+static void plotPutCode(PlotBitWriter *w, uint32_t code, int length) {
+    uint32_t reversed = 0;
+    for (int i = 0; i < length; i++) {
+        reversed |= ((code >> i) & 1) << (length - 1 - i);
+    }
+    plotPutBits(w, reversed, length);
+}
+
+static void plotPutSymbol(PlotBitWriter *w, int symbol) {
+    if (symbol < 144) {
+        plotPutCode(w, 0x30 + symbol, 8);
+    } else if (symbol < 256) {
+        plotPutCode(w, 0x190 + symbol - 144, 9);
+    } else if (symbol < 280) {
+        plotPutCode(w, symbol - 256, 7);
+    } else {
+        plotPutCode(w, 0xC0 + symbol - 280, 8);
+    }
+}
+
+// Panjang match deflate: kode 257..285 dengan basis dan bit tambahan
+static const uint16_t plot_length_base[29] = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                              31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const uint8_t plot_length_extra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                              2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+
+static void plotPutMatch(PlotBitWriter *w, int length) {
+    int code = 28;
+    while (plot_length_base[code] > length) {
+        code--;
+    }
+    plotPutSymbol(w, 257 + code);
+    plotPutBits(w, (uint32_t)(length - plot_length_base[code]), plot_length_extra[code]);
+    plotPutCode(w, 0, 5); // Kode jarak 0 = jarak 1
+}
+
+// Satu blok deflate Huffman tetap: literal, atau run byte yang sama dengan byte sebelumnya
+static void plotDeflateFixed(PlotBitWriter *w, const uint8_t *data, size_t length) {
+    plotPutBits(w, 1, 1); // BFINAL
+    plotPutBits(w, 1, 2); // BTYPE = 01
+    size_t i = 0;
+    while (i < length) {
+        size_t run = 0;
+        if (i > 0) {
+            while (run < 258 && i + run < length && data[i + run] == data[i - 1]) {
+                run++;
+            }
+        }
+        if (run >= 3) {
+            plotPutMatch(w, (int)run);
+            i += run;
+        } else {
+            plotPutSymbol(w, data[i]);
+            i++;
+        }
+    }
+    plotPutSymbol(w, 256);
+    if (w->bit_count > 0) {
+        plotPutBits(w, 0, 8 - w->bit_count);
+    }
+}
+
+// CRC-32 (polinom 0xEDB88320) dengan tabel 4-bit
+static uint32_t plotCRC32(uint32_t crc, const uint8_t *data, size_t length) {
+    static const uint32_t table[16] = {0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4,
+                                       0x4DB26158, 0x5005713C, 0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+                                       0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C};
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ table[crc & 15];
+        crc = (crc >> 4) ^ table[crc & 15];
+    }
+    return ~crc;
+}
+
+static uint32_t plotAdler32(const uint8_t *data, size_t length) {
+    uint32_t a = 1, b = 0;
+    while (length > 0) {
+        size_t block = length < 5552 ? length : 5552; // Batas sebelum modulo agar tidak overflow
+        for (size_t i = 0; i < block; i++) {
+            a += data[i];
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+        data += block;
+        length -= block;
+    }
+    return (b << 16) | a;
+}
+
+static void plotPutBE32(uint8_t *out, uint32_t value) {
+    out[0] = (uint8_t)(value >> 24);
+    out[1] = (uint8_t)(value >> 16);
+    out[2] = (uint8_t)(value >> 8);
+    out[3] = (uint8_t)value;
+}
+
+static int plotWriteChunk(FILE *file, const char *type, const uint8_t *data, size_t length) {
+    uint8_t header[8];
+    plotPutBE32(header, (uint32_t)length);
+    memcpy(header + 4, type, 4);
+    uint32_t crc = plotCRC32(plotCRC32(0, header + 4, 4), data, length);
+    uint8_t trailer[4];
+    plotPutBE32(trailer, crc);
+    return fwrite(header, 1, 8, file) == 8 && (length == 0 || fwrite(data, 1, length, file) == length) &&
+                   fwrite(trailer, 1, 4, file) == 4
+               ? 0
+               : -1;
+}
+
+// Tulis gambar RGB 8-bit sebagai PNG. Return CF_OK jika berhasil.
+CFStatus writePNG(const char *path, const uint8_t *rgb, int width, int height) {
+    size_t row_bytes = (size_t)width * 3;
+    uint8_t *filtered = (uint8_t *)malloc((row_bytes + 1) * (size_t)height);
+    if (!filtered) {
+        return CF_ERROR_MEMORY;
+    }
+
+    for (int y = 0; y < height; y++) {
+        const uint8_t *row = rgb + (size_t)y * row_bytes;
+        const uint8_t *prev = y > 0 ? row - row_bytes : NULL;
+        uint8_t *out = filtered + (size_t)y * (row_bytes + 1);
+        // Pilih filter dengan jumlah |nilai sebagai int8| terkecil
+        long cost[3] = {0, 0, 0};
+        for (size_t i = 0; i < row_bytes; i++) {
+            uint8_t sub = (uint8_t)(row[i] - (i >= 3 ? row[i - 3] : 0));
+            uint8_t up = (uint8_t)(row[i] - (prev ? prev[i] : 0));
+            cost[0] += row[i] < 128 ? row[i] : 256 - row[i];
+            cost[1] += sub < 128 ? sub : 256 - sub;
+            cost[2] += up < 128 ? up : 256 - up;
+        }
+        int filter = cost[1] < cost[0] ? 1 : 0;
+        filter = cost[2] < cost[filter] ? 2 : filter;
+        out[0] = (uint8_t)filter;
+        for (size_t i = 0; i < row_bytes; i++) {
+            uint8_t base = filter == 1 ? (i >= 3 ? row[i - 3] : 0) : filter == 2 ? (prev ? prev[i] : 0) : 0;
+            out[i + 1] = (uint8_t)(row[i] - base);
+        }
+    }
+
+    size_t raw_length = (row_bytes + 1) * (size_t)height;
+    PlotBitWriter w = {NULL, 0, 0, 0, 0, 0};
+    plotBitWriterByte(&w, 0x78); // zlib: deflate, jendela 32 KB
+    plotBitWriterByte(&w, 0x01);
+    plotDeflateFixed(&w, filtered, raw_length);
+    uint32_t adler = plotAdler32(filtered, raw_length);
+    free(filtered);
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        plotBitWriterByte(&w, (uint8_t)(adler >> shift));
+    }
+    if (w.failed) {
+        free(w.data);
+        return CF_ERROR_MEMORY;
+    }
+
+    FILE *file = fopen(path, "wb");
+    if (!file) {
+        free(w.data);
+        return CF_ERROR_IO;
+    }
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    uint8_t ihdr[13];
+    plotPutBE32(ihdr, (uint32_t)width);
+    plotPutBE32(ihdr + 4, (uint32_t)height);
+    ihdr[8] = 8;  // Bit per kanal
+    ihdr[9] = 2;  // RGB
+    ihdr[10] = 0; // Deflate
+    ihdr[11] = 0; // Filter adaptif standar
+    ihdr[12] = 0; // Tanpa interlace
+    int ok = fwrite(signature, 1, 8, file) == 8 && plotWriteChunk(file, "IHDR", ihdr, 13) == 0 &&
+             plotWriteChunk(file, "IDAT", w.data, w.length) == 0 && plotWriteChunk(file, "IEND", NULL, 0) == 0;
+    free(w.data);
+    ok = fclose(file) == 0 && ok;
+    return ok ? CF_OK : CF_ERROR_IO;
+}
+
+// SVG
+
+static void plotSVGText(FILE *out, double x, double y, const char *anchor, const char *attributes, const char *text) {
+    fprintf(out, "<text x=\"%.1f\" y=\"%.1f\" text-anchor=\"%s\"%s>", x, y, anchor, attributes);
+    for (const char *p = text; *p; p++) {
+        if (*p == '<') {
+            fputs("&lt;", out);
+        } else if (*p == '>') {
+            fputs("&gt;", out);
+        } else if (*p == '&') {
+            fputs("&amp;", out);
+        } else {
+            fputc(*p, out);
+        }
+    }
+    fputs("</text>\n", out);
+}
+
+static int plotWriteSVG(const char *path, const PlotLayout *layout, const PlotOptions *options, const double *x,
+                        const double *y, size_t stride, size_t n, const double *cx, const double *cy,
+                        size_t num_samples, const char *model_label, double r_squared) {
+    FILE *out = fopen(path, "w");
+    if (!out) {
+        return -1;
+    }
+    char label[64];
+    int plot_w = layout->right - layout->left, plot_h = layout->bottom - layout->top;
+    fprintf(out,
+            "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%d\" height=\"%d\" viewBox=\"0 0 %d %d\" "
+            "font-family=\"sans-serif\" font-size=\"12\">\n"
+            "<rect width=\"100%%\" height=\"100%%\" fill=\"#ffffff\"/>\n"
+            "<clipPath id=\"area\"><rect x=\"%d\" y=\"%d\" width=\"%d\" height=\"%d\"/></clipPath>\n",
+            layout->width, layout->height, layout->width, layout->height, layout->left, layout->top, plot_w, plot_h);
+
+    fputs("<g stroke=\"#e1e1e1\">\n", out);
+    for (double v = layout->x_min; v <= layout->x_max + layout->x_step * 0.5; v += layout->x_step) {
+        double px = plotMapX(layout, v);
+        fprintf(out, "<line x1=\"%.1f\" y1=\"%d\" x2=\"%.1f\" y2=\"%d\"/>\n", px, layout->top, px, layout->bottom);
+    }
+    for (double v = layout->y_min; v <= layout->y_max + layout->y_step * 0.5; v += layout->y_step) {
+        double py = plotMapY(layout, v);
+        fprintf(out, "<line x1=\"%d\" y1=\"%.1f\" x2=\"%d\" y2=\"%.1f\"/>\n", layout->left, py, layout->right, py);
+    }
+    fputs("</g>\n", out);
+    for (double v = layout->x_min; v <= layout->x_max + layout->x_step * 0.5; v += layout->x_step) {
+        plotFormatTick(v, layout->x_step, label);
+        plotSVGText(out, plotMapX(layout, v), layout->bottom + 18, "middle", "", label);
+    }
+    for (double v = layout->y_min; v <= layout->y_max + layout->y_step * 0.5; v += layout->y_step) {
+        plotFormatTick(v, layout->y_step, label);
+        plotSVGText(out, layout->left - 6, plotMapY(layout, v) + 4, "end", "", label);
+    }
+
+    // Titik data: satu path dengan busur per titik lebih ringkas daripada elemen <circle>
+    fputs("<g clip-path=\"url(#area)\">\n<path fill=\"#1f77b4\" d=\"", out);
+    char buffer[2 * PREDICT_MAX_FIELD + 1];
+    for (size_t i = 0; i < n; i++) {
+        double xv = x[i * stride], yv = y[i * stride];
+        if (!isfinite(xv) || !isfinite(yv)) {
+            continue;
+        }
+        int length = formatDouble(plotMapX(layout, xv) - PLOT_POINT_RADIUS, 6, buffer);
+        buffer[length++] = ',';
+        length += formatDouble(plotMapY(layout, yv), 6, buffer + length);
+        static const char arc[] = "a3,3 0 1,0 6,0a3,3 0 1,0 -6,0";
+        fputc('M', out);
+        fwrite(buffer, 1, (size_t)length, out);
+        fwrite(arc, 1, sizeof(arc) - 1, out);
+    }
+    fputs("\"/>\n<polyline fill=\"none\" stroke=\"#d62728\" stroke-width=\"2\" points=\"", out);
+    for (size_t i = 0; i < num_samples; i++) {
+        if (isfinite(cy[i])) {
+            int length = formatDouble(plotMapX(layout, cx[i]), 6, buffer);
+            buffer[length++] = ',';
+            length += formatDouble(plotMapY(layout, cy[i]), 6, buffer + length);
+            buffer[length++] = ' ';
+            fwrite(buffer, 1, (size_t)length, out);
+        }
+    }
+    fputs("\"/>\n</g>\n", out);
+
+    fprintf(out, "<rect x=\"%d\" y=\"%d\" width=\"%d\" height=\"%d\" fill=\"none\" stroke=\"#000000\"/>\n",
+            layout->left, layout->top, plot_w, plot_h);
+    plotSVGText(out, layout->width / 2.0, 26, "middle", " font-size=\"16\"", options->title);
+    plotSVGText(out, (layout->left + layout->right) / 2.0, layout->height - 14, "middle", "", options->x_label);
+    fprintf(out, "<g transform=\"translate(18,%.1f) rotate(-90)\">\n", (layout->top + layout->bottom) / 2.0);
+    plotSVGText(out, 0, 0, "middle", "", options->y_label);
+    fputs("</g>\n", out);
+    if (model_label) {
+        int legend_x = layout->left + 10, legend_y = layout->top + 10;
+        fprintf(out, "<line x1=\"%d\" y1=\"%d\" x2=\"%d\" y2=\"%d\" stroke=\"#d62728\" stroke-width=\"2\"/>\n",
+                legend_x, legend_y + 4, legend_x + 20, legend_y + 4);
+        plotSVGText(out, legend_x + 26, legend_y + 8, "start", "", model_label);
+        snprintf(label, sizeof(label), "R\xC2\xB2 = %.4f", r_squared);
+        plotSVGText(out, legend_x + 26, legend_y + 24, "start", "", label);
+    }
+    fputs("</svg>\n", out);
+    return fclose(out) == 0 ? 0 : -1;
+}
+
+// API
+
+// Render scatter (x, y) dan kurva result (boleh NULL untuk scatter saja) ke path; format dari
+// ekstensi (.svg atau PNG). stride 1 untuk kolom, 2 untuk DataPoint. Titik NaN dilewati.
+// Aman dipanggil dari banyak thread sekaligus. Return CF_OK jika berhasil.
+CFStatus renderPlot(const char *path, const double *x, const double *y, size_t stride, size_t n,
+                    const RegressionResult *result, const PlotOptions *options) {
+    PlotOptions defaults;
+    if (!options) {
+        defaultPlotOptions(&defaults);
+        options = &defaults;
+    }
+    if (options->width < PLOT_MARGIN_LEFT + PLOT_MARGIN_RIGHT + 16 ||
+        options->height < PLOT_MARGIN_TOP + PLOT_MARGIN_BOTTOM + 16) {
+        return CF_ERROR_ARGUMENT;
+    }
+    double span = metricsSpanBegin();
+
+    CompiledModel model;
+    int has_model = result && compileModel(result, &model) == 0;
+    double *curve = (double *)malloc(2 * PLOT_MAX_CURVE_SAMPLES * sizeof(double));
+    if (!curve) {
+        return CF_ERROR_MEMORY;
+    }
+    double *cx = curve, *cy = curve + PLOT_MAX_CURVE_SAMPLES;
+    PlotLayout layout;
+    size_t num_samples;
+    if (plotComputeLayout(&layout, options, x, y, stride, n, has_model ? &model : NULL, cx, cy, &num_samples) != 0) {
+        free(curve);
+        return CF_ERROR_NO_DATA;
+    }
+
+    // Data besar diringkas dulu: per piksel untuk PNG (hasil sama), per titik gambar untuk SVG
+    PlotFormat format = plotFormatFromPath(path);
+    double *lod = NULL;
+    size_t lod_count;
+    if (n >= PLOT_LOD_MIN_POINTS &&
+        plotDownsample(&layout, format == PLOT_FORMAT_SVG ? PLOT_POINT_RADIUS : 1, x, y, stride, n,
+                       threadPoolShared(), &lod, &lod_count) == 0) {
+        x = lod;
+        y = lod + 1;
+        stride = 2;
+        n = lod_count;
+    }
+
+    char model_label[160];
+    if (has_model) {
+        plotModelLabel(result, model_label, sizeof(model_label));
+    }
+    double r_squared = has_model ? result->r_squared : NAN;
+    CFStatus status;
+    if (format == PLOT_FORMAT_SVG) {
+        status = plotWriteSVG(path, &layout, options, x, y, stride, n, cx, cy, num_samples,
+                              has_model ? model_label : NULL, r_squared) == 0
+                     ? CF_OK
+                     : CF_ERROR_IO;
+    } else {
+        PlotCanvas canvas = {options->width, options->height, NULL,
+                             layout.left,    layout.top,      layout.right, layout.bottom};
+        canvas.pixels = (uint8_t *)malloc((size_t)options->width * options->height * 3);
+        if (!canvas.pixels) {
+            free(lod);
+            free(curve);
+            return CF_ERROR_MEMORY;
+        }
+        plotRasterize(&canvas, &layout, options, x, y, stride, n, cx, cy, num_samples,
+                      has_model ? model_label : NULL, r_squared);
+        status = writePNG(path, canvas.pixels, canvas.width, canvas.height);
+        free(canvas.pixels);
+    }
+    free(lod);
+    free(curve);
+    metricsSpanEnd(METRIC_SPAN_PLOT_RENDER, span);
+    metricsAdd(METRIC_PLOTS, status == CF_OK);
+    return status;
+}
+
+typedef struct {
+    const Dataset *ds;
+    const BatchFitEntry *entries;
+    const char *directory;
+    CFStatus status; // Status plot terakhir yang gagal
+} PlotBatchJob;
+
+// Nama file aman: karakter selain huruf, angka, '-' dan '.' diganti '_'
+static void plotSafeName(char *dest, size_t size, const char *name) {
+    size_t i = 0;
+    for (; name[i] && i + 1 < size; i++) {
+        char c = name[i];
+        int ok = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '.';
+        dest[i] = ok ? c : '_';
+    }
+    dest[i] = '\0';
+}
+
+// Path output (directory/x_y_model.png), judul dan label untuk satu hasil batch. title minimal 160 byte.
+void plotBatchEntryOptions(const Dataset *ds, const BatchFitEntry *entry, const char *directory, char *path,
+                           size_t path_size, char *title, PlotOptions *options) {
+    char x_name[MAX_COLUMN_NAME], y_name[MAX_COLUMN_NAME];
+    plotSafeName(x_name, sizeof(x_name), ds->columns[entry->x_column].name);
+    plotSafeName(y_name, sizeof(y_name), ds->columns[entry->y_column].name);
+    if (entry->type == REGRESSION_POLYNOMIAL) {
+        snprintf(path, path_size, "%s/%s_%s_polynomial%d.png", directory, x_name, y_name, entry->degree);
+    } else {
+        snprintf(path, path_size, "%s/%s_%s_%s.png", directory, x_name, y_name, regressionTypeName(entry->type));
+    }
+    snprintf(title, 160, "%s terhadap %s", ds->columns[entry->y_column].name, ds->columns[entry->x_column].name);
+
+    defaultPlotOptions(options);
+    options->title = title;
+    options->x_label = ds->columns[entry->x_column].name;
+    options->y_label = ds->columns[entry->y_column].name;
+}
+
+static void plotBatchWork(void *arg, size_t index) {
+    PlotBatchJob *job = (PlotBatchJob *)arg;
+    const BatchFitEntry *entry = &job->entries[index];
+    const Dataset *ds = job->ds;
+    char path[1024], title[160];
+    PlotOptions options;
+    plotBatchEntryOptions(ds, entry, job->directory, path, sizeof(path), title, &options);
+    const RegressionResult *result = isnan(entry->result.r_squared) ? NULL : &entry->result;
+    CFStatus status = renderPlot(path, ds->values[entry->x_column], ds->values[entry->y_column], 1, ds->num_rows,
+                                 result, &options);
+    if (status != CF_OK) {
+        __atomic_store_n(&job->status, status, __ATOMIC_RELAXED);
+    }
+}
+
+// Satu PNG per hasil batch di directory (sudah ada), dirender paralel.
+// Return CF_OK jika semua berhasil, atau status salah satu plot yang gagal.
+CFStatus plotBatchFit(const Dataset *ds, const BatchFitEntry *entries, int num_entries, const char *directory,
+                      int num_threads) {
+    if (num_threads <= 0) {
+        num_threads = defaultThreadCount();
+    }
+    ThreadPool *pool = num_threads > 1 ? threadPoolCreate(num_threads) : NULL;
+    PlotBatchJob job = {ds, entries, directory, CF_OK};
+    threadPoolParallelFor(pool, (size_t)num_entries, plotBatchWork, &job);
+    threadPoolDestroy(pool);
+    return job.status;
+}
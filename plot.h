@@ -0,0 +1,68 @@
+#ifndef PLOT_H
+#define PLOT_H
+
+#include <stdint.h>
+
+#include "batch_fit.h"
+#include "predict.h"
+
+// Renderer plot bawaan: scatter data + kurva regresi + sumbu, grid, label dan anotasi R²,
+// ditulis langsung dari memori ke PNG atau SVG tanpa proses gnuplot dan tanpa file sementara.
+
+#define PLOT_DEFAULT_WIDTH 800
+#define PLOT_DEFAULT_HEIGHT 600
+#define PLOT_MARGIN_LEFT 80
+#define PLOT_MARGIN_RIGHT 24
+#define PLOT_MARGIN_TOP 44
+#define PLOT_MARGIN_BOTTOM 56
+#define PLOT_TARGET_TICKS 6
+#define PLOT_POINT_RADIUS 3
+#define PLOT_MAX_CURVE_SAMPLES 4096
+// Kurva: minimal 2^5 segmen, dibelah selama titik tengah menyimpang > 0.25 piksel dari tali busur
+#define PLOT_CURVE_MIN_DEPTH 5
+#define PLOT_CURVE_TOLERANCE 0.25
+// Di atas jumlah titik ini scatter diringkas per sel piksel sebelum digambar
+#define PLOT_LOD_MIN_POINTS 65536
+#define PLOT_LOD_MIN_PART (1 << 20) // Minimal titik per thread
+
+typedef enum {
+    PLOT_FORMAT_PNG,
+    PLOT_FORMAT_SVG
+} PlotFormat;
+
+typedef struct {
+    int width;
+    int height;
+    const char *title;
+    const char *x_label;
+    const char *y_label;
+} PlotOptions;
+
+// Skala dan posisi area plot dalam piksel, dipakai bersama oleh PNG dan SVG
+typedef struct {
+    int width;
+    int height;
+    int left, right, top, bottom; // Batas area plot (piksel)
+    double x_min, x_max, x_step;  // Rentang sumbu (dibulatkan ke kelipatan tick)
+    double y_min, y_max, y_step;
+    double data_x_min, data_x_max; // Rentang x data, untuk sampel kurva
+} PlotLayout;
+
+// Deklarasi fungsi
+void defaultPlotOptions(PlotOptions *options);
+PlotFormat plotFormatFromPath(const char *path);
+CFStatus renderPlot(const char *path, const double *x, const double *y, size_t stride, size_t n,
+                    const RegressionResult *result, const PlotOptions *options);
+int plotDownsample(const PlotLayout *layout, int cell, const double *x, const double *y, size_t stride, size_t n,
+                   ThreadPool *pool, double **points, size_t *count);
+CFStatus writePNG(const char *path, const uint8_t *rgb, int width, int height);
+CFStatus plotBatchFit(const Dataset *ds, const BatchFitEntry *entries, int num_entries, const char *directory,
+                      int num_threads);
+int plotComputeLayout(PlotLayout *layout, const PlotOptions *options, const double *x, const double *y,
+                      size_t stride, size_t n, const CompiledModel *model, double *cx, double *cy,
+                      size_t *num_samples);
+void plotModelLabel(const RegressionResult *result, char *out, size_t size);
+void plotBatchEntryOptions(const Dataset *ds, const BatchFitEntry *entry, const char *directory, char *path,
+                           size_t path_size, char *title, PlotOptions *options);
+
+#endif
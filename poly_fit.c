@@ -0,0 +1,297 @@
+#include "poly_fit.h"
+
+void polyAccumulatorInit(PolyAccumulator *acc, int degree, double shift, double scale, double y_shift) {
+    memset(acc, 0, sizeof(*acc));
+    acc->degree = degree;
+    acc->shift = shift;
+    acc->scale = scale > 0 ? scale : 1.0;
+    acc->y_shift = y_shift;
+}
+
+// Tambahkan n titik. Pangkat t dihitung dengan perkalian bertahap (tanpa pow).
+// Jumlah dikumpulkan per blok lalu ditambahkan ke total, supaya error pembulatan
+// tumbuh per blok dan bukan per titik.
+void polyAccumulatorAdd(PolyAccumulator *acc, const double *x, const double *y, size_t stride, size_t n) {
+    int max_power = 2 * acc->degree;
+    int degree = acc->degree;
+    double inv_scale = 1.0 / acc->scale;
+
+    for (size_t start = 0; start < n; start += 256) {
+        size_t end = start + 256 < n ? start + 256 : n;
+        double ps[2 * MAX_POLY_DEGREE + 1] = {0};
+        double cs[MAX_POLY_DEGREE + 1] = {0};
+        double syy = 0;
+
+        for (size_t i = start; i < end; i++) {
+            double t = (x[i * stride] - acc->shift) * inv_scale;
+            double dy = y[i * stride] - acc->y_shift;
+            double power = 1.0;
+            for (int k = 0; k <= degree; k++) {
+                ps[k] += power;
+                cs[k] += dy * power;
+                power *= t;
+            }
+            for (int k = degree + 1; k <= max_power; k++) {
+                ps[k] += power;
+                power *= t;
+            }
+            syy += dy * dy;
+        }
+
+        for (int k = 0; k <= max_power; k++) {
+            acc->power_sums[k] += ps[k];
+        }
+        for (int k = 0; k <= degree; k++) {
+            acc->cross_sums[k] += cs[k];
+        }
+        acc->sum_yy += syy;
+    }
+    acc->n += (double)n;
+}
+
+// Gabungkan statistik dari potongan data lain (misalnya dari thread atau chunk lain).
+// Kedua akumulator harus memakai derajat, shift dan scale yang sama. Return -1 jika tidak.
+int polyAccumulatorMerge(PolyAccumulator *dst, const PolyAccumulator *src) {
+    if (dst->degree != src->degree || dst->shift != src->shift || dst->scale != src->scale ||
+        dst->y_shift != src->y_shift) {
+        return -1;
+    }
+    for (int k = 0; k <= 2 * dst->degree; k++) {
+        dst->power_sums[k] += src->power_sums[k];
+    }
+    for (int k = 0; k <= dst->degree; k++) {
+        dst->cross_sums[k] += src->cross_sums[k];
+    }
+    dst->sum_yy += src->sum_yy;
+    dst->n += src->n;
+    return 0;
+}
+
+// Keluarkan n titik yang sebelumnya sudah ditambahkan (untuk jendela geser). Jumlah
+// titik yang dikeluarkan dihitung per blok dulu seperti polyAccumulatorAdd, lalu dikurangkan.
+void polyAccumulatorRemove(PolyAccumulator *acc, const double *x, const double *y, size_t stride, size_t n) {
+    PolyAccumulator removed;
+    polyAccumulatorInit(&removed, acc->degree, acc->shift, acc->scale, acc->y_shift);
+    polyAccumulatorAdd(&removed, x, y, stride, n);
+    for (int k = 0; k <= 2 * acc->degree; k++) {
+        acc->power_sums[k] -= removed.power_sums[k];
+    }
+    for (int k = 0; k <= acc->degree; k++) {
+        acc->cross_sums[k] -= removed.cross_sums[k];
+    }
+    acc->sum_yy -= removed.sum_yy;
+    acc->n -= removed.n;
+}
+
+// Pindahkan statistik ke basis lain tanpa data: t' = (x - shift')/scale' = αt + β dan
+// y - y_shift' = dy + γ, sehingga Σt'^k = Σ_j C(k,j) α^j β^(k-j) Σt^j (cross sums sama dengan
+// Σdy·t^j + γΣt^j). Eksak secara aljabar; presisi baik selama rentang t lama dan baru sebanding,
+// misalnya saat akumulator per chunk dengan basis lokal digabung ke basis rentang seluruh data.
+void polyAccumulatorRebase(PolyAccumulator *acc, double shift, double scale, double y_shift) {
+    scale = scale > 0 ? scale : 1.0;
+    int degree = acc->degree;
+    int max_power = 2 * degree;
+    double alpha = acc->scale / scale;
+    double beta = (acc->shift - shift) / scale;
+    double gamma = acc->y_shift - y_shift;
+    double alpha_power[2 * MAX_POLY_DEGREE + 1], beta_power[2 * MAX_POLY_DEGREE + 1];
+    double binom[2 * MAX_POLY_DEGREE + 1];
+    double power_sums[2 * MAX_POLY_DEGREE + 1], cross_sums[MAX_POLY_DEGREE + 1];
+    alpha_power[0] = beta_power[0] = 1.0;
+    for (int k = 1; k <= max_power; k++) {
+        alpha_power[k] = alpha_power[k - 1] * alpha;
+        beta_power[k] = beta_power[k - 1] * beta;
+    }
+
+    // Baris segitiga Pascal ke-k diperbarui di tempat, dari kanan ke kiri
+    for (int k = 0; k <= max_power; k++) {
+        binom[k] = 1.0;
+        for (int j = k - 1; j > 0; j--) {
+            binom[j] += binom[j - 1];
+        }
+        double sum_p = 0, sum_c = 0;
+        for (int j = 0; j <= k; j++) {
+            double coefficient = binom[j] * alpha_power[j] * beta_power[k - j];
+            sum_p += coefficient * acc->power_sums[j];
+            if (k <= degree) {
+                sum_c += coefficient * (acc->cross_sums[j] + gamma * acc->power_sums[j]);
+            }
+        }
+        power_sums[k] = sum_p;
+        if (k <= degree) {
+            cross_sums[k] = sum_c;
+        }
+    }
+
+    acc->sum_yy += 2 * gamma * acc->cross_sums[0] + gamma * gamma * acc->n;
+    memcpy(acc->power_sums, power_sums, (max_power + 1) * sizeof(double));
+    memcpy(acc->cross_sums, cross_sums, (degree + 1) * sizeof(double));
+    acc->shift = shift;
+    acc->scale = scale;
+    acc->y_shift = y_shift;
+}
+
+// Ubah koefisien pada basis t = (x - shift)/scale menjadi basis x^k biasa:
+// Σ c_k t^k = Σ_j raw_j x^j, dengan raw_j = Σ_{k>=j} c_k scale^-k C(k,j) (-shift)^(k-j)
+void polyToRawBasis(const double *scaled, int degree, double shift, double scale, double y_shift, double *raw) {
+    double inv_scale = 1.0 / scale;
+    for (int j = 0; j <= degree; j++) {
+        raw[j] = 0.0;
+    }
+    double scale_power = 1.0;
+    for (int k = 0; k <= degree; k++) {
+        // Koefisien binomial C(k, j) dan pangkat (-shift)^(k-j), dari j = k turun ke 0
+        double binom = 1.0;
+        double shift_power = 1.0;
+        for (int j = k; j >= 0; j--) {
+            raw[j] += scaled[k] * scale_power * binom * shift_power;
+            binom = binom * j / (k - j + 1);
+            shift_power *= -shift;
+        }
+        scale_power *= inv_scale;
+    }
+    raw[0] += y_shift;
+}
+
+// Selesaikan fit derajat `degree` (<= acc->degree) dengan Cholesky pada matriks Hankel yang
+// disimpan kontigu. Koefisien tetap pada basis t dan relatif terhadap y_shift, sehingga bisa
+// dinilai terhadap akumulator lain yang memakai shift/scale sama (validasi silang).
+// Return -1 jika matriks tidak positif definit.
+int polyAccumulatorSolveScaled(const PolyAccumulator *acc, int degree, double *solution) {
+    int n = degree + 1;
+    double matrix[(MAX_POLY_DEGREE + 1) * (MAX_POLY_DEGREE + 1)];
+    if (degree > acc->degree || acc->n < n) {
+        return -1;
+    }
+
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            matrix[i * n + j] = acc->power_sums[i + j];
+        }
+        solution[i] = acc->cross_sums[i];
+    }
+    return choleskySolveEquilibrated(matrix, n, solution) == 0 ? 0 : -1;
+}
+
+// Selesaikan fit derajat `degree` (<= acc->degree) dari statistik cukup. Koefisien dikembalikan
+// pada basis x biasa. R-squared dihitung tanpa lintasan data kedua: SS_res = Σy² - cᵀ(Σy·t^k).
+// Return -1 jika matriks tidak positif definit.
+int polyAccumulatorSolve(const PolyAccumulator *acc, int degree, double *coefficients, double *r_squared) {
+    int n = degree + 1;
+    double solution[MAX_POLY_DEGREE + 1];
+    if (polyAccumulatorSolveScaled(acc, degree, solution) != 0) {
+        return -1;
+    }
+
+    if (r_squared) {
+        double explained = 0.0;
+        for (int i = 0; i < n; i++) {
+            explained += solution[i] * acc->cross_sums[i];
+        }
+        double mean_dy = acc->cross_sums[0] / acc->n;
+        double ss_tot = acc->sum_yy - acc->cross_sums[0] * mean_dy;
+        double ss_res = acc->sum_yy - explained;
+        if (ss_res < 0) {
+            ss_res = 0;
+        }
+        *r_squared = 1 - (ss_res / ss_tot);
+    }
+
+    polyToRawBasis(solution, degree, acc->shift, acc->scale, acc->y_shift, coefficients);
+    return 0;
+}
+
+// Pusat dan setengah rentang x, sehingga t berada di [-1, 1]
+void polyRangeScale(const double *x, size_t stride, size_t n, double *shift, double *scale) {
+    double min_x = n ? x[0] : 0, max_x = n ? x[0] : 0;
+    for (size_t i = 1; i < n; i++) {
+        double v = x[i * stride];
+        min_x = v < min_x ? v : min_x;
+        max_x = v > max_x ? v : max_x;
+    }
+    *shift = 0.5 * (min_x + max_x);
+    *scale = 0.5 * (max_x - min_x);
+    if (!(*scale > 0)) {
+        *scale = 1.0;
+    }
+}
+
+// Least squares polynomial dengan Householder QR streaming (TSQR): R dari blok
+// sebelumnya ditumpuk di atas POLY_QR_BLOCK baris desain [1 t ... t^d | y], lalu
+// ditriangularisasi ulang. Satu lintasan data tanpa membentuk persamaan normal,
+// sehingga tetap stabil walaupun matriks momen hampir singular.
+int polyFitQR(const double *x, const double *y, size_t stride, size_t n, int degree, double shift, double scale,
+              double *coefficients, double *r_squared) {
+    int cols = degree + 2; // Kolom terakhir adalah y
+    int rows_max = cols + POLY_QR_BLOCK;
+    double work[(MAX_POLY_DEGREE + 2) * (MAX_POLY_DEGREE + 2 + POLY_QR_BLOCK)];
+    double inv_scale = 1.0 / scale;
+    double y_shift = n ? y[0] : 0;
+    double sum_dy = 0, sum_dy2 = 0;
+    if ((size_t)(degree + 1) > n) {
+        return -1;
+    }
+
+    memset(work, 0, sizeof(double) * cols * rows_max);
+    int rows = cols;
+    for (size_t i = 0; i < n; i++) {
+        double t = (x[i * stride] - shift) * inv_scale;
+        double dy = y[i * stride] - y_shift;
+        double *row = work + rows * cols;
+        double power = 1.0;
+        for (int k = 0; k <= degree; k++) {
+            row[k] = power;
+            power *= t;
+        }
+        row[degree + 1] = dy;
+        sum_dy += dy;
+        sum_dy2 += dy * dy;
+        if (++rows == rows_max) {
+            householderTriangularize(work, rows, cols);
+            rows = cols;
+        }
+    }
+    householderTriangularize(work, rows, cols);
+
+    double solution[MAX_POLY_DEGREE + 1];
+    for (int k = 0; k <= degree; k++) {
+        solution[k] = work[k * cols + degree + 1];
+    }
+    if (upperTriangularSolve(work, degree + 1, cols, solution) != 0) {
+        return -1;
+    }
+
+    if (r_squared) {
+        // Sisa residual tersimpan di elemen diagonal terakhir R
+        double residual = work[(degree + 1) * cols + degree + 1];
+        double ss_tot = sum_dy2 - sum_dy * sum_dy / (double)n;
+        *r_squared = 1 - (residual * residual / ss_tot);
+    }
+
+    polyToRawBasis(solution, degree, shift, scale, y_shift, coefficients);
+    return 0;
+}
+
+// Fit polynomial derajat `degree` untuk n titik (x, y) dengan stride (1 untuk kolom,
+// 2 untuk array DataPoint). x diskalakan ke [-1, 1] terlebih dahulu.
+int polyFit(const double *x, const double *y, size_t stride, size_t n, int degree, PolySolver solver,
+            double *coefficients, double *r_squared) {
+    double shift, scale;
+    if (degree < 0 || degree > MAX_POLY_DEGREE || n == 0) {
+        return -1;
+    }
+    polyRangeScale(x, stride, n, &shift, &scale);
+
+    if (solver != POLY_SOLVER_QR) {
+        PolyAccumulator acc;
+        polyAccumulatorInit(&acc, degree, shift, scale, y[0]);
+        polyAccumulatorAdd(&acc, x, y, stride, n);
+        if (polyAccumulatorSolve(&acc, degree, coefficients, r_squared) == 0) {
+            return 0;
+        }
+        if (solver == POLY_SOLVER_CHOLESKY) {
+            return -1;
+        }
+    }
+    return polyFitQR(x, y, stride, n, degree, shift, scale, coefficients, r_squared);
+}
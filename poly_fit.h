@@ -0,0 +1,50 @@
+#ifndef POLY_FIT_H
+#define POLY_FIT_H
+
+#include <string.h>
+
+#include "linalg.h"
+
+#ifndef MAX_POLY_DEGREE
+#define MAX_POLY_DEGREE 10
+#endif
+
+// Jumlah baris per blok pada solver QR streaming
+#define POLY_QR_BLOCK 64
+
+// Statistik cukup untuk fit polynomial hingga `degree`, pada basis x yang sudah
+// digeser dan diskalakan: t = (x - shift) / scale. Semua fit polynomial hanya butuh
+// 2*degree+1 jumlah pangkat Σt^k dan degree+1 jumlah silang Σy·t^k.
+typedef struct {
+    int degree;
+    double shift;
+    double scale;
+    double y_shift;                            // y disimpan relatif terhadap y_shift
+    double n;
+    double power_sums[2 * MAX_POLY_DEGREE + 1]; // Σ t^k
+    double cross_sums[MAX_POLY_DEGREE + 1];     // Σ (y - y_shift) t^k
+    double sum_yy;                              // Σ (y - y_shift)²
+} PolyAccumulator;
+
+typedef enum {
+    POLY_SOLVER_AUTO,     // Cholesky, otomatis pindah ke QR jika matriks tidak stabil
+    POLY_SOLVER_CHOLESKY, // Cholesky pada matriks momen (satu lintasan, O(N·degree))
+    POLY_SOLVER_QR        // Householder QR streaming pada matriks desain (O(N·degree²))
+} PolySolver;
+
+// Deklarasi fungsi
+void polyAccumulatorInit(PolyAccumulator *acc, int degree, double shift, double scale, double y_shift);
+void polyAccumulatorAdd(PolyAccumulator *acc, const double *x, const double *y, size_t stride, size_t n);
+int polyAccumulatorMerge(PolyAccumulator *dst, const PolyAccumulator *src);
+void polyAccumulatorRemove(PolyAccumulator *acc, const double *x, const double *y, size_t stride, size_t n);
+void polyAccumulatorRebase(PolyAccumulator *acc, double shift, double scale, double y_shift);
+int polyAccumulatorSolve(const PolyAccumulator *acc, int degree, double *coefficients, double *r_squared);
+int polyAccumulatorSolveScaled(const PolyAccumulator *acc, int degree, double *solution);
+void polyRangeScale(const double *x, size_t stride, size_t n, double *shift, double *scale);
+void polyToRawBasis(const double *scaled, int degree, double shift, double scale, double y_shift, double *raw);
+int polyFitQR(const double *x, const double *y, size_t stride, size_t n, int degree, double shift, double scale,
+              double *coefficients, double *r_squared);
+int polyFit(const double *x, const double *y, size_t stride, size_t n, int degree, PolySolver solver,
+            double *coefficients, double *r_squared);
+
+#endif
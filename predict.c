@@ -0,0 +1,273 @@
+#include "predict.h"
+
+// Ubah RegressionResult menjadi CompiledModel. Linear disimpan sebagai polynomial derajat 1.
+// Return 0 jika berhasil, -1 jika hasil regresi tidak valid.
+int compileModel(const RegressionResult *result, CompiledModel *model) {
+    memset(model, 0, sizeof(*model));
+    model->type = result->type;
+    if (result->type == REGRESSION_LINEAR) {
+        model->type = REGRESSION_POLYNOMIAL;
+        model->degree = 1;
+        model->coefficients[0] = result->intercept;
+        model->coefficients[1] = result->slope;
+        return 0;
+    }
+    if (result->type == REGRESSION_LOGISTIC) {
+        if (!(result->a > 0)) {
+            return -1;
+        }
+        // a e^(-b(x - m)) = e^(ln a + b m - b x)
+        model->logistic_c = result->c;
+        model->logistic_b = result->b;
+        model->logistic_k = log(result->a) + result->b * result->mean_x;
+        return 0;
+    }
+    if (!result->coefficients || result->degree < 0 || result->degree > MAX_POLY_DEGREE) {
+        return -1;
+    }
+    model->degree = result->degree;
+    memcpy(model->coefficients, result->coefficients, (result->degree + 1) * sizeof(double));
+    return 0;
+}
+
+double compiledModelEvalOne(const CompiledModel *model, double x) {
+    if (model->type == REGRESSION_LOGISTIC) {
+        return model->logistic_c / (1.0 + exp(model->logistic_k - model->logistic_b * x));
+    }
+    double y = model->coefficients[model->degree];
+    for (int i = model->degree - 1; i >= 0; i--) {
+        y = y * x + model->coefficients[i];
+    }
+    return y;
+}
+
+static void predictHornerScalar(const CompiledModel *model, const double *x, double *out, size_t n) {
+    const double *c = model->coefficients;
+    int degree = model->degree;
+    for (size_t i = 0; i < n; i++) {
+        double y = c[degree];
+        for (int j = degree - 1; j >= 0; j--) {
+            y = y * x[i] + c[j];
+        }
+        out[i] = y;
+    }
+}
+
+#if MOMENTS_HAVE_X86
+// Horner 8 titik per iterasi (dua vektor independen supaya latensi FMA tertutup)
+__attribute__((target("avx2,fma"))) static void predictHornerAVX2(const CompiledModel *model, const double *x,
+                                                                  double *out, size_t n) {
+    int degree = model->degree;
+    __m256d c[MAX_POLY_DEGREE + 1];
+    for (int j = 0; j <= degree; j++) {
+        c[j] = _mm256_set1_pd(model->coefficients[j]);
+    }
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256d x0 = _mm256_loadu_pd(x + i);
+        __m256d x1 = _mm256_loadu_pd(x + i + 4);
+        __m256d y0 = c[degree], y1 = c[degree];
+        for (int j = degree - 1; j >= 0; j--) {
+            y0 = _mm256_fmadd_pd(y0, x0, c[j]);
+            y1 = _mm256_fmadd_pd(y1, x1, c[j]);
+        }
+        _mm256_storeu_pd(out + i, y0);
+        _mm256_storeu_pd(out + i + 4, y1);
+    }
+    predictHornerScalar(model, x + i, out + i, n - i);
+}
+#endif
+
+// out[i] = model(x[i]). x dan out boleh array yang sama. x NaN menghasilkan NaN.
+void compiledModelEvalBatch(const CompiledModel *model, const double *x, double *out, size_t n) {
+    if (model->type == REGRESSION_LOGISTIC) {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = model->logistic_k - model->logistic_b * x[i];
+        }
+        vectorExp(out, n);
+        for (size_t i = 0; i < n; i++) {
+            out[i] = model->logistic_c / (1.0 + out[i]);
+        }
+        return;
+    }
+#if MOMENTS_HAVE_X86
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        predictHornerAVX2(model, x, out, n);
+        return;
+    }
+#endif
+    predictHornerScalar(model, x, out, n);
+}
+
+// Satu potongan input untuk satu thread: hasilnya ditulis ke buffer teks sendiri
+typedef struct {
+    const char *begin;
+    const char *end;
+    char *output;
+    size_t length;
+    size_t capacity;
+    size_t rows;
+    size_t skipped;
+    int status;
+} PredictChunk;
+
+typedef struct {
+    const CompiledModel *model;
+    PredictChunk *chunks;
+    int column;
+    int digits;
+} PredictJob;
+
+// Evaluasi dan format satu blok x ke buffer output potongan
+static int predictFlushBlock(const PredictJob *job, PredictChunk *chunk, double *x, size_t n) {
+    size_t needed = chunk->length + n * PREDICT_MAX_FIELD;
+    if (needed > chunk->capacity) {
+        size_t new_capacity = chunk->capacity ? chunk->capacity : 1 << 16;
+        while (new_capacity < needed) {
+            new_capacity *= 2;
+        }
+        char *grown = (char *)realloc(chunk->output, new_capacity);
+        if (!grown) {
+            return -1;
+        }
+        chunk->output = grown;
+        chunk->capacity = new_capacity;
+    }
+    compiledModelEvalBatch(job->model, x, x, n);
+    char *p = chunk->output + chunk->length;
+    for (size_t i = 0; i < n; i++) {
+        p += formatDouble(x[i], job->digits, p);
+        *p++ = '\n';
+    }
+    chunk->length = (size_t)(p - chunk->output);
+    return 0;
+}
+
+static void predictChunkWork(void *arg, size_t index) {
+    const PredictJob *job = (const PredictJob *)arg;
+    PredictChunk *chunk = &job->chunks[index];
+    double x[PREDICT_BLOCK];
+    size_t count = 0;
+    const char *p = chunk->begin;
+
+    while (p < chunk->end) {
+        const char *newline = (const char *)memchr(p, '\n', (size_t)(chunk->end - p));
+        const char *line_end = newline ? newline : chunk->end;
+        const char *next = newline ? newline + 1 : chunk->end;
+        if (line_end > p && line_end[-1] == '\r') {
+            line_end--;
+        }
+        // Satu baris output per baris input supaya hasil sejajar dengan file input; baris kosong
+        // diperlakukan seperti baris yang tidak numerik
+        double value, unused;
+        if (!parseCSVLineXY(p, line_end, job->column, job->column, &value, &unused)) {
+            value = NAN;
+            chunk->skipped++;
+        }
+        x[count++] = value;
+        chunk->rows++;
+        if (count == PREDICT_BLOCK) {
+            if (predictFlushBlock(job, chunk, x, count) != 0) {
+                chunk->status = -1;
+                return;
+            }
+            count = 0;
+        }
+        p = next;
+    }
+    if (count > 0 && predictFlushBlock(job, chunk, x, count) != 0) {
+        chunk->status = -1;
+    }
+}
+
+// Prediksi untuk setiap baris kolom `column` (0-based) di file input, ditulis satu nilai per
+// baris ke out dengan `digits` angka penting. Baris pertama yang bukan angka dianggap header
+// dan diganti "prediksi". Baris kosong atau yang kolomnya tidak numerik menghasilkan "nan". File dipetakan
+// ke memori dan diproses per jendela: setiap jendela dibagi per thread di batas newline,
+// dievaluasi per blok dengan compiledModelEvalBatch, lalu buffer ditulis berurutan dengan fwrite.
+// pool NULL berarti serial. Return CF_OK jika berhasil.
+CFStatus predictCSVFile(const CompiledModel *model, const char *input_path, int column, FILE *out,
+                        ThreadPool *pool, int digits, CSVLoadStats *stats) {
+    double start = monotonicSeconds();
+    MappedFile mf;
+    if (mapFile(input_path, &mf) != 0) {
+        return CF_ERROR_IO;
+    }
+
+    const char *p = mf.data;
+    const char *end = mf.data + mf.size;
+    while (p < end && (*p == '\n' || *p == '\r')) {
+        p++;
+    }
+    const char *first_end = (const char *)memchr(p, '\n', (size_t)(end - p));
+    first_end = first_end ? first_end : end;
+    double unused_x, unused_y;
+    if (p < end && !parseCSVLineXY(p, first_end, column, column, &unused_x, &unused_y)) {
+        fputs("prediksi\n", out);
+        p = first_end < end ? first_end + 1 : end;
+    }
+
+    int parts = pool ? pool->num_threads : 1;
+    const char **bounds = (const char **)malloc((parts + 1) * sizeof(const char *));
+    PredictChunk *chunks = (PredictChunk *)calloc(parts, sizeof(PredictChunk));
+    if (!bounds || !chunks) {
+        free(bounds);
+        free(chunks);
+        unmapFile(&mf);
+        return CF_ERROR_MEMORY;
+    }
+
+    PredictJob job = {model, chunks, column, digits < 1 ? 1 : (digits > 17 ? 17 : digits)};
+    size_t rows = 0, skipped = 0;
+    CFStatus status = CF_OK;
+    while (p < end && status == 0) {
+        // Jendela berakhir tepat setelah newline (atau di akhir file)
+        const char *window_end = end;
+        if ((size_t)(end - p) > PREDICT_WINDOW) {
+            const char *newline = (const char *)memchr(p + PREDICT_WINDOW, '\n', (size_t)(end - p - PREDICT_WINDOW));
+            window_end = newline ? newline + 1 : end;
+        }
+
+        int num_chunks = partitionCSVBody(p, window_end, parts, bounds);
+        for (int i = 0; i < num_chunks; i++) {
+            chunks[i].begin = bounds[i];
+            chunks[i].end = bounds[i + 1];
+            chunks[i].length = 0;
+        }
+        threadPoolParallelFor(pool, (size_t)num_chunks, predictChunkWork, &job);
+
+        for (int i = 0; i < num_chunks; i++) {
+            if (chunks[i].status != 0) {
+                status = CF_ERROR_MEMORY;
+                break;
+            }
+            if (fwrite(chunks[i].output, 1, chunks[i].length, out) != chunks[i].length) {
+                status = CF_ERROR_IO;
+                break;
+            }
+        }
+        p = window_end;
+    }
+
+    for (int i = 0; i < parts; i++) {
+        rows += chunks[i].rows;
+        skipped += chunks[i].skipped;
+        free(chunks[i].output);
+    }
+    metricsSpanEnd(METRIC_SPAN_PREDICT, start);
+    metricsAdd(METRIC_PREDICTIONS, rows);
+    metricsAdd(METRIC_BYTES_READ, mf.size);
+    metricsAdd(METRIC_ROWS_SKIPPED, skipped);
+    if (stats) {
+        stats->bytes_read = mf.size;
+        stats->rows = rows;
+        stats->rows_skipped = skipped;
+        stats->seconds = monotonicSeconds() - start;
+        stats->mb_per_sec = stats->seconds > 0 ? (double)stats->bytes_read / (1024.0 * 1024.0) / stats->seconds : 0;
+        stats->rows_per_sec = stats->seconds > 0 ? (double)rows / stats->seconds : 0;
+    }
+    free(bounds);
+    free(chunks);
+    unmapFile(&mf);
+    return status;
+}
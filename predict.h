@@ -0,0 +1,36 @@
+#ifndef PREDICT_H
+#define PREDICT_H
+
+#include "csv_parallel.h"
+#include "curve_fitting.h"
+#include "thread_pool.h"
+
+// Jumlah nilai x yang dievaluasi sekaligus (buffer di stack, muat di cache L1/L2)
+#define PREDICT_BLOCK 4096
+// Ukuran jendela input per putaran paralel; output jendela ditulis sebelum jendela berikutnya
+// diproses, sehingga memori tetap kecil untuk file sebesar apa pun
+#define PREDICT_WINDOW (64 << 20)
+// Batas panjang satu nilai hasil formatDouble plus newline
+#define PREDICT_MAX_FIELD 33
+
+// Model hasil regresi yang sudah "dikompilasi" menjadi bentuk siap evaluasi:
+// linear/polynomial: y = Σ coefficients[i] x^i (dievaluasi dengan Horner)
+// logistic: y = logistic_c / (1 + e^(logistic_k - logistic_b x)), konstanta pemusatan
+// mean_x sudah dilipat ke logistic_k sehingga tidak dihitung ulang per query
+typedef struct {
+    RegressionType type;
+    int degree;
+    double coefficients[MAX_POLY_DEGREE + 1];
+    double logistic_c;
+    double logistic_b;
+    double logistic_k;
+} CompiledModel;
+
+// Deklarasi fungsi
+int compileModel(const RegressionResult *result, CompiledModel *model);
+double compiledModelEvalOne(const CompiledModel *model, double x);
+void compiledModelEvalBatch(const CompiledModel *model, const double *x, double *out, size_t n);
+CFStatus predictCSVFile(const CompiledModel *model, const char *input_path, int column, FILE *out,
+                        ThreadPool *pool, int digits, CSVLoadStats *stats);
+
+#endif
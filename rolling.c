@@ -0,0 +1,141 @@
+#include "rolling.h"
+
+typedef struct {
+    const double *x;
+    const double *y;
+    size_t stride;
+    size_t n;
+    size_t window;
+    int degree;
+    size_t segment;         // Langkah per segmen (re-anchor)
+    size_t segments_per_chunk;
+    double *coefficients;
+    double *r_squared;
+} RollingJob;
+
+// Masukkan titik (x_in, y_in) dan keluarkan (x_out, y_out) dalam satu lintasan pangkat
+static inline void rollingSlide(PolyAccumulator *acc, double inv_scale, double x_in, double y_in, double x_out,
+                                double y_out) {
+    double t_in = (x_in - acc->shift) * inv_scale;
+    double t_out = (x_out - acc->shift) * inv_scale;
+    double dy_in = y_in - acc->y_shift;
+    double dy_out = y_out - acc->y_shift;
+    double p_in = 1.0, p_out = 1.0;
+    for (int k = 0; k <= acc->degree; k++) {
+        acc->power_sums[k] += p_in - p_out;
+        acc->cross_sums[k] += dy_in * p_in - dy_out * p_out;
+        p_in *= t_in;
+        p_out *= t_out;
+    }
+    for (int k = acc->degree + 1; k <= 2 * acc->degree; k++) {
+        acc->power_sums[k] += p_in - p_out;
+        p_in *= t_in;
+        p_out *= t_out;
+    }
+    acc->sum_yy += dy_in * dy_in - dy_out * dy_out;
+}
+
+// Satu segmen: langkah [first, last) dengan langkah s = jendela yang berakhir di titik s + window - 1
+static void rollingSegment(const RollingJob *job, size_t first, size_t last) {
+    size_t stride = job->stride;
+    int degree = job->degree;
+    const double *x = job->x;
+    const double *y = job->y;
+
+    // Basis baru untuk semua titik yang disentuh segmen ini
+    double shift, scale;
+    size_t touched = last - first + job->window - 1;
+    polyRangeScale(x + first * stride, stride, touched, &shift, &scale);
+
+    PolyAccumulator acc;
+    polyAccumulatorInit(&acc, degree, shift, scale, y[(first + job->window - 1) * stride]);
+    polyAccumulatorAdd(&acc, x + first * stride, y + first * stride, stride, job->window);
+    double inv_scale = 1.0 / acc.scale;
+
+    for (size_t s = first; s < last; s++) {
+        if (s > first) {
+            size_t in = s + job->window - 1, out = s - 1;
+            rollingSlide(&acc, inv_scale, x[in * stride], y[in * stride], x[out * stride], y[out * stride]);
+        }
+        double *coefficients = job->coefficients + s * (size_t)(degree + 1);
+        if (polyAccumulatorSolve(&acc, degree, coefficients, &job->r_squared[s]) != 0) {
+            for (int k = 0; k <= degree; k++) {
+                coefficients[k] = NAN;
+            }
+            job->r_squared[s] = NAN;
+        }
+    }
+}
+
+static void rollingChunkWork(void *arg, size_t chunk) {
+    const RollingJob *job = (const RollingJob *)arg;
+    size_t steps = job->n - job->window + 1;
+    size_t first = chunk * job->segments_per_chunk * job->segment;
+    for (size_t i = 0; i < job->segments_per_chunk && first < steps; i++) {
+        size_t last = first + job->segment < steps ? first + job->segment : steps;
+        rollingSegment(job, first, last);
+        first = last;
+    }
+}
+
+// Fit setiap jendela window titik berurutan. Hasil langkah s (jendela titik s .. s+window-1,
+// s = 0 .. n-window) ditulis ke coefficients[s * (degree + 1) + k] (basis x^k, linear: k = 0
+// intercept, k = 1 slope) dan r_squared[s]. Jendela yang tidak bisa di-fit berisi NaN.
+// pool NULL berarti dikerjakan di thread pemanggil.
+CFStatus rollingRegression(const double *x, const double *y, size_t stride, size_t n, size_t window, int degree,
+                           ThreadPool *pool, double *coefficients, double *r_squared) {
+    if (degree < 1 || degree > MAX_POLY_DEGREE || window < (size_t)degree + 1) {
+        return CF_ERROR_ARGUMENT;
+    }
+    if (n < window) {
+        return CF_ERROR_NO_DATA;
+    }
+
+    RollingJob job = {x, y, stride, n, window, degree, ROLLING_SEGMENT_FACTOR * window, 1, coefficients, r_squared};
+    if (job.segment < ROLLING_MIN_CHUNK) {
+        job.segments_per_chunk = (ROLLING_MIN_CHUNK + job.segment - 1) / job.segment;
+    }
+    size_t steps = n - window + 1;
+    size_t chunk_steps = job.segments_per_chunk * job.segment;
+    double span = metricsSpanBegin();
+    threadPoolParallelFor(pool, (steps + chunk_steps - 1) / chunk_steps, rollingChunkWork, &job);
+    metricsSpanEnd(METRIC_SPAN_ROLLING, span);
+    return CF_OK;
+}
+
+// Tulis satu baris per jendela: x titik terakhir jendela, lalu slope,intercept (linear) atau
+// c0..cD (polynomial), lalu R².
+void writeRollingCSV(FILE *out, const double *x, size_t stride, size_t n, size_t window, int degree,
+                     const double *coefficients, const double *r_squared, int digits) {
+    if (degree == 1) {
+        fprintf(out, "x,slope,intercept,r_squared\n");
+    } else {
+        fprintf(out, "x");
+        for (int k = 0; k <= degree; k++) {
+            fprintf(out, ",c%d", k);
+        }
+        fprintf(out, ",r_squared\n");
+    }
+
+    char line[(MAX_POLY_DEGREE + 3) * 33];
+    for (size_t s = 0; n >= window && s <= n - window; s++) {
+        const double *c = coefficients + s * (size_t)(degree + 1);
+        char *p = line;
+        p += formatDouble(x[(s + window - 1) * stride], digits, p);
+        if (degree == 1) {
+            *p++ = ',';
+            p += formatDouble(c[1], digits, p);
+            *p++ = ',';
+            p += formatDouble(c[0], digits, p);
+        } else {
+            for (int k = 0; k <= degree; k++) {
+                *p++ = ',';
+                p += formatDouble(c[k], digits, p);
+            }
+        }
+        *p++ = ',';
+        p += formatDouble(r_squared[s], digits, p);
+        *p++ = '\n';
+        fwrite(line, 1, (size_t)(p - line), out);
+    }
+}
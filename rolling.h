@@ -0,0 +1,26 @@
+#ifndef ROLLING_H
+#define ROLLING_H
+
+#include "curve_fitting.h"
+#include "thread_pool.h"
+
+// Regresi jendela bergulir: untuk setiap titik i >= window-1, fit linear/polynomial atas
+// window titik terakhir (i-window+1 .. i). Jumlah pangkat dan jumlah silang diperbarui O(degree)
+// per langkah (tambah titik baru, keluarkan titik tertua), sehingga total biaya O(N) dan tidak
+// O(N·window).
+//
+// Supaya error dari pengurangan tidak menumpuk dan pangkat t tetap kecil, langkah dibagi menjadi
+// segmen ROLLING_SEGMENT_FACTOR * window langkah. Di awal segmen akumulator dibangun ulang dengan
+// basis baru (re-anchor) yang meliputi semua titik segmen itu, jadi |t| <= 1. Segmen independen
+// satu sama lain dan dikerjakan paralel; hasilnya sama untuk berapa pun jumlah thread.
+
+#define ROLLING_SEGMENT_FACTOR 2
+#define ROLLING_MIN_CHUNK 16384 // Minimal langkah per tugas paralel (beberapa segmen digabung)
+
+// Deklarasi fungsi
+CFStatus rollingRegression(const double *x, const double *y, size_t stride, size_t n, size_t window, int degree,
+                           ThreadPool *pool, double *coefficients, double *r_squared);
+void writeRollingCSV(FILE *out, const double *x, size_t stride, size_t n, size_t window, int degree,
+                     const double *coefficients, const double *r_squared, int digits);
+
+#endif
@@ -0,0 +1,169 @@
+#include "spline.h"
+
+// Turunan kedua spline natural dari sistem tridiagonal (algoritma Thomas, O(N)):
+// h[i-1] M[i-1] + 2 (h[i-1] + h[i]) M[i] + h[i] M[i+1] = 6 (d[i] - d[i-1]), M[0] = M[n-1] = 0
+static int splineNaturalSecondDerivatives(const double *x, const double *y, size_t n, double *m) {
+    double *c_prime = (double *)malloc(n * sizeof(double));
+    if (!c_prime) {
+        return -1;
+    }
+    m[0] = 0.0;
+    c_prime[0] = 0.0;
+    for (size_t i = 1; i + 1 < n; i++) {
+        double h0 = x[i] - x[i - 1];
+        double h1 = x[i + 1] - x[i];
+        double rhs = 6.0 * ((y[i + 1] - y[i]) / h1 - (y[i] - y[i - 1]) / h0);
+        double denom = 2.0 * (h0 + h1) - h0 * c_prime[i - 1];
+        c_prime[i] = h1 / denom;
+        m[i] = (rhs - h0 * m[i - 1]) / denom;
+    }
+    m[n - 1] = 0.0;
+    for (size_t i = n - 1; i-- > 1;) {
+        m[i] -= c_prime[i] * m[i + 1];
+    }
+    free(c_prime);
+    return 0;
+}
+
+// Turunan pertama PCHIP: rata-rata harmonik berbobot dari slope segmen di titik dalam
+// (nol jika slope berganti tanda), rumus tiga titik yang menjaga bentuk di ujung
+static void splinePchipSlopes(const double *x, const double *y, size_t n, double *slopes) {
+    if (n == 2) {
+        slopes[0] = slopes[1] = (y[1] - y[0]) / (x[1] - x[0]);
+        return;
+    }
+    for (size_t i = 1; i + 1 < n; i++) {
+        double h0 = x[i] - x[i - 1], h1 = x[i + 1] - x[i];
+        double d0 = (y[i] - y[i - 1]) / h0, d1 = (y[i + 1] - y[i]) / h1;
+        if (d0 * d1 <= 0.0) {
+            slopes[i] = 0.0;
+        } else {
+            double w0 = 2.0 * h1 + h0, w1 = h1 + 2.0 * h0;
+            slopes[i] = (w0 + w1) / (w0 / d0 + w1 / d1);
+        }
+    }
+    for (int end = 0; end < 2; end++) {
+        // Ujung kiri memakai segmen 0 dan 1, ujung kanan segmen n-2 dan n-3
+        size_t a = end ? n - 1 : 0, b = end ? n - 2 : 1, c = end ? n - 3 : 2;
+        double h0 = fabs(x[b] - x[a]), h1 = fabs(x[c] - x[b]);
+        double d0 = (y[b] - y[a]) / (x[b] - x[a]), d1 = (y[c] - y[b]) / (x[c] - x[b]);
+        double slope = ((2.0 * h0 + h1) * d0 - h0 * d1) / (h0 + h1);
+        if (slope * d0 <= 0.0) {
+            slope = 0.0;
+        } else if (d0 * d1 < 0.0 && fabs(slope) > 3.0 * fabs(d0)) {
+            slope = 3.0 * d0;
+        }
+        slopes[a] = slope;
+    }
+}
+
+// Bangun spline dari n titik (stride 1 untuk kolom, 2 untuk DataPoint). Titik diurutkan dan
+// x duplikat dirata-rata lewat InterpIndex. Dengan 2 titik hasilnya garis lurus, dengan
+// 1 titik konstan. Return 0 jika berhasil, -1 jika tidak ada titik valid atau memori habis.
+int splineBuild(Spline *spline, const double *x, const double *y, size_t stride, size_t n, SplineKind kind,
+                ExtrapolationMode extrapolation) {
+    memset(spline, 0, sizeof(*spline));
+    spline->kind = kind;
+    if (interpIndexBuild(&spline->index, x, y, stride, n, extrapolation) != 0) {
+        return -1;
+    }
+    const double *xs = spline->index.x;
+    const double *ys = spline->index.y;
+    size_t count = spline->index.n;
+    size_t num_segments = count > 1 ? count - 1 : 1;
+
+    spline->segments = (SplineSegment *)malloc(num_segments * sizeof(SplineSegment));
+    double *work = (double *)malloc(count * sizeof(double));
+    if (!spline->segments || !work) {
+        free(work);
+        splineFree(spline);
+        return -1;
+    }
+    if (count == 1) {
+        spline->segments[0] = (SplineSegment){{ys[0], 0.0, 0.0, 0.0}};
+        free(work);
+        return 0;
+    }
+
+    if (kind == SPLINE_NATURAL) {
+        if (splineNaturalSecondDerivatives(xs, ys, count, work) != 0) {
+            free(work);
+            splineFree(spline);
+            return -1;
+        }
+        for (size_t i = 0; i + 1 < count; i++) {
+            double h = xs[i + 1] - xs[i];
+            double m0 = work[i], m1 = work[i + 1];
+            SplineSegment *seg = &spline->segments[i];
+            seg->c[0] = ys[i];
+            seg->c[1] = (ys[i + 1] - ys[i]) / h - h * (2.0 * m0 + m1) / 6.0;
+            seg->c[2] = 0.5 * m0;
+            seg->c[3] = (m1 - m0) / (6.0 * h);
+        }
+    } else {
+        splinePchipSlopes(xs, ys, count, work);
+        for (size_t i = 0; i + 1 < count; i++) {
+            double h = xs[i + 1] - xs[i];
+            double d = (ys[i + 1] - ys[i]) / h;
+            SplineSegment *seg = &spline->segments[i];
+            seg->c[0] = ys[i];
+            seg->c[1] = work[i];
+            seg->c[2] = (3.0 * d - 2.0 * work[i] - work[i + 1]) / h;
+            seg->c[3] = (work[i] + work[i + 1] - 2.0 * d) / (h * h);
+        }
+    }
+
+    // Turunan di ujung kanan dari segmen terakhir
+    const SplineSegment *last = &spline->segments[count - 2];
+    double h = xs[count - 1] - xs[count - 2];
+    spline->end_slope = last->c[1] + h * (2.0 * last->c[2] + 3.0 * h * last->c[3]);
+    free(work);
+    return 0;
+}
+
+void splineFree(Spline *spline) {
+    interpIndexFree(&spline->index);
+    free(spline->segments);
+    spline->segments = NULL;
+}
+
+// Nilai pada segmen `segment` (sudah dipilih), termasuk aturan ekstrapolasi
+static inline double splineEvalAt(const Spline *spline, size_t segment, double x) {
+    const InterpIndex *index = &spline->index;
+    size_t last = index->n - 1;
+    if (!(x >= index->x[0] && x <= index->x[last])) {
+        if (isnan(x) || index->extrapolation == EXTRAPOLATE_NAN) {
+            return NAN;
+        }
+        if (index->extrapolation == EXTRAPOLATE_CLAMP || index->n == 1) {
+            return x < index->x[0] ? index->y[0] : index->y[last];
+        }
+        // Linear: lanjutkan garis singgung di titik ujung
+        return x < index->x[0] ? index->y[0] + spline->segments[0].c[1] * (x - index->x[0])
+                               : index->y[last] + spline->end_slope * (x - index->x[last]);
+    }
+    const double *c = spline->segments[segment].c;
+    double d = x - index->x[segment];
+    return c[0] + d * (c[1] + d * (c[2] + d * c[3]));
+}
+
+// Satu query: pencarian biner O(log N) lalu Horner
+double splineEval(const Spline *spline, double x) {
+    return splineEvalAt(spline, interpIndexSegment(&spline->index, x), x);
+}
+
+// Banyak query; query yang urut naik memakai sapuan maju O(N + Q) seperti interpIndexLinearBatch
+void splineEvalBatch(const Spline *spline, const double *queries, double *out, size_t num_queries) {
+    if (spline->index.n < 2 || !interpQueriesSorted(queries, num_queries)) {
+        for (size_t i = 0; i < num_queries; i++) {
+            out[i] = splineEval(spline, queries[i]);
+        }
+        return;
+    }
+
+    size_t segment = 0;
+    for (size_t i = 0; i < num_queries; i++) {
+        segment = interpSweepSegment(&spline->index, segment, queries[i]);
+        out[i] = splineEvalAt(spline, segment, queries[i]);
+    }
+}
@@ -0,0 +1,31 @@
+#ifndef SPLINE_H
+#define SPLINE_H
+
+#include "interp.h"
+
+typedef enum {
+    SPLINE_NATURAL, // Cubic spline natural (turunan kedua nol di ujung), mulus C²
+    SPLINE_PCHIP    // Hermite kubik monoton (Fritsch-Carlson), tidak overshoot, C¹
+} SplineKind;
+
+// Koefisien satu segmen: y = c[0] + d (c[1] + d (c[2] + d c[3])), d = x - x[i].
+// Disimpan kontigu (32 byte per segmen) sehingga evaluasi = cari segmen + Horner.
+typedef struct {
+    double c[4];
+} SplineSegment;
+
+typedef struct {
+    InterpIndex index;       // Titik terurut (x unik), dipakai bersama interpolasi linear
+    SplineKind kind;
+    SplineSegment *segments; // index.n - 1 segmen (minimal 1)
+    double end_slope;        // Turunan di titik terakhir, untuk ekstrapolasi linear
+} Spline;
+
+// Deklarasi fungsi
+int splineBuild(Spline *spline, const double *x, const double *y, size_t stride, size_t n, SplineKind kind,
+                ExtrapolationMode extrapolation);
+void splineFree(Spline *spline);
+double splineEval(const Spline *spline, double x);
+void splineEvalBatch(const Spline *spline, const double *queries, double *out, size_t num_queries);
+
+#endif
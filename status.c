@@ -0,0 +1,22 @@
+#include "status.h"
+
+// Pesan singkat untuk ditampilkan pemanggil
+const char *cfStatusMessage(CFStatus status) {
+    switch (status) {
+    case CF_OK:
+        return "berhasil";
+    case CF_ERROR_IO:
+        return "file tidak dapat dibuka atau ditulis";
+    case CF_ERROR_FORMAT:
+        return "format file tidak valid";
+    case CF_ERROR_MEMORY:
+        return "memori tidak cukup";
+    case CF_ERROR_NO_DATA:
+        return "tidak ada data yang valid";
+    case CF_ERROR_ARGUMENT:
+        return "argumen tidak valid";
+    case CF_ERROR_EXTERNAL:
+        return "GNUPlot tidak tersedia atau gagal";
+    }
+    return "error tidak dikenal";
+}
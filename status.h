@@ -0,0 +1,20 @@
+#ifndef STATUS_H
+#define STATUS_H
+
+// Kode status fungsi library. Fungsi library tidak pernah mencetak ke console; pemanggil
+// (misalnya CLI) yang memutuskan apakah dan bagaimana error ditampilkan. CF_ERROR_IO bernilai
+// -1 supaya pemeriksaan lama "!= 0" / "== -1" tetap berlaku.
+typedef enum {
+    CF_OK = 0,
+    CF_ERROR_IO = -1,       // File tidak bisa dibuka, dibaca atau ditulis
+    CF_ERROR_FORMAT = -2,   // Isi file tidak valid (header CSV, file model, file state)
+    CF_ERROR_MEMORY = -3,   // Alokasi memori gagal
+    CF_ERROR_NO_DATA = -4,  // Tidak ada titik data yang valid
+    CF_ERROR_ARGUMENT = -5, // Argumen tidak valid (kolom, derajat, ukuran plot)
+    CF_ERROR_EXTERNAL = -6  // Program eksternal (gnuplot) tidak tersedia atau gagal
+} CFStatus;
+
+// Deklarasi fungsi
+const char *cfStatusMessage(CFStatus status);
+
+#endif
@@ -0,0 +1,201 @@
+#include "streaming.h"
+
+void defaultStreamOptions(StreamOptions *options, int x_column, int y_column) {
+    options->x_column = x_column;
+    options->y_column = y_column;
+    options->skip_header = 1;
+    options->complete_lines_only = 0;
+    options->max_rows = 0;
+    options->chunk_size = STREAM_DEFAULT_CHUNK;
+}
+
+typedef struct {
+    const StreamOptions *options;
+    StreamBatchFn fn;
+    void *ctx;
+    DataPoint *batch;
+    size_t batch_count;
+    size_t rows;
+    size_t skipped;
+    int header_pending;
+} StreamState;
+
+static void streamFlush(StreamState *st) {
+    if (st->batch_count) {
+        st->fn(st->ctx, st->batch, st->batch_count);
+        st->batch_count = 0;
+    }
+}
+
+// Proses satu baris lengkap (tanpa newline). Return 1 jika batas max_rows tercapai.
+static int streamLine(StreamState *st, const char *line, const char *line_end) {
+    if (line_end > line && line_end[-1] == '\r') {
+        line_end--;
+    }
+    if (st->header_pending) {
+        st->header_pending = 0;
+        return 0;
+    }
+    if (line_end == line) {
+        return 0;
+    }
+    double x, y;
+    if (!parseCSVLineXY(line, line_end, st->options->x_column, st->options->y_column, &x, &y)) {
+        st->skipped++;
+        return 0;
+    }
+    st->batch[st->batch_count].x = x;
+    st->batch[st->batch_count].y = y;
+    if (++st->batch_count == STREAM_BATCH) {
+        streamFlush(st);
+    }
+    st->rows++;
+    return st->options->max_rows && st->rows >= st->options->max_rows;
+}
+
+// Baca CSV dari stream dalam potongan berukuran tetap dan kirim titik-titiknya per batch
+// ke callback. Memori konstan (buffer hanya membesar jika ada satu baris yang lebih
+// panjang dari chunk). consumed_bytes (boleh NULL) berisi jumlah byte yang benar-benar
+// dikonsumsi sampai akhir baris terakhir yang diproses. Return 0 jika berhasil.
+int streamCSVPoints(FILE *in, const StreamOptions *options, StreamBatchFn fn, void *ctx,
+                    CSVLoadStats *stats, uint64_t *consumed_bytes) {
+    double start = monotonicSeconds();
+    size_t capacity = options->chunk_size ? options->chunk_size : STREAM_DEFAULT_CHUNK;
+    char *buffer = (char *)malloc(capacity);
+    DataPoint *batch = (DataPoint *)malloc(STREAM_BATCH * sizeof(DataPoint));
+    if (!buffer || !batch) {
+        free(buffer);
+        free(batch);
+        return -1;
+    }
+
+    StreamState st = {options, fn, ctx, batch, 0, 0, 0, options->skip_header};
+    uint64_t consumed = 0;
+    uint64_t total_read = 0;
+    size_t filled = 0;
+    int done = 0, eof = 0, status = 0;
+
+    while (!done && !eof) {
+        if (filled == capacity) {
+            // Satu baris lebih panjang dari buffer: perbesar buffer
+            char *grown = (char *)realloc(buffer, capacity * 2);
+            if (!grown) {
+                status = -1;
+                break;
+            }
+            buffer = grown;
+            capacity *= 2;
+        }
+        size_t got = fread(buffer + filled, 1, capacity - filled, in);
+        total_read += got;
+        filled += got;
+        eof = got == 0;
+
+        // Proses semua baris lengkap di buffer
+        const char *p = buffer;
+        const char *end = buffer + filled;
+        const char *newline;
+        while (!done && (newline = (const char *)memchr(p, '\n', (size_t)(end - p)))) {
+            done = streamLine(&st, p, newline);
+            p = newline + 1;
+        }
+        size_t used = (size_t)(p - buffer);
+        consumed += used;
+
+        // Baris terakhir tanpa newline di akhir stream
+        if (!done && eof && p < end && !options->complete_lines_only) {
+            streamLine(&st, p, end);
+            consumed += (size_t)(end - p);
+            used = filled;
+        }
+
+        memmove(buffer, buffer + used, filled - used);
+        filled -= used;
+        if (ferror(in)) {
+            status = -1;
+            break;
+        }
+    }
+    streamFlush(&st);
+
+    metricsSpanEnd(METRIC_SPAN_CSV_STREAM, start);
+    metricsAdd(METRIC_ROWS_PARSED, st.rows);
+    metricsAdd(METRIC_BYTES_READ, total_read);
+    metricsAdd(METRIC_ROWS_SKIPPED, st.skipped);
+    if (stats) {
+        stats->bytes_read = (size_t)total_read;
+        stats->rows = st.rows;
+        stats->rows_skipped = st.skipped;
+        stats->seconds = monotonicSeconds() - start;
+        stats->mb_per_sec = stats->seconds > 0 ? (double)total_read / (1024.0 * 1024.0) / stats->seconds : 0;
+        stats->rows_per_sec = stats->seconds > 0 ? (double)st.rows / stats->seconds : 0;
+    }
+    if (consumed_bytes) {
+        *consumed_bytes = consumed;
+    }
+    free(buffer);
+    free(batch);
+    return status;
+}
+
+void streamAccumulateBatch(void *ctx, const DataPoint *points, size_t count) {
+    StreamAccumulateCtx *c = (StreamAccumulateCtx *)ctx;
+    if (c->acc->n == 0 && c->acc->degree == 0) {
+        // Skala x diambil dari batch pertama, supaya tetap satu lintasan
+        double shift, scale;
+        polyRangeScale(&points[0].x, 2, count, &shift, &scale);
+        polyAccumulatorInit(c->acc, c->degree, shift, scale, points[0].y);
+    }
+    polyAccumulatorAdd(c->acc, &points[0].x, &points[0].y, 2, count);
+}
+
+// Lipat seluruh stream ke akumulator polynomial derajat `degree` dalam memori konstan.
+// Akumulator yang masih kosong (hasil memset 0) diinisialisasi dari batch pertama;
+// akumulator yang sudah berisi akan ditambah, sehingga hasil beberapa stream bisa digabung.
+int streamAccumulate(FILE *in, const StreamOptions *options, int degree, PolyAccumulator *acc,
+                     CSVLoadStats *stats, uint64_t *consumed_bytes) {
+    StreamAccumulateCtx ctx = {acc, degree};
+    return streamCSVPoints(in, options, streamAccumulateBatch, &ctx, stats, consumed_bytes);
+}
+
+// Function regresi linear/polynomial streaming untuk file yang tidak muat di RAM.
+// filename "-" berarti stdin. Hanya statistik cukup yang disimpan, R-squared tetap eksak.
+// Jika gagal, result berisi r_squared NaN.
+CFStatus streamRegression(const char *filename, int x_column, int y_column, RegressionType type, int degree,
+                          size_t chunk_size, CSVLoadStats *stats, RegressionResult *result) {
+    memset(result, 0, sizeof(*result));
+    result->type = type;
+    result->r_squared = NAN;
+    if (type == REGRESSION_LOGISTIC) {
+        return CF_ERROR_ARGUMENT;
+    }
+    if (type == REGRESSION_LINEAR) {
+        degree = 1;
+    }
+
+    FILE *in = strcmp(filename, "-") == 0 ? stdin : fopen(filename, "rb");
+    if (!in) {
+        return CF_ERROR_IO;
+    }
+
+    StreamOptions options;
+    defaultStreamOptions(&options, x_column, y_column);
+    if (chunk_size) {
+        options.chunk_size = chunk_size;
+    }
+
+    PolyAccumulator acc;
+    memset(&acc, 0, sizeof(acc));
+    int status = streamAccumulate(in, &options, degree, &acc, stats, NULL);
+    if (in != stdin) {
+        fclose(in);
+    }
+    if (status != 0) {
+        return CF_ERROR_IO;
+    }
+    if (acc.n == 0) {
+        return CF_ERROR_NO_DATA;
+    }
+    *result = regressionFromAccumulator(&acc, type, degree);
+    return CF_OK;
+}
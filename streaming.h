@@ -0,0 +1,40 @@
+#ifndef STREAMING_H
+#define STREAMING_H
+
+#include <stdint.h>
+
+#include "curve_fitting.h"
+
+// Ukuran buffer baca default dan jumlah titik per batch yang dikirim ke callback
+#define STREAM_DEFAULT_CHUNK (4 << 20)
+#define STREAM_BATCH 4096
+
+typedef struct {
+    int x_column;
+    int y_column;
+    int skip_header;         // Lewati baris pertama stream
+    int complete_lines_only; // Baris terakhir tanpa newline tidak dikonsumsi (file yang masih ditulis)
+    size_t max_rows;         // Berhenti setelah sekian baris data (0 = tanpa batas)
+    size_t chunk_size;       // Ukuran buffer baca dalam byte (0 = default)
+} StreamOptions;
+
+// Dipanggil untuk setiap batch titik yang sudah di-parse
+typedef void (*StreamBatchFn)(void *ctx, const DataPoint *points, size_t count);
+
+// Konteks streamAccumulateBatch (dipakai juga oleh mode inkremental)
+typedef struct {
+    PolyAccumulator *acc;
+    int degree;
+} StreamAccumulateCtx;
+
+// Deklarasi fungsi
+void defaultStreamOptions(StreamOptions *options, int x_column, int y_column);
+int streamCSVPoints(FILE *in, const StreamOptions *options, StreamBatchFn fn, void *ctx,
+                    CSVLoadStats *stats, uint64_t *consumed_bytes);
+int streamAccumulate(FILE *in, const StreamOptions *options, int degree, PolyAccumulator *acc,
+                     CSVLoadStats *stats, uint64_t *consumed_bytes);
+CFStatus streamRegression(const char *filename, int x_column, int y_column, RegressionType type, int degree,
+                          size_t chunk_size, CSVLoadStats *stats, RegressionResult *result);
+void streamAccumulateBatch(void *ctx, const DataPoint *points, size_t count);
+
+#endif
@@ -0,0 +1,139 @@
+#include "synthetic.h"
+
+void defaultSyntheticSpec(SyntheticSpec *spec, SyntheticShape shape, int sorted) {
+    spec->shape = shape;
+    spec->sorted = sorted;
+    spec->seed = 0x5EEDC0FFEEULL;
+    spec->noise = shape == SYNTHETIC_LOGISTIC ? 10.0 : 5.0;
+}
+
+const char *syntheticShapeName(SyntheticShape shape) {
+    switch (shape) {
+    case SYNTHETIC_LINEAR:
+        return "linear";
+    case SYNTHETIC_POLYNOMIAL:
+        return "polynomial";
+    case SYNTHETIC_LOGISTIC:
+        return "logistic";
+    }
+    return "?";
+}
+
+// Model yang cocok untuk bentuk data (polynomial: derajat 3)
+RegressionType syntheticRegressionType(SyntheticShape shape, int *degree) {
+    *degree = shape == SYNTHETIC_POLYNOMIAL ? 3 : 1;
+    if (shape == SYNTHETIC_POLYNOMIAL) {
+        return REGRESSION_POLYNOMIAL;
+    }
+    return shape == SYNTHETIC_LOGISTIC ? REGRESSION_LOGISTIC : REGRESSION_LINEAR;
+}
+
+// splitmix64 atas counter: nilai ke-k dari seed tanpa state bersama
+static inline double syntheticUniform(uint64_t seed, uint64_t k) {
+    uint64_t z = seed + (k + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return (double)(z >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Titik ke-i dari n titik
+void syntheticPoint(const SyntheticSpec *spec, size_t n, size_t i, double *x, double *y) {
+    double xv = spec->sorted ? SYNTHETIC_X_MAX * (double)i / (double)n
+                             : SYNTHETIC_X_MAX * syntheticUniform(spec->seed, 2 * (uint64_t)i);
+    double noise = spec->noise * (2.0 * syntheticUniform(spec->seed, 2 * (uint64_t)i + 1) - 1.0);
+    double yv;
+    switch (spec->shape) {
+    case SYNTHETIC_POLYNOMIAL:
+        yv = ((0.002 * xv - 0.3) * xv + 10.0) * xv + 5.0;
+        break;
+    case SYNTHETIC_LOGISTIC:
+        yv = 500.0 / (1.0 + exp(-0.12 * (xv - 50.0)));
+        break;
+    default:
+        yv = 2.5 * xv + 10.0;
+        break;
+    }
+    *x = xv;
+    *y = yv + noise;
+}
+
+// Isi n titik ke memori (stride 1 untuk kolom, 2 untuk array DataPoint)
+void syntheticGenerate(const SyntheticSpec *spec, size_t n, double *x, double *y, size_t stride) {
+    for (size_t i = 0; i < n; i++) {
+        syntheticPoint(spec, n, i, &x[i * stride], &y[i * stride]);
+    }
+}
+
+typedef struct {
+    const SyntheticSpec *spec;
+    size_t rows;
+    size_t first_block;
+    char **buffers;
+    size_t *lengths;
+} SyntheticWriteJob;
+
+static void syntheticFormatBlock(void *arg, size_t index) {
+    const SyntheticWriteJob *job = (const SyntheticWriteJob *)arg;
+    size_t begin = (job->first_block + index) * SYNTHETIC_BLOCK_ROWS;
+    size_t end = begin + SYNTHETIC_BLOCK_ROWS < job->rows ? begin + SYNTHETIC_BLOCK_ROWS : job->rows;
+    char *p = job->buffers[index];
+    for (size_t i = begin; i < end; i++) {
+        double x, y;
+        syntheticPoint(job->spec, job->rows, i, &x, &y);
+        p += formatDouble(x, 10, p);
+        *p++ = ',';
+        p += formatDouble(y, 10, p);
+        *p++ = '\n';
+    }
+    job->lengths[index] = (size_t)(p - job->buffers[index]);
+}
+
+// Tulis CSV "x,y" dengan rows baris data. Potongan diformat paralel lalu ditulis berurutan, jadi
+// memori tetap kecil untuk berapa pun jumlah baris. Ukuran file ditulis ke *bytes jika tidak NULL.
+CFStatus syntheticWriteCSV(const char *path, const SyntheticSpec *spec, size_t rows, ThreadPool *pool,
+                           size_t *bytes) {
+    FILE *out = fopen(path, "wb");
+    if (!out) {
+        return CF_ERROR_IO;
+    }
+    size_t window = pool ? 4 * (size_t)pool->num_threads : 1;
+    char **buffers = (char **)calloc(window, sizeof(char *));
+    size_t *lengths = (size_t *)calloc(window, sizeof(size_t));
+    CFStatus status = buffers && lengths ? CF_OK : CF_ERROR_MEMORY;
+    for (size_t i = 0; status == CF_OK && i < window; i++) {
+        buffers[i] = (char *)malloc(SYNTHETIC_BLOCK_ROWS * SYNTHETIC_MAX_LINE);
+        status = buffers[i] ? CF_OK : CF_ERROR_MEMORY;
+    }
+
+    size_t total = 0;
+    if (status == CF_OK) {
+        total = (size_t)fprintf(out, "x,y\n");
+        size_t blocks = (rows + SYNTHETIC_BLOCK_ROWS - 1) / SYNTHETIC_BLOCK_ROWS;
+        SyntheticWriteJob job = {spec, rows, 0, buffers, lengths};
+        for (; job.first_block < blocks && status == CF_OK; job.first_block += window) {
+            size_t count = blocks - job.first_block < window ? blocks - job.first_block : window;
+            threadPoolParallelFor(pool, count, syntheticFormatBlock, &job);
+            for (size_t i = 0; i < count; i++) {
+                if (fwrite(buffers[i], 1, lengths[i], out) != lengths[i]) {
+                    status = CF_ERROR_IO;
+                    break;
+                }
+                total += lengths[i];
+            }
+        }
+    }
+
+    for (size_t i = 0; buffers && i < window; i++) {
+        free(buffers[i]);
+    }
+    free(buffers);
+    free(lengths);
+    if (fclose(out) != 0 && status == CF_OK) {
+        status = CF_ERROR_IO;
+    }
+    if (bytes) {
+        *bytes = total;
+    }
+    return status;
+}
@@ -0,0 +1,39 @@
+#ifndef SYNTHETIC_H
+#define SYNTHETIC_H
+
+#include <stdint.h>
+
+#include "curve_fitting.h"
+#include "thread_pool.h"
+
+// Generator data sintetis deterministik untuk benchmark. Titik ke-i hanya bergantung pada seed dan i
+// (RNG berbasis counter, bukan state berurutan), sehingga file sebesar apa pun bisa ditulis paralel
+// per potongan dan isinya selalu sama untuk seed yang sama.
+
+#define SYNTHETIC_BLOCK_ROWS (1 << 15) // Baris per potongan paralel saat menulis CSV
+#define SYNTHETIC_MAX_LINE 48          // Panjang maksimal satu baris "x,y\n"
+#define SYNTHETIC_X_MAX 100.0          // x berada di [0, SYNTHETIC_X_MAX)
+
+typedef enum {
+    SYNTHETIC_LINEAR,     // y = 2.5 x + 10 + noise
+    SYNTHETIC_POLYNOMIAL, // y = 0.002 x³ - 0.3 x² + 10 x + 5 + noise
+    SYNTHETIC_LOGISTIC    // y = 500 / (1 + e^(-0.12 (x - 50))) + noise
+} SyntheticShape;
+
+typedef struct {
+    SyntheticShape shape;
+    int sorted;   // 1: x naik seperti deret waktu, 0: x acak
+    uint64_t seed;
+    double noise; // Amplitudo noise seragam (± noise)
+} SyntheticSpec;
+
+// Deklarasi fungsi
+void defaultSyntheticSpec(SyntheticSpec *spec, SyntheticShape shape, int sorted);
+const char *syntheticShapeName(SyntheticShape shape);
+RegressionType syntheticRegressionType(SyntheticShape shape, int *degree);
+void syntheticPoint(const SyntheticSpec *spec, size_t n, size_t i, double *x, double *y);
+void syntheticGenerate(const SyntheticSpec *spec, size_t n, double *x, double *y, size_t stride);
+CFStatus syntheticWriteCSV(const char *path, const SyntheticSpec *spec, size_t rows, ThreadPool *pool,
+                           size_t *bytes);
+
+#endif
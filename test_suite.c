@@ -0,0 +1,369 @@
+#include "dataset.h"
+#include "group_fit.h"
+#include "least_squares.h"
+#include "model_select.h"
+#include "predict.h"
+#include "rolling.h"
+
+#include <unistd.h>
+
+// Cek kebenaran numerik untuk mesin-mesin fitting: setiap cek membandingkan hasil jalur cepat dengan
+// fit langsung (polyFit) atas data yang sama, atau dengan sifat yang pasti berlaku. Data sintetis
+// deterministik, jadi hasilnya sama di setiap run.
+// Build dan jalankan: make check (exit code bukan 0 jika ada cek yang gagal).
+
+static uint64_t check_rng_state = 0x9E3779B97F4A7C15ULL;
+static int check_failures = 0;
+
+// splitmix64, sama dengan benchmark
+static double checkUniform(void) {
+    uint64_t z = (check_rng_state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return (double)(z >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Selisih relatif terhadap max(1, |expected|)
+static double relativeError(double actual, double expected) {
+    return fabs(actual - expected) / (fabs(expected) > 1 ? fabs(expected) : 1.0);
+}
+
+static int checkClose(double actual, double expected, double tolerance) {
+    return relativeError(actual, expected) <= tolerance;
+}
+
+static void checkReport(const char *name, int ok, const char *detail) {
+    printf("%-44s %s%s%s\n", name, ok ? "ok" : "GAGAL", detail[0] ? "  " : "", detail);
+    check_failures += !ok;
+}
+
+// loadDataset (paralel, berapa pun jumlah thread) + datasetPairColumns harus menghasilkan pasangan yang
+// sama baris per baris dengan loader serial readCSVData, termasuk baris rusak yang dilewati
+static void checkParallelLoader(void) {
+    enum { ROWS = 200000 };
+    char path[] = "/tmp/curvefit_check_XXXXXX";
+    int fd = mkstemp(path);
+    FILE *out = fd >= 0 ? fdopen(fd, "w") : NULL;
+    if (!out) {
+        checkReport("loader paralel vs readCSVData", 0, "(file sementara gagal dibuat)");
+        return;
+    }
+    fprintf(out, "a,b,c\n");
+    for (int i = 0; i < ROWS; i++) {
+        double u = checkUniform();
+        if (u < 0.001) {
+            fprintf(out, "abc,%d,\n", i); // Kolom a dan c bukan angka
+        } else if (u < 0.002) {
+            fprintf(out, "\n");
+        } else if (u < 0.003) {
+            fprintf(out, "%d\r\n", i); // Kolom b dan c tidak ada
+        } else {
+            fprintf(out, "%.17g,%d,%.6e%s\n", checkUniform() * 1e3 - 500, i, checkUniform(), u < 0.5 ? "" : "\r");
+        }
+    }
+    fclose(out);
+
+    static const int pairs[][2] = {{0, 2}, {2, 1}, {1, 0}};
+    static const int threads[] = {1, 3, 8};
+    int ok = 1;
+    size_t rows = 0;
+    for (int p = 0; p < 3; p++) {
+        int serial_n = 0;
+        DataPoint *serial = readCSVData(path, pairs[p][0], pairs[p][1], &serial_n);
+        ok &= serial != NULL;
+        for (int t = 0; serial && t < 3; t++) {
+            Dataset ds;
+            const double *x, *y;
+            double *scratch = NULL;
+            int n = 0;
+            if (loadDataset(path, &ds, threads[t], NULL) != CF_OK) {
+                ok = 0;
+                continue;
+            }
+            ok &= datasetPairColumns(&ds, pairs[p][0], pairs[p][1], &x, &y, &n, &scratch) == 0 && n == serial_n;
+            for (int i = 0; ok && i < n; i++) {
+                ok &= x[i] == serial[i].x && y[i] == serial[i].y;
+            }
+            free(scratch);
+            freeDataset(&ds);
+        }
+        rows = (size_t)serial_n;
+        free(serial);
+    }
+    unlink(path);
+    char detail[64];
+    snprintf(detail, sizeof(detail), "(%zu baris, thread 1/3/8)", rows);
+    checkReport("loader paralel vs readCSVData", ok, detail);
+}
+
+// Satu kolom x dengan derajat d di leastSquaresFit harus sama dengan polynomial derajat d (QR)
+static void checkLeastSquaresPolynomial(void) {
+    enum { N = 5000 };
+    double x[N], y[N];
+    for (int i = 0; i < N; i++) {
+        x[i] = 10.0 * checkUniform();
+        y[i] = 0.3 * x[i] * x[i] * x[i] - x[i] + 2.0 + (checkUniform() - 0.5);
+    }
+    double worst = 0;
+    int ok = 1;
+    for (int degree = 1; degree <= 6; degree++) {
+        const double *columns[1] = {x};
+        LeastSquaresResult lsq;
+        double coefficients[MAX_POLY_DEGREE + 1], r_squared;
+        if (leastSquaresFit(columns, &degree, 1, 1, y, NULL, N, POLY_SOLVER_AUTO, NULL, &lsq) != CF_OK ||
+            polyFit(x, y, 1, N, degree, POLY_SOLVER_QR, coefficients, &r_squared) != 0) {
+            ok = 0;
+            continue;
+        }
+        // Bandingkan nilai fit, bukan koefisien, supaya kondisi basis x biasa tidak ikut diuji
+        for (int i = 0; i < N; i += 97) {
+            double expected = 0;
+            for (int k = degree; k >= 0; k--) {
+                expected = expected * x[i] + coefficients[k];
+            }
+            double actual = leastSquaresEval(&lsq, &x[i]);
+            double error = relativeError(actual, expected);
+            worst = error > worst ? error : worst;
+        }
+        ok &= checkClose(lsq.r_squared, r_squared, 1e-10);
+    }
+    ok &= worst < 1e-9;
+    char detail[64];
+    snprintf(detail, sizeof(detail), "(selisih relatif maks %.1e)", worst);
+    checkReport("least squares satu kolom vs polyFit", ok, detail);
+}
+
+// Kolom x yang kolinear persis (duplikat atau transformasi affine) harus ditolak, bukan diberi koefisien 0.
+// Pivot Cholesky kolom seperti itu kadang tetap sedikit positif karena pembulatan, jadi dicoba beberapa data.
+// Polynomial derajat tinggi satu kolom (matriks buruk tapi full rank) tetap harus bisa di-fit.
+static void checkLeastSquaresCollinear(void) {
+    enum { N = 1000, TRIALS = 20 };
+    static double a[N], b[N], c[N], y[N];
+    LeastSquaresResult result;
+    const double *duplicate[2] = {a, a}, *affine[3] = {a, c, b}, *independent[2] = {a, c}, *single[1] = {a};
+    int ten = MAX_POLY_DEGREE, accepted = 0, ok = 1;
+    for (int trial = 0; trial < TRIALS; trial++) {
+        for (int i = 0; i < N; i++) {
+            a[i] = 10.0 * checkUniform();
+            b[i] = 2.0 * a[i] + 1.0;
+            c[i] = 10.0 * checkUniform() - 5.0;
+            y[i] = 3.0 * a[i] - c[i] + (checkUniform() - 0.5);
+        }
+        CFStatus status = leastSquaresFit(duplicate, NULL, 2, 1, y, NULL, N, POLY_SOLVER_AUTO, NULL, &result);
+        accepted += status != CF_ERROR_ARGUMENT;
+        status = leastSquaresFit(affine, NULL, 3, 1, y, NULL, N, POLY_SOLVER_AUTO, NULL, &result);
+        accepted += status != CF_ERROR_ARGUMENT;
+        ok &= leastSquaresFit(independent, NULL, 2, 1, y, NULL, N, POLY_SOLVER_AUTO, NULL, &result) == CF_OK &&
+              checkClose(result.coefficients[1], 3.0, 1e-2) && checkClose(result.coefficients[2], -1.0, 1e-2);
+        ok &= leastSquaresFit(single, &ten, 1, 1, y, NULL, N, POLY_SOLVER_AUTO, NULL, &result) == CF_OK;
+    }
+    char detail[64];
+    snprintf(detail, sizeof(detail), "(%d dari %d fit kolinear diterima)", accepted, 2 * TRIALS);
+    checkReport("least squares menolak kolom kolinear", ok && accepted == 0, detail);
+}
+
+// Setiap jendela rollingRegression harus sama dengan polyFit atas jendela yang sama
+static void checkRollingDirect(void) {
+    enum { N = 3000, WINDOW = 50 };
+    static double x[N], y[N], coefficients[N * (MAX_POLY_DEGREE + 1)], r_squared[N];
+    for (int i = 0; i < N; i++) {
+        x[i] = 1000.0 + 0.1 * i;
+        y[i] = 10.0 * sin(i * 0.01) + (checkUniform() - 0.5);
+    }
+    double worst = 0;
+    int ok = 1;
+    for (int degree = 1; degree <= 3; degree++) {
+        if (rollingRegression(x, y, 1, N, WINDOW, degree, threadPoolShared(), coefficients, r_squared) != CF_OK) {
+            ok = 0;
+            continue;
+        }
+        for (int s = 0; s + WINDOW <= N; s++) {
+            double direct[MAX_POLY_DEGREE + 1], direct_r2;
+            if (polyFit(x + s, y + s, 1, WINDOW, degree, POLY_SOLVER_QR, direct, &direct_r2) != 0) {
+                ok = 0;
+                break;
+            }
+            const double *rolling = coefficients + (size_t)s * (degree + 1);
+            // Nilai fit di titik terakhir jendela (koefisien basis x biasa sangat sensitif untuk x ~ 1000)
+            double xs = x[s + WINDOW - 1], expected = 0, actual = 0;
+            for (int k = degree; k >= 0; k--) {
+                expected = expected * xs + direct[k];
+                actual = actual * xs + rolling[k];
+            }
+            double error = relativeError(actual, expected);
+            worst = error > worst ? error : worst;
+            ok &= checkClose(r_squared[s], direct_r2, 1e-8);
+        }
+    }
+    ok &= worst < 1e-6;
+    char detail[64];
+    snprintf(detail, sizeof(detail), "(selisih relatif maks %.1e)", worst);
+    checkReport("rolling vs fit langsung per jendela", ok, detail);
+}
+
+// groupFitFile harus sama dengan polyFit atas titik-titik satu kunci, urut kemunculan pertama
+static void checkGroupFit(void) {
+    enum { N = 6000, KEYS = 3 };
+    static const char *keys[KEYS] = {"beta", "alpha", "gamma"};
+    static double x[KEYS][N], y[KEYS][N];
+    size_t count[KEYS] = {0};
+    int order[KEYS], num_seen = 0; // Kunci menurut kemunculan pertama
+    char path[] = "/tmp/curvefit_check_XXXXXX";
+    int fd = mkstemp(path);
+    FILE *out = fd >= 0 ? fdopen(fd, "w") : NULL;
+    if (!out) {
+        checkReport("group vs fit per kunci", 0, "(file sementara gagal dibuat)");
+        return;
+    }
+    fprintf(out, "sensor,x,y\n");
+    for (int i = 0; i < N; i++) {
+        int key = (int)(checkUniform() * KEYS);
+        if (count[key] == 0) {
+            order[num_seen++] = key;
+        }
+        double xv = 1.7e9 + 3600.0 * i, t = (xv - 1.7e9) / 3.6e6;
+        double yv = (key + 1) * t * t - key * t + key + (checkUniform() - 0.5) * 0.1;
+        x[key][count[key]] = xv;
+        y[key][count[key]++] = yv;
+        fprintf(out, "%s,%.17g,%.17g\n", keys[key], xv, yv);
+    }
+    fclose(out);
+
+    int ok = 1;
+    double worst = 0;
+    for (int degree = 1; degree <= 3; degree++) {
+        GroupFitEntry *entries = NULL;
+        size_t num_groups = 0;
+        RegressionType type = degree == 1 ? REGRESSION_LINEAR : REGRESSION_POLYNOMIAL;
+        if (groupFitFile(path, 0, 1, 2, type, degree, threadPoolShared(), &entries, &num_groups, NULL) != CF_OK ||
+            num_groups != KEYS) {
+            ok = 0;
+            freeGroupFit(entries, num_groups);
+            continue;
+        }
+        for (size_t g = 0; g < num_groups; g++) {
+            int key = order[g];
+            if (strcmp(keys[key], entries[g].key) != 0 || entries[g].num_points != count[key]) {
+                ok = 0;
+                continue;
+            }
+            double direct[MAX_POLY_DEGREE + 1], direct_r2;
+            polyFit(x[key], y[key], 1, count[key], degree, POLY_SOLVER_QR, direct, &direct_r2);
+            const RegressionResult *r = &entries[g].result;
+            double xs = x[key][count[key] - 1], expected = 0, actual = 0;
+            for (int k = degree; k >= 0; k--) {
+                expected = expected * xs + direct[k];
+                actual = actual * xs + (degree == 1 ? (k ? r->slope : r->intercept) : r->coefficients[k]);
+            }
+            double error = relativeError(actual, expected);
+            worst = error > worst ? error : worst;
+            ok &= checkClose(r->r_squared, direct_r2, 1e-8);
+        }
+        freeGroupFit(entries, num_groups);
+    }
+    unlink(path);
+    ok &= worst < 1e-6;
+    char detail[64];
+    snprintf(detail, sizeof(detail), "(selisih relatif maks %.1e)", worst);
+    checkReport("group vs fit per kunci", ok, detail);
+}
+
+// predict menulis tepat satu baris output per baris input: baris kosong dan yang bukan angka menjadi "nan"
+static void checkPredictLineAlignment(void) {
+    static const char input[] = "x\n1\n\n2\r\nabc\n3";
+    static const double expected[] = {3, NAN, 5, NAN, 7};
+    enum { LINES = sizeof(expected) / sizeof(expected[0]) };
+    char path[] = "/tmp/curvefit_check_XXXXXX";
+    int fd = mkstemp(path);
+    FILE *in = fd >= 0 ? fdopen(fd, "w") : NULL;
+    if (!in) {
+        checkReport("predict satu baris output per baris input", 0, "(file sementara gagal dibuat)");
+        return;
+    }
+    fputs(input, in);
+    fclose(in);
+
+    CompiledModel model;
+    memset(&model, 0, sizeof(model));
+    model.type = REGRESSION_POLYNOMIAL;
+    model.degree = 1;
+    model.coefficients[0] = 1.0;
+    model.coefficients[1] = 2.0;
+    ThreadPool *pools[] = {NULL, threadPoolShared()};
+    int ok = 1;
+    for (int t = 0; t < 2; t++) {
+        FILE *out = tmpfile();
+        CSVLoadStats stats;
+        char line[64];
+        int lines = 0;
+        ok &= out && predictCSVFile(&model, path, 0, out, pools[t], 17, &stats) == CF_OK;
+        if (!out) {
+            continue;
+        }
+        rewind(out);
+        ok &= fgets(line, sizeof(line), out) && strcmp(line, "prediksi\n") == 0;
+        for (; fgets(line, sizeof(line), out); lines++) {
+            double value = strtod(line, NULL);
+            ok &= lines < LINES && (isnan(expected[lines]) ? isnan(value) : value == expected[lines]);
+        }
+        ok &= lines == LINES && stats.rows == LINES && stats.rows_skipped == 2;
+        fclose(out);
+    }
+    unlink(path);
+    checkReport("predict satu baris output per baris input", ok, "(baris kosong dan bukan angka, serial dan paralel)");
+}
+
+// 1e6 baris terurut dari kubik plus noise U(±0.5), R² ≈ 1 - 1e-12. SSE yang dihitung dari jumlah pangkat
+// tenggelam dalam pembulatan di sini sehingga BIC memilih derajat acak. Fit kuadrat terkecil tidak boleh
+// lebih buruk dari model sebenarnya, dan BIC harus memilih derajat 3.
+static void checkAutoFitSortedCubic(void) {
+    enum { N = 1000000 };
+    double *x = (double *)malloc(N * sizeof(double));
+    double *y = (double *)malloc(N * sizeof(double));
+    if (!x || !y) {
+        free(x);
+        free(y);
+        checkReport("autofit kubik terurut", 0, "(memori tidak cukup)");
+        return;
+    }
+    double true_sse = 0;
+    for (size_t i = 0; i < N; i++) {
+        double noise = checkUniform() - 0.5;
+        x[i] = 100.0 * ((double)i + checkUniform()) / N;
+        y[i] = x[i] * x[i] * x[i] - 2.0 * x[i] * x[i] + 3.0 * x[i] - 1.0 + noise;
+        true_sse += noise * noise;
+    }
+
+    AutoFitOptions options;
+    AutoFitResult result;
+    defaultAutoFitOptions(&options);
+    options.include_logistic = 0;
+    options.criterion = AUTOFIT_CRITERION_BIC;
+    char detail[128] = "";
+    int ok = autoFit(x, y, 1, N, &options, threadPoolShared(), &result) == CF_OK;
+    if (ok) {
+        const AutoFitCandidate *cubic = &result.candidates[2];
+        double fit_score = cubic->aic - 2.0 * cubic->num_params; // n·ln(SSE/n)
+        double true_score = N * log(true_sse / N);
+        ok = result.best == 2 && fit_score <= true_score + 1.0;
+        snprintf(detail, sizeof(detail), "(BIC memilih derajat %d, n·ln(SSE/n) %.1f vs model sebenarnya %.1f)",
+                 result.candidates[result.best].degree, fit_score, true_score);
+        freeAutoFitResult(&result);
+    }
+    free(x);
+    free(y);
+    checkReport("autofit kubik terurut, N = 1e6", ok, detail);
+}
+
+int main(void) {
+    checkParallelLoader();
+    checkLeastSquaresPolynomial();
+    checkLeastSquaresCollinear();
+    checkRollingDirect();
+    checkGroupFit();
+    checkPredictLineAlignment();
+    checkAutoFitSortedCubic();
+    printf("\n%d cek gagal\n", check_failures);
+    return check_failures ? 1 : 0;
+}
@@ -0,0 +1,323 @@
+#include "thread_pool.h"
+
+// Indeks worker untuk thread saat ini (-1 jika bukan worker pool tersebut)
+static __thread ThreadPool *pool_current = NULL;
+static __thread int pool_current_index = -1;
+
+static int poolDequePush(PoolDeque *q, PoolTask task) {
+    pthread_mutex_lock(&q->lock);
+    if (q->tail - q->head == q->capacity) {
+        size_t new_capacity = q->capacity ? q->capacity * 2 : 64;
+        PoolTask *grown = (PoolTask *)malloc(new_capacity * sizeof(PoolTask));
+        if (!grown) {
+            pthread_mutex_unlock(&q->lock);
+            return -1;
+        }
+        for (size_t i = q->head; i < q->tail; i++) {
+            grown[i & (new_capacity - 1)] = q->tasks[i & (q->capacity - 1)];
+        }
+        free(q->tasks);
+        q->tasks = grown;
+        q->capacity = new_capacity;
+    }
+    q->tasks[q->tail & (q->capacity - 1)] = task;
+    q->tail++;
+    pthread_mutex_unlock(&q->lock);
+    return 0;
+}
+
+static int poolDequePop(PoolDeque *q, PoolTask *task, int steal) {
+    int found = 0;
+    pthread_mutex_lock(&q->lock);
+    if (q->tail != q->head) {
+        if (steal) {
+            *task = q->tasks[q->head & (q->capacity - 1)];
+            q->head++;
+        } else {
+            q->tail--;
+            *task = q->tasks[q->tail & (q->capacity - 1)];
+        }
+        found = 1;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return found;
+}
+
+// Ambil tugas dari deque sendiri, atau curi dari worker lain
+static int poolTakeTask(ThreadPool *pool, int self, PoolTask *task) {
+    if (atomic_load_explicit(&pool->queued, memory_order_acquire) == 0) {
+        return 0;
+    }
+    if (self >= 0 && poolDequePop(&pool->queues[self], task, 0)) {
+        atomic_fetch_sub(&pool->queued, 1);
+        return 1;
+    }
+    int start = self >= 0 ? self + 1 : 0;
+    for (int i = 0; i < pool->num_threads; i++) {
+        int victim = (start + i) % pool->num_threads;
+        if (victim != self && poolDequePop(&pool->queues[victim], task, 1)) {
+            atomic_fetch_sub(&pool->queued, 1);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void poolRunTask(ThreadPool *pool, PoolTask task) {
+    task.fn(task.arg);
+    if (atomic_fetch_sub(&pool->pending, 1) == 1) {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_broadcast(&pool->idle_cond);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+typedef struct {
+    ThreadPool *pool;
+    int index;
+} PoolWorkerArg;
+
+static void *poolWorkerMain(void *arg) {
+    PoolWorkerArg *worker = (PoolWorkerArg *)arg;
+    ThreadPool *pool = worker->pool;
+    int self = worker->index;
+    free(worker);
+    pool_current = pool;
+    pool_current_index = self;
+
+    for (;;) {
+        PoolTask task;
+        if (poolTakeTask(pool, self, &task)) {
+            poolRunTask(pool, task);
+            continue;
+        }
+        pthread_mutex_lock(&pool->lock);
+        while (!pool->shutdown && atomic_load(&pool->queued) == 0) {
+            pthread_cond_wait(&pool->work_cond, &pool->lock);
+        }
+        int stop = pool->shutdown && atomic_load(&pool->queued) == 0;
+        pthread_mutex_unlock(&pool->lock);
+        if (stop) {
+            break;
+        }
+    }
+    return NULL;
+}
+
+// Buat pool dengan num_threads worker (<= 0 berarti 1 worker)
+ThreadPool *threadPoolCreate(int num_threads) {
+    if (num_threads < 1) {
+        num_threads = 1;
+    }
+    ThreadPool *pool = (ThreadPool *)calloc(1, sizeof(ThreadPool));
+    if (!pool) {
+        return NULL;
+    }
+    pool->threads = (pthread_t *)calloc(num_threads, sizeof(pthread_t));
+    pool->queues = (PoolDeque *)calloc(num_threads, sizeof(PoolDeque));
+    if (!pool->threads || !pool->queues) {
+        free(pool->threads);
+        free(pool->queues);
+        free(pool);
+        return NULL;
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_cond, NULL);
+    pthread_cond_init(&pool->idle_cond, NULL);
+    atomic_init(&pool->queued, 0);
+    atomic_init(&pool->pending, 0);
+    atomic_init(&pool->next_queue, 0);
+    for (int i = 0; i < num_threads; i++) {
+        pthread_mutex_init(&pool->queues[i].lock, NULL);
+    }
+
+    for (int i = 0; i < num_threads; i++) {
+        PoolWorkerArg *worker = (PoolWorkerArg *)malloc(sizeof(PoolWorkerArg));
+        if (!worker) {
+            break;
+        }
+        worker->pool = pool;
+        worker->index = i;
+        if (pthread_create(&pool->threads[i], NULL, poolWorkerMain, worker) != 0) {
+            free(worker);
+            break;
+        }
+        pool->num_threads = i + 1;
+    }
+    if (pool->num_threads == 0) {
+        threadPoolDestroy(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+// Kirim tugas ke pool. Dari dalam worker, tugas masuk ke deque worker itu sendiri.
+// Jika pool NULL tugas langsung dijalankan di thread pemanggil.
+void threadPoolSubmit(ThreadPool *pool, PoolTaskFn fn, void *arg) {
+    if (!pool) {
+        fn(arg);
+        return;
+    }
+    PoolTask task = {fn, arg};
+    int target = (pool_current == pool) ? pool_current_index
+                                        : (int)(atomic_fetch_add(&pool->next_queue, 1) % (unsigned)pool->num_threads);
+    atomic_fetch_add(&pool->pending, 1);
+    atomic_fetch_add(&pool->queued, 1);
+    if (poolDequePush(&pool->queues[target], task) != 0) {
+        atomic_fetch_sub(&pool->queued, 1);
+        poolRunTask(pool, task);
+        return;
+    }
+    pthread_mutex_lock(&pool->lock);
+    pthread_cond_signal(&pool->work_cond);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+// Tunggu sampai semua tugas selesai. Thread pemanggil ikut mengerjakan tugas.
+// Jangan dipanggil dari dalam tugas pool (gunakan threadPoolParallelFor).
+void threadPoolWait(ThreadPool *pool) {
+    if (!pool) {
+        return;
+    }
+    while (atomic_load(&pool->pending) > 0) {
+        PoolTask task;
+        if (poolTakeTask(pool, -1, &task)) {
+            poolRunTask(pool, task);
+            continue;
+        }
+        pthread_mutex_lock(&pool->lock);
+        if (atomic_load(&pool->pending) > 0 && atomic_load(&pool->queued) == 0) {
+            pthread_cond_wait(&pool->idle_cond, &pool->lock);
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+typedef struct {
+    PoolRangeFn fn;
+    void *arg;
+    size_t total;
+    atomic_size_t next;
+    atomic_size_t done;
+    atomic_int refs;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+} PoolRangeJob;
+
+static void poolRangeRelease(PoolRangeJob *job) {
+    if (atomic_fetch_sub(&job->refs, 1) == 1) {
+        pthread_mutex_destroy(&job->lock);
+        pthread_cond_destroy(&job->cond);
+        free(job);
+    }
+}
+
+static void poolRangeWork(PoolRangeJob *job) {
+    size_t chunk;
+    while ((chunk = atomic_fetch_add(&job->next, 1)) < job->total) {
+        job->fn(job->arg, chunk);
+        if (atomic_fetch_add(&job->done, 1) + 1 == job->total) {
+            pthread_mutex_lock(&job->lock);
+            pthread_cond_signal(&job->cond);
+            pthread_mutex_unlock(&job->lock);
+        }
+    }
+}
+
+static void poolRangeHelper(void *arg) {
+    PoolRangeJob *job = (PoolRangeJob *)arg;
+    poolRangeWork(job);
+    poolRangeRelease(job);
+}
+
+// Jalankan fn(arg, chunk) untuk chunk = 0..num_chunks-1 secara paralel. Thread pemanggil
+// ikut mengerjakan chunk, jadi aman dipanggil dari dalam tugas pool (nested) tanpa
+// deadlock. Chunk selalu sama untuk input yang sama, sehingga pemanggil bisa
+// menggabungkan hasil parsial per chunk secara deterministik.
+void threadPoolParallelFor(ThreadPool *pool, size_t num_chunks, PoolRangeFn fn, void *arg) {
+    if (!pool || pool->num_threads < 2 || num_chunks < 2) {
+        for (size_t i = 0; i < num_chunks; i++) {
+            fn(arg, i);
+        }
+        return;
+    }
+
+    PoolRangeJob *job = (PoolRangeJob *)malloc(sizeof(PoolRangeJob));
+    if (!job) {
+        for (size_t i = 0; i < num_chunks; i++) {
+            fn(arg, i);
+        }
+        return;
+    }
+    job->fn = fn;
+    job->arg = arg;
+    job->total = num_chunks;
+    atomic_init(&job->next, 0);
+    atomic_init(&job->done, 0);
+    pthread_mutex_init(&job->lock, NULL);
+    pthread_cond_init(&job->cond, NULL);
+
+    size_t helpers = (size_t)pool->num_threads < num_chunks - 1 ? (size_t)pool->num_threads : num_chunks - 1;
+    atomic_init(&job->refs, (int)helpers + 1);
+    for (size_t i = 0; i < helpers; i++) {
+        threadPoolSubmit(pool, poolRangeHelper, job);
+    }
+
+    poolRangeWork(job);
+    pthread_mutex_lock(&job->lock);
+    while (atomic_load(&job->done) < job->total) {
+        pthread_cond_wait(&job->cond, &job->lock);
+    }
+    pthread_mutex_unlock(&job->lock);
+    poolRangeRelease(job);
+}
+
+void threadPoolDestroy(ThreadPool *pool) {
+    if (!pool) {
+        return;
+    }
+    threadPoolWait(pool);
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->work_cond);
+    pthread_mutex_unlock(&pool->lock);
+    for (int i = 0; i < pool->num_threads; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    for (int i = 0; i < pool->num_threads; i++) {
+        pthread_mutex_destroy(&pool->queues[i].lock);
+        free(pool->queues[i].tasks);
+    }
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->work_cond);
+    pthread_cond_destroy(&pool->idle_cond);
+    free(pool->queues);
+    free(pool->threads);
+    free(pool);
+}
+
+// Pool bersama untuk loop paralel di dalam algoritma (misalnya per iterasi solver), supaya
+// biaya membuat thread tidak dibayar berulang kali. Dari dalam worker sebuah pool, pool itu
+// sendiri yang dikembalikan (tidak menambah thread). Selain itu dibuat sekali dengan satu
+// worker per core dan hidup sampai program selesai. Bisa NULL jika pembuatan gagal.
+static ThreadPool *pool_shared = NULL;
+static pthread_once_t pool_shared_once = PTHREAD_ONCE_INIT;
+
+static void poolSharedInit(void) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    pool_shared = threadPoolCreate(cores > 0 ? (int)cores : 1);
+}
+
+ThreadPool *threadPoolShared(void) {
+    if (pool_current) {
+        return pool_current;
+    }
+    pthread_once(&pool_shared_once, poolSharedInit);
+    return pool_shared;
+}
+
+// Indeks worker (0..num_threads-1) untuk thread pemanggil, atau -1 jika pemanggil bukan worker pool ini.
+// Dipakai untuk memilih buffer per thread tanpa lock.
+int threadPoolWorkerIndex(const ThreadPool *pool) {
+    return pool && pool_current == pool ? pool_current_index : -1;
+}
@@ -0,0 +1,51 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// Thread pool persisten dengan work stealing. Setiap worker punya deque sendiri:
+// pemilik mengambil tugas dari ekor (LIFO), worker yang menganggur mencuri dari
+// kepala deque worker lain (FIFO), sehingga tugas mahal tidak menumpuk di satu thread.
+
+typedef void (*PoolTaskFn)(void *arg);
+typedef void (*PoolRangeFn)(void *arg, size_t chunk);
+
+typedef struct {
+    PoolTaskFn fn;
+    void *arg;
+} PoolTask;
+
+typedef struct {
+    PoolTask *tasks;
+    size_t head;     // Indeks untuk dicuri
+    size_t tail;     // Indeks untuk pemilik
+    size_t capacity; // Selalu pangkat 2
+    pthread_mutex_t lock;
+} PoolDeque;
+
+typedef struct ThreadPool {
+    int num_threads;
+    pthread_t *threads;
+    PoolDeque *queues;
+    pthread_mutex_t lock;
+    pthread_cond_t work_cond;
+    pthread_cond_t idle_cond;
+    atomic_size_t queued;  // Tugas yang masih di deque
+    atomic_size_t pending; // Tugas yang belum selesai
+    atomic_uint next_queue;
+    int shutdown;
+} ThreadPool;
+
+// Deklarasi fungsi
+ThreadPool *threadPoolCreate(int num_threads);
+void threadPoolSubmit(ThreadPool *pool, PoolTaskFn fn, void *arg);
+void threadPoolWait(ThreadPool *pool);
+void threadPoolParallelFor(ThreadPool *pool, size_t num_chunks, PoolRangeFn fn, void *arg);
+void threadPoolDestroy(ThreadPool *pool);
+ThreadPool *threadPoolShared(void);
+int threadPoolWorkerIndex(const ThreadPool *pool);
+
+#endif
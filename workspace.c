@@ -0,0 +1,79 @@
+#include "workspace.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+struct FitWorkspaceOverflow {
+    FitWorkspaceOverflow *next;
+};
+
+static size_t workspaceAlign(size_t bytes) {
+    return (bytes + FIT_WORKSPACE_ALIGN - 1) & ~(size_t)(FIT_WORKSPACE_ALIGN - 1);
+}
+
+// capacity 0 berarti blok utama dibuat saat reset pertama, sesuai kebutuhan fit pertama
+void fitWorkspaceInit(FitWorkspace *ws, size_t capacity) {
+    memset(ws, 0, sizeof(*ws));
+    if (capacity > 0) {
+        capacity = workspaceAlign(capacity);
+        ws->base = (unsigned char *)aligned_alloc(FIT_WORKSPACE_ALIGN, capacity);
+        ws->capacity = ws->base ? capacity : 0;
+        ws->heap_allocations = ws->base ? 1 : 0;
+        metricsAdd(METRIC_WORKSPACE_ALLOCATIONS, ws->heap_allocations);
+    }
+}
+
+// Ambil bytes dari workspace (sejajar FIT_WORKSPACE_ALIGN). Return NULL jika memori habis.
+void *fitWorkspaceAlloc(FitWorkspace *ws, size_t bytes) {
+    size_t size = workspaceAlign(bytes ? bytes : 1);
+    ws->demand += size;
+    if (ws->capacity - ws->used >= size) {
+        void *block = ws->base + ws->used;
+        ws->used += size;
+        return block;
+    }
+
+    // Header overflow menempati satu slot sejajar supaya data tetap sejajar
+    FitWorkspaceOverflow *overflow =
+        (FitWorkspaceOverflow *)aligned_alloc(FIT_WORKSPACE_ALIGN, FIT_WORKSPACE_ALIGN + size);
+    if (!overflow) {
+        return NULL;
+    }
+    overflow->next = ws->overflow;
+    ws->overflow = overflow;
+    ws->heap_allocations++;
+    metricsAdd(METRIC_WORKSPACE_ALLOCATIONS, 1);
+    return (unsigned char *)overflow + FIT_WORKSPACE_ALIGN;
+}
+
+static void workspaceFreeOverflow(FitWorkspace *ws) {
+    while (ws->overflow) {
+        FitWorkspaceOverflow *next = ws->overflow->next;
+        free(ws->overflow);
+        ws->overflow = next;
+    }
+}
+
+// Lepas semua alokasi sekaligus. Jika ada overflow sejak reset sebelumnya, blok utama
+// diganti dengan blok yang cukup untuk kebutuhan puncak tersebut.
+void fitWorkspaceReset(FitWorkspace *ws) {
+    if (ws->overflow) {
+        workspaceFreeOverflow(ws);
+        if (ws->demand > ws->capacity) {
+            size_t capacity = ws->demand > 2 * ws->capacity ? ws->demand : 2 * ws->capacity;
+            free(ws->base);
+            ws->base = (unsigned char *)aligned_alloc(FIT_WORKSPACE_ALIGN, capacity);
+            ws->capacity = ws->base ? capacity : 0;
+            ws->heap_allocations += ws->base ? 1 : 0;
+            metricsAdd(METRIC_WORKSPACE_ALLOCATIONS, ws->base ? 1 : 0);
+        }
+    }
+    ws->used = 0;
+    ws->demand = 0;
+}
+
+void fitWorkspaceFree(FitWorkspace *ws) {
+    workspaceFreeOverflow(ws);
+    free(ws->base);
+    memset(ws, 0, sizeof(*ws));
+}
@@ -0,0 +1,36 @@
+#ifndef WORKSPACE_H
+#define WORKSPACE_H
+
+#include <stddef.h>
+
+#include "metrics.h"
+
+// Arena milik pemanggil untuk fit berulang. Semua buffer sementara (chunk parsial LM, salinan
+// pasangan kolom yang difilter) dan koefisien hasil diambil dari satu blok memori dengan bump
+// allocator, lalu dilepas sekaligus dengan fitWorkspaceReset. Permintaan yang tidak muat
+// dilayani blok heap sementara; saat reset blok utama diperbesar ke kebutuhan puncak, sehingga
+// setelah fit pertama tidak ada malloc lagi untuk ukuran data yang sama.
+//
+// Satu workspace hanya untuk satu thread. Hasil regresi yang koefisiennya dari workspace tetap
+// valid sampai reset berikutnya dan tidak boleh diberikan ke freeRegressionResult.
+
+#define FIT_WORKSPACE_ALIGN 64 // Satu cache line
+
+typedef struct FitWorkspaceOverflow FitWorkspaceOverflow;
+
+typedef struct {
+    unsigned char *base;
+    size_t capacity;
+    size_t used;
+    size_t demand;                 // Total byte yang diminta sejak reset terakhir
+    FitWorkspaceOverflow *overflow; // Blok heap untuk permintaan yang tidak muat
+    size_t heap_allocations;       // Jumlah malloc oleh workspace (tidak bertambah di steady state)
+} FitWorkspace;
+
+// Deklarasi fungsi
+void fitWorkspaceInit(FitWorkspace *ws, size_t capacity);
+void *fitWorkspaceAlloc(FitWorkspace *ws, size_t bytes);
+void fitWorkspaceReset(FitWorkspace *ws);
+void fitWorkspaceFree(FitWorkspace *ws);
+
+#endif